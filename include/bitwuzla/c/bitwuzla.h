@@ -1418,26 +1418,76 @@ BitwuzlaResult bitwuzla_check_sat_assuming(Bitwuzla *bitwuzla,
  */
 BitwuzlaTerm bitwuzla_get_value(Bitwuzla *bitwuzla, BitwuzlaTerm term);
 
+/**
+ * Get terms representing the model values of a given set of terms.
+ *
+ * Requires that the last `bitwuzla_check_sat()` query returned
+ * `::BITWUZLA_SAT`.
+ *
+ * This is equivalent to calling `bitwuzla_get_value()` for each term, but
+ * values of shared subterms are only computed once.
+ *
+ * @param bitwuzla The Bitwuzla instance.
+ * @param argc The number of terms.
+ * @param args The terms to query model values for.
+ *
+ * @return An array of `argc` terms representing the model values of the
+ *         terms in `args`, in the same order. The array is only valid until
+ *         the next `bitwuzla_get_values` call.
+ *
+ * @see `bitwuzla_check_sat`
+ */
+const BitwuzlaTerm *bitwuzla_get_values(Bitwuzla *bitwuzla,
+                                        uint32_t argc,
+                                        BitwuzlaTerm args[]);
+
 /**
  * Print the current input formula.
  *
  * @param bitwuzla The Bitwuzla instance.
- * @param format The output format for printing the formula. Currently, only
- *               `"smt2"` for the SMT-LIB v2 format is supported.
+ * @param format The output format for printing the formula. Either `"smt2"`
+ *               for the SMT-LIB v2 format, or `"binary"` for the Bitwuzla
+ *               binary format. The binary format includes the assertion
+ *               levels of the assertions, where context levels without
+ *               assertions are omitted, and should be printed to a file
+ *               opened in binary mode.
  * @param file   The file to print the formula to.
  * @param base   The base of the string representation of bit-vector values;
  *               `2` for binary, `10` for decimal, and `16` for hexadecimal.
+ *               Ignored for the binary format.
  *
  * @note Floating-point values are printed in terms of operator `fp`. Their
  *       component bit-vector values can only be printed in binary or decimal
  *       format. If base `16` is configured, the format for floating-point
  *       component bit-vector values defaults to binary format.
+ *
+ * @see
+ *   * `bitwuzla_load_formula`
  */
 void bitwuzla_print_formula(Bitwuzla *bitwuzla,
                             const char *format,
                             FILE *file,
                             uint8_t base);
 
+/**
+ * Load a formula in the Bitwuzla binary format and assert it.
+ *
+ * The assertions are asserted relative to the current context level, i.e.,
+ * an assertion that was at context level `n` when the formula was printed
+ * is asserted after pushing `n` context levels. Context levels without
+ * assertions are not stored in the binary format and thus not restored. The
+ * pushed context levels are not popped after loading.
+ *
+ * @param bitwuzla The Bitwuzla instance.
+ * @param file     The file to load the formula from, should be opened in
+ *                 binary mode.
+ *
+ * @see
+ *   * `bitwuzla_print_formula`
+ *   * `bitwuzla_load_terms`
+ */
+void bitwuzla_load_formula(Bitwuzla *bitwuzla, FILE *file);
+
 /**
  * Print the current unsat core as benchmark.
  *
@@ -2234,6 +2284,59 @@ void bitwuzla_substitute_terms(size_t terms_size,
 
 /** @} */
 
+/* -------------------------------------------------------------------------- */
+/* Term serialization                                                         */
+/* -------------------------------------------------------------------------- */
+
+/** \addtogroup c_term_serialization
+ *  @{
+ */
+
+/**
+ * Dump terms in the Bitwuzla binary format.
+ *
+ * The binary format stores the given terms together with all their subterms,
+ * sorts and values in topological order.
+ *
+ * @param tm         The term manager instance.
+ * @param terms_size The number of terms to dump.
+ * @param terms      The terms to dump.
+ * @param file       The file to dump the terms to, should be opened in binary
+ *                   mode.
+ *
+ * @see
+ *   * `bitwuzla_load_terms`
+ */
+void bitwuzla_dump_terms(BitwuzlaTermManager *tm,
+                         size_t terms_size,
+                         BitwuzlaTerm terms[],
+                         FILE *file);
+
+/**
+ * Load terms in the Bitwuzla binary format.
+ *
+ * Constants, variables and uninterpreted sorts are created fresh, i.e.,
+ * they are distinct from the constants, variables and uninterpreted sorts
+ * that were dumped, even when loaded into the same term manager.
+ *
+ * @param tm   The term manager instance.
+ * @param file The file to load the terms from, should be opened in binary
+ *             mode.
+ * @param size Output parameter to store the number of loaded terms.
+ * @return An array with the loaded terms, in the order they were dumped. If
+ *         the input was created via `bitwuzla_print_formula()`, these are the
+ *         assertions of the formula.
+ *
+ * @see
+ *   * `bitwuzla_dump_terms`
+ *   * `bitwuzla_print_formula`
+ */
+const BitwuzlaTerm *bitwuzla_load_terms(BitwuzlaTermManager *tm,
+                                        FILE *file,
+                                        size_t *size);
+
+/** @} */
+
 #if __cplusplus
 }
 #endif
@@ -28,7 +28,8 @@ typedef struct BitwuzlaParser BitwuzlaParser;
  * @note The parser creates and owns the associated Bitwuzla instance.
  * @param tm The associated term manager instance.
  * @param options The associated options.
- * @param language     The format of the input.
+ * @param language     The format of the input, either `"smt2"`, `"btor2"`,
+ *                     or `"binary"` for the Bitwuzla binary format.
  * @param base         The base of the string representation of bit-vector
  *                     values; `2` for binary, `10` for decimal, and `16` for
  *                     hexadecimal. Always ignored for Boolean and RoundingMode
@@ -1449,6 +1449,40 @@ class TermManager
   void substitute_terms(std::vector<Term> &terms,
                         const std::unordered_map<Term, Term> &map);
 
+  /* ------------------------------------------------------------------------ */
+  /* Term serialization                                                       */
+  /* ------------------------------------------------------------------------ */
+
+  /**
+   * Dump given terms in the Bitwuzla binary format to the given output stream.
+   *
+   * The binary format stores the given terms together with all their subterms,
+   * sorts and values in topological order.
+   *
+   * @param out   The output stream, should be opened in binary mode.
+   * @param terms The terms to dump.
+   *
+   * @see `TermManager::load_terms()`
+   */
+  void dump_terms(std::ostream &out, const std::vector<Term> &terms);
+
+  /**
+   * Load terms in the Bitwuzla binary format from the given input stream.
+   *
+   * Constants, variables and uninterpreted sorts are created fresh, i.e.,
+   * they are distinct from the constants, variables and uninterpreted sorts
+   * that were dumped, even when loaded into the same term manager.
+   *
+   * @param in The input stream, should be opened in binary mode.
+   * @return The loaded terms, in the order they were dumped. If the input
+   *         was created via `Bitwuzla::print_formula()`, these are the
+   *         assertions of the formula.
+   *
+   * @see
+   *   * `TermManager::dump_terms()`
+   *   * `Bitwuzla::print_formula()`
+   */
+  std::vector<Term> load_terms(std::istream &in);
 
  private:
   std::unique_ptr<bzla::NodeManager> d_nm;
@@ -1622,16 +1656,56 @@ class Bitwuzla
    */
   Term get_value(const Term &term);
 
+  /**
+   * Get terms representing the model values of a given set of terms.
+   *
+   * Requires that the last `check_sat()` query returned
+   * `Result::SAT`.
+   *
+   * This is equivalent to calling `get_value()` for each term, but values of
+   * shared subterms are only computed once.
+   *
+   * @param terms The terms to query model values for.
+   * @return Terms representing the model values of `terms`, in the same
+   *         order.
+   * @see `check_sat()`
+   */
+  std::vector<Term> get_values(const std::vector<Term> &terms);
+
   /**
    * Print the current input formula to the given output stream.
    *
    * @param out    The output stream.
-   * @param format The output format for printing the formula. Currently, only
-   *               `"smt2"` for the SMT-LIB v2 format is supported.
+   * @param format The output format for printing the formula. Either
+   *               `"smt2"` for the SMT-LIB v2 format, or `"binary"` for the
+   *               Bitwuzla binary format. The binary format includes the
+   *               assertion levels of the assertions, where context levels
+   *               without assertions are omitted, and should be printed to a
+   *               stream opened in binary mode.
+   *
+   * @see `Bitwuzla::load_formula()`
    */
   void print_formula(std::ostream &out,
                      const std::string &format = "smt2") const;
 
+  /**
+   * Load a formula in the Bitwuzla binary format from the given input stream
+   * and assert it.
+   *
+   * The assertions are asserted relative to the current context level, i.e.,
+   * an assertion that was at context level `n` when the formula was printed
+   * is asserted after pushing `n` context levels. Context levels without
+   * assertions are not stored in the binary format and thus not restored. The
+   * pushed context levels are not popped after loading.
+   *
+   * @param in The input stream, should be opened in binary mode.
+   *
+   * @see
+   *   * `Bitwuzla::print_formula()`
+   *   * `TermManager::load_terms()`
+   */
+  void load_formula(std::istream &in);
+
   /**
    * Print the current unsat core as benchmark to the given output stream.
    *
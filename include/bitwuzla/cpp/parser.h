@@ -50,7 +50,8 @@ class Parser
    * @param tm The associated term manager instance.
    * @param options     The configuration options for the Bitwuzla instance
    *                    (created by the parser).
-   * @param language    The format of the input.
+   * @param language    The format of the input, either `"smt2"`, `"btor2"`,
+   *                    or `"binary"` for the Bitwuzla binary format.
    * @param out         The output stream.
    * @note It is not safe to reuse a parser instance after a parse error.
    *       Subsequent parse queries after a parse error will return with
@@ -72,7 +73,8 @@ class Parser
    * @throws Exception on error.
    * @note Parameter `parse_only` is redundant for BTOR2 input, its the only
    *       available mode for BTOR2 (due to the language not supporting
-   *       "commands" as in SMT2).
+   *       "commands" as in SMT2). Binary input is checked for
+   *       satisfiability once after loading if `parse_only` is false.
    */
   void parse(const std::string &input,
              bool parse_only = false,
@@ -99,6 +101,7 @@ class Parser
    * @param input The input string.
    * @return The parsed term.
    * @throws Exception on parse error.
+   * @note Not supported for binary input.
    */
   Term parse_term(const std::string &input);
   /**
@@ -106,13 +109,14 @@ class Parser
    * @param input The input string.
    * @return The parsed sort.
    * @throws Exception on parse error.
+   * @note Not supported for binary input.
    */
   Sort parse_sort(const std::string &input);
 
   /**
    * Get the current set of (user-)declared sort symbols.
    * @note Corresponds to the sorts declared via SMT-LIB command `declare-sort`.
-   *       Will always return an empty set for BTOR2 input.
+   *       Will always return an empty set for BTOR2 and binary input.
    * @return The declared sorts.
    */
   std::vector<Sort> get_declared_sorts() const;
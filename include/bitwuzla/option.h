@@ -570,6 +570,212 @@ enum ENUM(Option)
    */
   EVALUE(DBG_CHECK_UNSAT_CORE),
 
+  /* Options below were added later and are appended to keep the values of
+   * the options above stable. */
+
+  /* ---------------- Bitwuzla-specific Options (cont.) --------------------- */
+
+  /*! **Parallel portfolio solving.**
+   *
+   * Run the given number of differently configured solver instances on
+   * the preprocessed input in parallel, each in its own thread. The
+   * instances vary in the bit-vector solver engine, the SAT solver and the
+   * seed. The result of the first instance that determines satisfiability
+   * is returned, all other instances are terminated. The instances are kept
+   * across satisfiability checks and only receive the assertions added since
+   * the previous check.
+   *
+   * Values:
+   *  * An unsigned integer value <= 64, values < 2 disable portfolio mode.
+   *    [**default**: 0]
+   *
+   * @note If a terminator is configured, it is only called from the thread
+   *       that checks satisfiability.
+   */
+  EVALUE(PORTFOLIO),
+  /*! **Maximum size of the rewrite cache.**
+   *
+   * Bound the number of cached rewrites. If the cache exceeds the bound,
+   * entries that were not used since the previous top-level rewrite are
+   * evicted before the next top-level rewrite.
+   *
+   * Values:
+   *  * An unsigned integer value, 0 for no limit. [**default**: 0]
+   *
+   * @warning This is an expert option to configure rewriting.
+   */
+  EVALUE(REWRITE_CACHE_SIZE),
+  /*! **Profile rewrite rules.**
+   *
+   * Record the number of attempts, the number of successful applications,
+   * the number of cycles spent and the number of nodes created for each
+   * rewrite rule. The profile is reported in the statistics as
+   * `rewriter::profile::<attempts|successes|cycles|nodes>::<rule>`.
+   * Cycles are measured with the time-stamp counter on x86, and in
+   * nanoseconds otherwise. Cycles and created nodes include the rewriting of
+   * nodes created by a rule.
+   *
+   * Values:
+   *  * **true**: enable
+   *  * **false**: disable [**default**]
+   *
+   * @warning This is an expert option to configure rewriting.
+   */
+  EVALUE(REWRITE_PROFILE),
+
+  /* ---------------- BV: Bitblast Engine Options --------------------------- */
+
+  /*! **Bit-blasting solver engine: Cube-and-conquer threads.**
+   *
+   * Split the bit-blasted formula into cubes over a set of splitting
+   * variables and solve the cubes in parallel with the given number of
+   * threads, each with its own SAT solver instance (CaDiCaL).
+   *
+   * Values:
+   *  * An unsigned integer value <= 256, values < 2 disable cube-and-conquer.
+   *    [**default**: 0]
+   */
+  EVALUE(BV_CUBE_THREADS),
+  /*! **Bit-blasting solver engine: Cube-and-conquer depth.**
+   *
+   * The number of splitting variables used for cube-and-conquer, which
+   * yields 2^n cubes.
+   *
+   * Values:
+   *  * An unsigned integer value in [1, 16]. [**default**: 5]
+   *
+   * @warning This is an expert option to configure cube-and-conquer.
+   */
+  EVALUE(BV_CUBE_DEPTH),
+  /*! **Bit-blasting solver engine: Multiplier encoding.**
+   *
+   * The circuit used for bit-blasting bit-vector multiplications.
+   *
+   * Values:
+   *  * **array**: Shift-and-add array multiplier. [**default**]
+   *  * **booth**: Radix-4 Booth recoding, partial products are summed up
+   *               with a Wallace tree.
+   *  * **wallace**: Partial products are summed up with a Wallace tree.
+   *  * **karatsuba**: Karatsuba-style splitting of operands with at least
+   *                   32 bits, Wallace tree multiplier for smaller operands.
+   *
+   * @warning This is an expert option to configure bit-blasting.
+   */
+  EVALUE(BV_MUL_ENCODING),
+  /*! **Bit-blasting solver engine: Divider encoding.**
+   *
+   * The circuit used for bit-blasting unsigned bit-vector division and
+   * remainder. Division and remainder over the same operands share a single
+   * divider circuit.
+   *
+   * Values:
+   *  * **restoring**: Restoring shift-subtract divider. [**default**]
+   *  * **non-restoring**: Non-restoring divider, adds or subtracts the
+   *                       divisor in each row without restoring the
+   *                       remainder.
+   *  * **multiplier**: Fresh quotient and remainder constrained by
+   *                    `a = q * b + r` and `r < b` via the configured
+   *                    multiplier circuit.
+   *
+   * @warning This is an expert option to configure bit-blasting.
+   */
+  EVALUE(BV_DIV_ENCODING),
+  /*! **Bit-blasting solver engine: SAT sweeping.**
+   *
+   * Merge functionally equivalent AIG nodes of the bit-blasted assertions
+   * before encoding them to CNF. Candidate equivalences are determined via
+   * random simulation and proved with bounded SAT calls.
+   *
+   * Values:
+   *  * **true**: enable
+   *  * **false**: disable [**default**]
+   *
+   * @warning This is an expert option to configure bit-blasting.
+   */
+  EVALUE(BV_SWEEP),
+  /*! **Bit-blasting solver engine: Simulation rounds.**
+   *
+   * Simulate the bit-blasted formula on the given number of rounds of 512
+   * random input patterns before calling the SAT solver. If a pattern
+   * satisfies the formula, the SAT solver is not called.
+   *
+   * Values:
+   *  * An unsigned integer value, 0 disables simulation. [**default**: 0]
+   *
+   * @warning This is an expert option to configure bit-blasting.
+   */
+  EVALUE(BV_SIM_ROUNDS),
+  /*! **Bit-blasting solver engine: Theory checks during SAT search.**
+   *
+   * Check the array, function and abstraction theories on complete
+   * assignments found by the SAT solver during search, and add the resulting
+   * lemmas as clauses without restarting the search. Requires a SAT solver
+   * with support for external propagators (CaDiCaL), and is not used in
+   * combination with cube-and-conquer.
+   *
+   * Lemmas may refer to the SAT variables of any bit-blasted term, which
+   * must not be eliminated by the SAT solver. All variables are thus frozen,
+   * which disables variable elimination of the SAT solver while enabled.
+   *
+   * Values:
+   *  * **true**: enable
+   *  * **false**: disable [**default**]
+   *
+   * @warning This is an expert option to configure bit-blasting.
+   */
+  EVALUE(BV_SAT_PROPAGATOR),
+
+  /* ---------------- BV: Prop Engine Options (Expert, cont.) --------------- */
+
+  /*! **Propagation-based local search solver engine:
+   *    Number of parallel walkers.**
+   *
+   * Run the given number of independent local search walkers in parallel,
+   * each in its own thread and with a different seed. Every other walker
+   * uses the opposite path selection mode. Terminates as soon as one of the
+   * walkers satisfies all constraints.
+   *
+   * Values:
+   *  * An unsigned integer value in [1, 256]. [**default**: 1]
+   *
+   *  @warning This is an expert option to configure the prop solver engine.
+   */
+  EVALUE(PROP_WALKERS),
+
+  /* ---------------- Quantifier Solver Options (Expert) -------------------- */
+
+  /*! **Quantifier solver: Persistent MBQI subsolver.**
+   *
+   * Keep one model-based quantifier instantiation (MBQI) subsolver across
+   * checks. Counterexample bodies are asserted once, guarded by a literal
+   * per quantifier, and the current model values are assumed per check.
+   * Quantifiers with nested quantifiers or uninterpreted functions in their
+   * body are checked with a new subsolver per check.
+   *
+   * Values:
+   *  * **true**: enable [**default**]
+   *  * **false**: disable
+   *
+   * @warning This is an expert option to configure the quantifier solver.
+   */
+  EVALUE(QUANT_MBQI_PERSISTENT),
+  /*! **Quantifier solver: MBQI threads.**
+   *
+   * Check the quantifiers for counterexamples in parallel with the given
+   * number of threads, each with its own persistent MBQI subsolver. The
+   * subsolvers share the term manager, which is switched to concurrent
+   * mode for the duration of the parallel checks. The instantiation lemmas of all threads are collected and added
+   * in one batch. Only applies to quantifiers handled by the persistent
+   * MBQI subsolver (see QUANT_MBQI_PERSISTENT).
+   *
+   * Values:
+   *  * An unsigned integer value <= 256, values < 2 check sequentially.
+   *    [**default**: 0]
+   *
+   * @warning This is an expert option to configure the quantifier solver.
+   */
+  EVALUE(QUANT_MBQI_THREADS),
+
 #ifndef DOXYGEN_SKIP
   EVALUE(NUM_OPTS),
 #endif
@@ -12,8 +12,11 @@ extern "C" {
 #include <bitwuzla/c/bitwuzla.h>
 }
 
+#include <array>
 #include <cassert>
 #include <cstring>
+#include <istream>
+#include <streambuf>
 #include <unordered_map>
 
 #include "api/c/bitwuzla_structs.h"
@@ -53,6 +56,31 @@ import_option(BitwuzlaOption option)
   return static_cast<bitwuzla::Option>(option);
 }
 
+/** Input stream buffer that reads from a C file. */
+class FileInBuffer : public std::streambuf
+{
+ public:
+  FileInBuffer(FILE *file) : d_file(file) {}
+
+ protected:
+  int_type underflow() override
+  {
+    size_t size = fread(d_buffer.data(), 1, d_buffer.size(), d_file);
+    if (size == 0)
+    {
+      return traits_type::eof();
+    }
+    setg(d_buffer.data(), d_buffer.data(), d_buffer.data() + size);
+    return traits_type::to_int_type(d_buffer[0]);
+  }
+
+ private:
+  /** The input file. */
+  FILE *d_file;
+  /** The input buffer. */
+  std::array<char, 1 << 16> d_buffer;
+};
+
 }  // namespace
 
 /* -------------------------------------------------------------------------- */
@@ -550,6 +578,30 @@ bitwuzla_get_value(Bitwuzla *bitwuzla, BitwuzlaTerm term)
   return res;
 }
 
+const BitwuzlaTerm *
+bitwuzla_get_values(Bitwuzla *bitwuzla, uint32_t argc, BitwuzlaTerm args[])
+{
+  static thread_local std::vector<BitwuzlaTerm> res;
+  BITWUZLA_TRY_CATCH_BEGIN;
+  BITWUZLA_CHECK_NOT_NULL(bitwuzla);
+  BITWUZLA_CHECK_NOT_NULL(args);
+  res.clear();
+  std::vector<bitwuzla::Term> terms;
+  for (uint32_t i = 0; i < argc; ++i)
+  {
+    BITWUZLA_CHECK_TERM_AT_IDX(args, i);
+    terms.push_back(BitwuzlaTermManager::import_term(args[i]));
+  }
+  auto values = bitwuzla->d_bitwuzla->get_values(terms);
+  auto tm     = bitwuzla->d_tm;
+  for (auto &value : values)
+  {
+    res.push_back(tm->export_term(value));
+  }
+  BITWUZLA_TRY_CATCH_END;
+  return res.data();
+}
+
 void
 bitwuzla_print_formula(Bitwuzla *bitwuzla,
                        const char *format,
@@ -563,7 +615,21 @@ bitwuzla_print_formula(Bitwuzla *bitwuzla,
   std::stringstream ss;
   ss << bitwuzla::set_bv_format(base);
   bitwuzla->d_bitwuzla->print_formula(ss, format);
-  fprintf(file, "%s", ss.str().c_str());
+  // Binary output may contain null bytes.
+  std::string str = ss.str();
+  fwrite(str.data(), 1, str.size(), file);
+  BITWUZLA_TRY_CATCH_END;
+}
+
+void
+bitwuzla_load_formula(Bitwuzla *bitwuzla, FILE *file)
+{
+  BITWUZLA_TRY_CATCH_BEGIN;
+  BITWUZLA_CHECK_NOT_NULL(bitwuzla);
+  BITWUZLA_CHECK_NOT_NULL(file);
+  FileInBuffer buffer(file);
+  std::istream in(&buffer);
+  bitwuzla->d_bitwuzla->load_formula(in);
   BITWUZLA_TRY_CATCH_END;
 }
 
@@ -1341,6 +1407,57 @@ bitwuzla_substitute_terms(size_t terms_size,
   BITWUZLA_TRY_CATCH_END;
 }
 
+/* -------------------------------------------------------------------------- */
+/* Term serialization                                                         */
+/* -------------------------------------------------------------------------- */
+
+void
+bitwuzla_dump_terms(BitwuzlaTermManager *tm,
+                    size_t terms_size,
+                    BitwuzlaTerm terms[],
+                    FILE *file)
+{
+  BITWUZLA_TRY_CATCH_BEGIN;
+  BITWUZLA_CHECK_NOT_NULL(tm);
+  BITWUZLA_CHECK_NOT_NULL(file);
+  if (terms_size)
+  {
+    BITWUZLA_CHECK_NOT_NULL(terms);
+  }
+  std::vector<bitwuzla::Term> ts;
+  for (size_t i = 0; i < terms_size; ++i)
+  {
+    BITWUZLA_CHECK_TERM_AT_IDX(terms, i);
+    ts.push_back(BitwuzlaTermManager::import_term(terms[i]));
+  }
+  std::stringstream ss;
+  tm->d_tm.dump_terms(ss, ts);
+  std::string str = ss.str();
+  fwrite(str.data(), 1, str.size(), file);
+  BITWUZLA_TRY_CATCH_END;
+}
+
+const BitwuzlaTerm *
+bitwuzla_load_terms(BitwuzlaTermManager *tm, FILE *file, size_t *size)
+{
+  static thread_local std::vector<BitwuzlaTerm> res;
+  res.clear();
+  BITWUZLA_TRY_CATCH_BEGIN;
+  BITWUZLA_CHECK_NOT_NULL(tm);
+  BITWUZLA_CHECK_NOT_NULL(file);
+  BITWUZLA_CHECK_NOT_NULL(size);
+  *size = 0;
+  FileInBuffer buffer(file);
+  std::istream in(&buffer);
+  for (const auto &term : tm->d_tm.load_terms(in))
+  {
+    res.push_back(tm->export_term(term));
+  }
+  *size = res.size();
+  BITWUZLA_TRY_CATCH_END;
+  return res.empty() ? nullptr : res.data();
+}
+
 BitwuzlaTerm
 bitwuzla_term_copy(BitwuzlaTerm term)
 {
@@ -21,6 +21,8 @@
 #include "node/node_utils.h"
 #include "node/unordered_node_ref_set.h"
 #include "option/option.h"
+#include "parser/binary/reader.h"
+#include "printer/binary_printer.h"
 #include "printer/printer.h"
 #include "solver/fp/floating_point.h"
 #include "solver/fp/rounding_mode.h"
@@ -71,6 +73,17 @@ static const std::unordered_map<Option, bzla::option::Option>
         {Option::MEMORY_LIMIT, bzla::option::Option::MEMORY_LIMIT},
         {Option::RELEVANT_TERMS, bzla::option::Option::RELEVANT_TERMS},
         {Option::REWRITE_LEVEL, bzla::option::Option::REWRITE_LEVEL},
+        {Option::PORTFOLIO, bzla::option::Option::PORTFOLIO},
+        {Option::REWRITE_CACHE_SIZE,
+         bzla::option::Option::REWRITE_CACHE_SIZE},
+        {Option::REWRITE_PROFILE, bzla::option::Option::REWRITE_PROFILE},
+        {Option::BV_CUBE_THREADS, bzla::option::Option::BV_CUBE_THREADS},
+        {Option::BV_CUBE_DEPTH, bzla::option::Option::BV_CUBE_DEPTH},
+        {Option::BV_MUL_ENCODING, bzla::option::Option::BV_MUL_ENCODING},
+        {Option::BV_DIV_ENCODING, bzla::option::Option::BV_DIV_ENCODING},
+        {Option::BV_SWEEP, bzla::option::Option::BV_SWEEP},
+        {Option::BV_SIM_ROUNDS, bzla::option::Option::BV_SIM_ROUNDS},
+        {Option::BV_SAT_PROPAGATOR, bzla::option::Option::BV_SAT_PROPAGATOR},
         {Option::PROP_CONST_BITS, bzla::option::Option::PROP_CONST_BITS},
         {Option::PROP_INFER_INEQ_BOUNDS,
          bzla::option::Option::PROP_INEQ_BOUNDS},
@@ -85,6 +98,7 @@ static const std::unordered_map<Option, bzla::option::Option>
          bzla::option::Option::PROP_PROB_PICK_INV_VALUE},
         {Option::PROP_SEXT, bzla::option::Option::PROP_SEXT},
         {Option::PROP_NORMALIZE, bzla::option::Option::PROP_NORMALIZE},
+        {Option::PROP_WALKERS, bzla::option::Option::PROP_WALKERS},
         {Option::ABSTRACTION, bzla::option::Option::ABSTRACTION},
         {Option::ABSTRACTION_BV_SIZE,
          bzla::option::Option::ABSTRACTION_BV_SIZE},
@@ -109,6 +123,9 @@ static const std::unordered_map<Option, bzla::option::Option>
          bzla::option::Option::ABSTRACTION_BV_UREM},
         {Option::ABSTRACTION_EQUAL, bzla::option::Option::ABSTRACTION_EQUAL},
         {Option::ABSTRACTION_ITE, bzla::option::Option::ABSTRACTION_ITE},
+        {Option::QUANT_MBQI_PERSISTENT,
+         bzla::option::Option::QUANT_MBQI_PERSISTENT},
+        {Option::QUANT_MBQI_THREADS, bzla::option::Option::QUANT_MBQI_THREADS},
         {Option::NUM_OPTS, bzla::option::Option::NUM_OPTIONS},
 
         {Option::PREPROCESS, bzla::option::Option::PREPROCESS},
@@ -1547,11 +1564,33 @@ Bitwuzla::get_value(const Term &term)
   return d_ctx->get_value(*term.d_node);
 }
 
+std::vector<Term>
+Bitwuzla::get_values(const std::vector<Term> &terms)
+{
+  BITWUZLA_CHECK_NOT_NULL(d_ctx);
+  BITWUZLA_CHECK_OPT_PRODUCE_MODELS(d_ctx->options());
+  BITWUZLA_CHECK_LAST_CALL_SAT("get values");
+  for (size_t i = 0, size = terms.size(); i < size; ++i)
+  {
+    BITWUZLA_CHECK_TERM_NOT_NULL_AT_IDX(terms, i);
+    BITWUZLA_CHECK_TERM_TERM_MGR_BITWUZLA(
+        terms[i], "term at position " + std::to_string(i));
+  }
+  return Term::node_vector_to_terms(
+      d_ctx->get_values(Term::term_vector_to_nodes(terms)));
+}
+
 void
 Bitwuzla::print_formula(std::ostream &out, const std::string &format) const
 {
   BITWUZLA_CHECK_STR_NOT_EMPTY(format);
-  BITWUZLA_CHECK(format == "smt2") << "invalid format, expected 'smt2'";
+  BITWUZLA_CHECK(format == "smt2" || format == "binary")
+      << "invalid format, expected 'smt2' or 'binary'";
+  if (format == "binary")
+  {
+    bzla::BinaryPrinter::print_formula(out, d_ctx->assertions());
+    return;
+  }
   try
   {
     bzla::Printer::print_formula(out, d_ctx->assertions());
@@ -1562,6 +1601,36 @@ Bitwuzla::print_formula(std::ostream &out, const std::string &format) const
   }
 }
 
+void
+Bitwuzla::load_formula(std::istream &in)
+{
+  BITWUZLA_CHECK_NOT_NULL(d_ctx);
+  BITWUZLA_CHECK(in.operator bool()) << "invalid input stream";
+  bzla::parser::binary::Reader reader(d_ctx->env().nm(), in);
+  if (!reader.read())
+  {
+    throw Exception("failed to load formula: " + reader.error_msg());
+  }
+  const std::vector<bzla::Node> &assertions = reader.roots();
+  const std::vector<uint64_t> &levels       = reader.levels();
+  for (size_t i = 0, n = assertions.size(); i < n; ++i)
+  {
+    BITWUZLA_CHECK(assertions[i].type().is_bool())
+        << "failed to load formula: assertion at position " << i
+        << " is not a formula";
+  }
+  solver_state_change();
+  uint64_t level = 0;
+  for (size_t i = 0, n = assertions.size(); i < n; ++i)
+  {
+    for (; level < levels[i]; ++level)
+    {
+      d_ctx->push();
+    }
+    d_ctx->assert_formula(assertions[i]);
+  }
+}
+
 void
 Bitwuzla::print_unsat_core(std::ostream &out, const std::string &format) const
 {
@@ -2440,6 +2509,30 @@ TermManager::substitute_terms(std::vector<Term> &terms,
   }
 }
 
+void
+TermManager::dump_terms(std::ostream &out, const std::vector<Term> &terms)
+{
+  for (size_t i = 0, n = terms.size(); i < n; ++i)
+  {
+    BITWUZLA_CHECK_TERM_NOT_NULL_AT_IDX(terms, i);
+    BITWUZLA_CHECK_TERM_TERM_MGR(terms[i],
+                                 "term at position " + std::to_string(i));
+  }
+  bzla::BinaryPrinter::print(out, Term::term_vector_to_nodes(terms));
+}
+
+std::vector<Term>
+TermManager::load_terms(std::istream &in)
+{
+  BITWUZLA_CHECK(in.operator bool()) << "invalid input stream";
+  bzla::parser::binary::Reader reader(*d_nm, in);
+  if (!reader.read())
+  {
+    throw Exception("failed to load terms: " + reader.error_msg());
+  }
+  return Term::node_vector_to_terms(reader.roots());
+}
+
 /* Term private ------------------------------------------------------------- */
 
 Term::Term(const bzla::Node &node) : d_node(new bzla::Node(node)) {}
@@ -8,6 +8,7 @@
  * information at https://github.com/bitwuzla/bitwuzla/blob/main/COPYING
  */
 
+#include "parser/binary/parser.h"
 #include "parser/btor2/parser.h"
 
 #include <bitwuzla/cpp/parser.h>
@@ -33,17 +34,22 @@ Parser::Parser(TermManager &tm,
                const std::string &language,
                std::ostream *out)
 {
-  BITWUZLA_CHECK(language == "smt2" || language == "btor2")
-      << "invalid input language, expected 'smt2' or 'btor2'";
+  BITWUZLA_CHECK(language == "smt2" || language == "btor2"
+                 || language == "binary")
+      << "invalid input language, expected 'smt2', 'btor2' or 'binary'";
   BITWUZLA_CHECK_NOT_NULL(out);
   if (language == "smt2")
   {
     d_parser.reset(new bzla::parser::smt2::Parser(tm, options, out));
   }
-  else
+  else if (language == "btor2")
   {
     d_parser.reset(new bzla::parser::btor2::Parser(tm, options, out));
   }
+  else
+  {
+    d_parser.reset(new bzla::parser::binary::Parser(tm, options, out));
+  }
   BITWUZLA_CHECK(d_parser->error_msg().empty()) << d_parser->error_msg();
 }
 
@@ -1432,6 +1432,21 @@ cdef class Bitwuzla:
         """
         return _term(self.tm, self.c_bitwuzla.get().get_value(_cterm(term)))
 
+    def get_values(self, terms: list[Term]) -> list[Term]:
+        """Get model values of a list of terms.
+
+           Requires that the last :func:`~bitwuzla.Bitwuzla.check_sat` call
+           returned `~bitwuzla.Result.SAT`.
+
+           Equivalent to calling :func:`~bitwuzla.Bitwuzla.get_value` for
+           each term, but values of shared subterms are only computed once.
+
+           :param terms: The terms to query model values for.
+           :return: List of terms representing the model values of `terms`.
+        """
+        return _terms(self.tm,
+                      self.c_bitwuzla.get().get_values(_term_vec(terms)))
+
     def print_formula(self, fmt: str = 'smt2', uint8_t base = 2) -> str:
         """Get the current input formula as a string.
 
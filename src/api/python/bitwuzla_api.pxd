@@ -284,6 +284,7 @@ cdef extern from "bitwuzla/cpp/bitwuzla.h" namespace "bitwuzla":
         void simplify() except +raise_error
         Result check_sat(const vector[Term] &assumptions) except +raise_error
         Term get_value(const Term &term) except +raise_error
+        vector[Term] get_values(const vector[Term] &terms) except +raise_error
         void print_formula(ostream& outfile, string& fmt) except +raise_error
         void print_unsat_core(ostream& outfile, string& fmt) except +raise_error
         map[string, string] statistics() except +raise_error
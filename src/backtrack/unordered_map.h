@@ -34,6 +34,8 @@ class unordered_map : public Backtrackable
 
   auto find(const K& key) const { return d_data.find(key); }
 
+  auto find(const K& key) { return d_data.find(key); }
+
   template <class... Args>
   auto emplace(Args&&... args)
   {
@@ -49,6 +51,8 @@ class unordered_map : public Backtrackable
 
   auto end() const { return d_data.end(); }
 
+  auto end() { return d_data.end(); }
+
   /* --- Backtrackable interface -------------------------------------------- */
 
   void push() override { d_control.push_back(d_keys.size()); }
@@ -13,6 +13,7 @@
 #include <unordered_set>
 
 #include "node/node_manager.h"
+#include "rewrite/evaluator.h"
 
 namespace bzla::check {
 
@@ -35,19 +36,38 @@ CheckModel::check()
   Log(1) << "*** check model";
   Log(1);
 
+  NodeManager& nm = d_ctx.env().nm();
+  collect_consts();
+  std::unordered_map<Node, Node> model;
+  for (const Node& input : d_consts)
+  {
+    model.emplace(input, d_ctx.get_value(input));
+  }
+
+  // Quickly reject models that falsify Boolean and bit-vector assertions.
+  // The evaluator is also used for computing model values, hence the model is
+  // always checked independently below.
+  for (const Node& assertion : d_ctx.original_assertions())
+  {
+    Node value = Evaluator::evaluate(nm, assertion, model);
+    if (!value.is_null() && !value.value<bool>())
+    {
+      Log(1) << "assertion evaluates to false: " << assertion;
+      return false;
+    }
+  }
+
   option::Options opts;
   opts.dbg_check_model.set(false);
-  NodeManager& nm = d_ctx.env().nm();
   SolvingContext check_ctx(nm, opts, "chkmodel");
   for (const Node& assertion : d_ctx.original_assertions())
   {
     check_ctx.assert_formula(assertion);
   }
 
-  collect_consts();
   for (const Node& input : d_consts)
   {
-    Node value = d_ctx.get_value(input);
+    const Node& value = model.at(input);
     Log(2) << "check: " << input << " = " << value;
     // Special handling until equality over constant arrays supported
     if (input.type().is_array())
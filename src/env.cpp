@@ -20,7 +20,10 @@ Env::Env(NodeManager& nm,
          const std::string& name)
     : d_nm(nm),
       d_options(options),
-      d_rewriter(*this, options.rewrite_level()),
+      d_rewriter(*this,
+                 options.rewrite_level(),
+                 options.rewrite_cache_size(),
+                 options.rewrite_profile()),
       d_logger(options.log_level(),
                options.verbosity(),
                name.empty() ? "" : "(" + name + ")")
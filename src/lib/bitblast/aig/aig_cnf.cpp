@@ -11,23 +11,23 @@
 #include "bitblast/aig/aig_cnf.h"
 
 #include <cstdlib>
-#include <functional>
 #include <unordered_set>
 #include <vector>
 
 namespace bzla::bitblast {
 
 void
-AigCnfEncoder::encode(const AigNode& node, bool top_level)
+AigCnfEncoder::encode(const AigNode& node, bool top_level, bool global)
 {
+  size_t scope = global ? 0 : d_activation.size();
   if (top_level)
   {
     std::unordered_set<int64_t> cache;
-    std::vector<std::reference_wrapper<const AigNode>> visit{node};
-    std::vector<std::reference_wrapper<const AigNode>> children;
+    std::vector<AigNode> visit{node};
+    std::vector<AigNode> children;
     do
     {
-      const AigNode& cur = visit.back();
+      AigNode cur = std::move(visit.back());
       visit.pop_back();
 
       auto [it, inserted] = cache.insert(cur.get_id());
@@ -44,20 +44,19 @@ AigCnfEncoder::encode(const AigNode& node, bool top_level)
       else
       {
         children.push_back(cur);
-        _encode(cur);
+        _encode(cur, scope);
       }
     } while (!visit.empty());
     assert(!children.empty());
 
     for (const AigNode& child : children)
     {
-      d_sat_solver.add_clause({child.get_id()});
-      ++d_statistics.num_clauses;
+      add_clause({child.get_id()}, scope);
     }
   }
   else
   {
-    _encode(node);
+    _encode(node, scope);
   }
 }
 
@@ -88,6 +87,55 @@ AigCnfEncoder::statistics() const
   return d_statistics;
 }
 
+void
+AigCnfEncoder::push(int64_t activation)
+{
+  assert(activation > 0);
+  d_activation.push_back(activation);
+  d_scope_aigs.emplace_back();
+  d_scope_clauses.push_back(0);
+}
+
+void
+AigCnfEncoder::pop()
+{
+  assert(!d_activation.empty());
+  size_t scope = d_activation.size();
+
+  // Permanently disable all clauses of this scope.
+  d_sat_solver.add_clause({-d_activation.back()});
+  ++d_statistics.num_clauses;
+  ++d_statistics.num_literals;
+  d_statistics.num_retired += d_scope_clauses.back();
+
+  // Reset encoded flags of all AIG phases that were not re-encoded in a lower
+  // scope in the meantime.
+  for (int64_t key : d_scope_aigs.back())
+  {
+    auto it = d_aig_scope.find(key);
+    if (it != d_aig_scope.end() && it->second == scope)
+    {
+      d_aig_scope.erase(it);
+      d_aig_encoded[static_cast<size_t>(std::abs(key) - 1)] &=
+          static_cast<uint8_t>(key > 0 ? ~POS : ~NEG);
+    }
+  }
+  d_activation.pop_back();
+  d_scope_aigs.pop_back();
+  d_scope_clauses.pop_back();
+
+  // AIG ids are assigned in increasing order, AIGs created in the popped
+  // scope are thus at the end of the encoded flags.
+  while (!d_aig_encoded.empty() && d_aig_encoded.back() == 0)
+  {
+    d_aig_encoded.pop_back();
+  }
+  if (d_aig_encoded.capacity() > 2 * d_aig_encoded.size())
+  {
+    d_aig_encoded.shrink_to_fit();
+  }
+}
+
 namespace {
 
 /**
@@ -102,12 +150,12 @@ namespace {
  * @return True if given AIG is a if-then-else.
  */
 bool
-is_ite(const AigNode& aig, std::vector<const AigNode*>& children)
+is_ite(const AigNode& aig, std::vector<AigNode>& children)
 {
   assert(aig.is_and());
   assert(children.empty());
 
-  const auto& l = aig[0];
+  const auto l = aig[0];
   if (!l.is_negated() || !l.is_and())
   {
     return false;
@@ -119,7 +167,7 @@ is_ite(const AigNode& aig, std::vector<const AigNode*>& children)
     return false;
   }
 
-  const auto& r = aig[1];
+  const auto r = aig[1];
   if (!r.is_negated() || !r.is_and())
   {
     return false;
@@ -134,142 +182,359 @@ is_ite(const AigNode& aig, std::vector<const AigNode*>& children)
   // ite(c,a,b) == (c -> a) /\ (~c -> b)
   // Check all commutative cases of: ~(c /\ ~a) /\ ~(~c /\ ~b)
   //                                   ll   lr       rl    rr
-  const auto& ll = l[0];
-  const auto& lr = l[1];
-  const auto& rl = r[0];
-  const auto& rr = r[1];
+  const auto ll = l[0];
+  const auto lr = l[1];
+  const auto rl = r[0];
+  const auto rr = r[1];
 
   // ~(~b /\ ~c) /\  ~(c /\ ~a)
   if (-lr.get_id() == rl.get_id())
   {
-    children.push_back(&rl);  // c
-    children.push_back(&rr);  // ~a
-    children.push_back(&ll);  // ~b
+    children.push_back(rl);  // c
+    children.push_back(rr);  // ~a
+    children.push_back(ll);  // ~b
     return true;
   }
   // ~(~c /\ ~b) /\ ~(c /\ ~a)
   if (-ll.get_id() == rl.get_id())
   {
-    children.push_back(&rl);  // c
-    children.push_back(&rr);  // ~a
-    children.push_back(&lr);  // ~b
+    children.push_back(rl);  // c
+    children.push_back(rr);  // ~a
+    children.push_back(lr);  // ~b
     return true;
   }
   // ~(~b /\ ~c) /\  ~(~a /\ c)
   if (-lr.get_id() == rr.get_id())
   {
-    children.push_back(&rr);  // c
-    children.push_back(&rl);  // ~a
-    children.push_back(&ll);  // ~b
+    children.push_back(rr);  // c
+    children.push_back(rl);  // ~a
+    children.push_back(ll);  // ~b
     return true;
   }
   // ~(~c /\ ~b) /\  ~(~a /\ c)
   if (-ll.get_id() == rr.get_id())
   {
-    children.push_back(&rr);  // c
-    children.push_back(&rl);  // ~a
-    children.push_back(&lr);  // ~b
+    children.push_back(rr);  // c
+    children.push_back(rl);  // ~a
+    children.push_back(lr);  // ~b
     return true;
   }
 
   return false;
 }
 
+/**
+ * Check whether given two-level AIG encodes a xor b.
+ *
+ * @param aig The AIG to check.
+ * @param children The children of a xor b, added as a,b.
+ *
+ * @return True if given AIG is an exclusive or.
+ */
+bool
+is_xor(const AigNode& aig, std::vector<AigNode>& children)
+{
+  assert(aig.is_and());
+  assert(children.empty());
+
+  const auto l = aig[0];
+  if (!l.is_negated() || !l.is_and())
+  {
+    return false;
+  }
+
+  const auto r = aig[1];
+  if (!r.is_negated() || !r.is_and())
+  {
+    return false;
+  }
+
+  // Do not extract XOR if it destroys sharing of both AND gates. If only one
+  // of them is shared, the native encoding is still smaller.
+  if (l.parents() > 1 && r.parents() > 1)
+  {
+    return false;
+  }
+
+  // a xor b == ~(a /\ b) /\ ~(~a /\ ~b)
+  // Check all commutative cases of: ~(a /\ b) /\ ~(~a /\ ~b)
+  //                                   ll   lr     rl    rr
+  const auto ll = l[0];
+  const auto lr = l[1];
+  const auto rl = r[0];
+  const auto rr = r[1];
+
+  if ((ll.get_id() == -rl.get_id() && lr.get_id() == -rr.get_id())
+      || (ll.get_id() == -rr.get_id() && lr.get_id() == -rl.get_id()))
+  {
+    children.push_back(ll);  // a
+    children.push_back(lr);  // b
+    return true;
+  }
+
+  return false;
+}
+
+/**
+ * Collect the children of the multi-input AND gate rooted at `aig`.
+ *
+ * Non-negated AND gates with a single parent are merged into the gate,
+ * unless they encode an if-then-else or exclusive or, which are encoded
+ * natively.
+ *
+ * @param aig The AND gate.
+ * @param children The children of the multi-input AND gate.
+ */
+void
+collect_and(const AigNode& aig, std::vector<AigNode>& children)
+{
+  assert(aig.is_and());
+  assert(children.empty());
+
+  std::vector<AigNode> visit{aig[1], aig[0]};
+  std::vector<AigNode> gate_children;
+  do
+  {
+    AigNode cur = std::move(visit.back());
+    visit.pop_back();
+
+    gate_children.clear();
+    if (cur.is_and() && !cur.is_negated() && cur.parents() == 1
+        && !is_xor(cur, gate_children) && !is_ite(cur, gate_children))
+    {
+      visit.push_back(cur[1]);
+      visit.push_back(cur[0]);
+    }
+    else
+    {
+      children.push_back(std::move(cur));
+    }
+  } while (!visit.empty());
+}
+
+enum class Gate
+{
+  AND,
+  ITE,
+  XOR,
+};
+
+/**
+ * Determine the kind of gate `aig` encodes.
+ *
+ * @param aig The AND gate.
+ * @param children The children of the gate, see is_xor(), is_ite() and
+ *                 collect_and().
+ *
+ * @return The kind of the gate.
+ */
+Gate
+get_gate(const AigNode& aig, std::vector<AigNode>& children)
+{
+  if (is_xor(aig, children))
+  {
+    return Gate::XOR;
+  }
+  if (is_ite(aig, children))
+  {
+    return Gate::ITE;
+  }
+  collect_and(aig, children);
+  return Gate::AND;
+}
+
 }  // namespace
 
 void
-AigCnfEncoder::_encode(const AigNode& aig)
+AigCnfEncoder::_encode(const AigNode& aig, size_t scope)
 {
-  std::vector<const AigNode*> visit;
-  std::unordered_set<const AigNode*> cache;
-  visit.push_back(&aig);
+  // Polarities of the negation of a literal encoded with `polarity`.
+  auto flip = [](uint8_t polarity) {
+    return static_cast<uint8_t>(((polarity & POS) ? NEG : 0)
+                                | ((polarity & NEG) ? POS : 0));
+  };
+  // Polarities the node of literal `lit` has to be encoded with if `lit` has
+  // to be encoded with `polarity`.
+  auto node_polarity = [this, &flip](const AigNode& lit, uint8_t polarity) {
+    if (!d_polarity_aware)
+    {
+      return BOTH;
+    }
+    return lit.is_negated() ? flip(polarity) : polarity;
+  };
+
+  // Pairs of AIG node and the polarities it has to be encoded with.
+  std::vector<std::pair<AigNode, uint8_t>> visit;
+  std::unordered_set<int64_t> cache;
+  std::vector<AigNode> children;
+  visit.emplace_back(aig, node_polarity(aig, POS));
   do
   {
-    auto cur = visit.back();
-    resize(*cur);
+    const AigNode& cur = visit.back().first;
+    uint8_t polarity   = visit.back().second;
+    resize(cur);
 
-    if (is_encoded(*cur))
+    uint8_t missing = polarity & ~encoded_polarity(cur, scope);
+    if (missing == 0)
     {
       visit.pop_back();
       continue;
     }
 
-    if (cur->is_true() || cur->is_false() || cur->is_const())
+    if (cur.is_true() || cur.is_false() || cur.is_const())
     {
-      visit.pop_back();
-      set_encoded(*cur);
-      if (cur->is_true() || cur->is_false())
+      set_encoded(cur, BOTH, scope);
+      if (cur.is_true() || cur.is_false())
       {
-        d_sat_solver.add_clause({std::abs(cur->get_id())});
-        ++d_statistics.num_clauses;
-        ++d_statistics.num_literals;
+        add_clause({std::abs(cur.get_id())}, scope);
       }
+      visit.pop_back();
+      continue;
     }
-    else
+
+    assert(cur.is_and());
+
+    int64_t x = std::abs(cur.get_id());
+    auto [it, inserted] = cache.insert(x * 4 + polarity);
+
+    children.clear();
+    Gate gate = get_gate(cur, children);
+
+    if (inserted)
     {
-      assert(cur->is_and());
+      // Pushing to visit invalidates cur.
+      switch (gate)
+      {
+        case Gate::XOR:
+          for (const AigNode& child : children)
+          {
+            visit.emplace_back(child, node_polarity(child, BOTH));
+          }
+          break;
+
+        case Gate::ITE:
+          // Note: The then and else children are added negated.
+          visit.emplace_back(children[0], node_polarity(children[0], BOTH));
+          for (size_t i = 1; i < 3; ++i)
+          {
+            visit.emplace_back(children[i],
+                               flip(node_polarity(children[i], missing)));
+          }
+          break;
+
+        default:
+          assert(gate == Gate::AND);
+          for (const AigNode& child : children)
+          {
+            visit.emplace_back(child, node_polarity(child, missing));
+          }
+      }
+      continue;
+    }
 
-      auto [it, inserted] = cache.insert(cur);
+    set_encoded(cur, missing, scope);
 
-      std::vector<const AigNode*> children;
-      bool ite = is_ite(*cur, children);
+    if (gate == Gate::XOR)
+    {
+      // Encode x <-> a xor b
+      auto a = children[0].get_id();
+      auto b = children[1].get_id();
 
-      if (inserted)
+      if (missing & POS)
       {
-        if (ite)
-        {
-          visit.insert(visit.end(), children.begin(), children.end());
-        }
-        else
-        {
-          visit.push_back(&(*cur)[0]);
-          visit.push_back(&(*cur)[1]);
-        }
+        add_clause({-x, a, b}, scope);
+        add_clause({-x, -a, -b}, scope);
       }
-      else
+      if (missing & NEG)
       {
-        visit.pop_back();
-        set_encoded(*cur);
-
-        // TODO: and optimization: collect all children and encode one big and
-        // TODO: xor optimization: use native xor encoding
+        add_clause({x, -a, b}, scope);
+        add_clause({x, a, -b}, scope);
+      }
+    }
+    else if (gate == Gate::ITE)
+    {
+      // Encode x <-> ite(c,a,b)
+      auto c = children[0].get_id();   // cond
+      auto a = -children[1].get_id();  // then
+      auto b = -children[2].get_id();  // else
 
-        if (ite)
+      if (missing & POS)
+      {
+        add_clause({-x, -c, a}, scope);
+        add_clause({-x, c, b}, scope);
+      }
+      if (missing & NEG)
+      {
+        add_clause({x, -c, -a}, scope);
+        add_clause({x, c, -b}, scope);
+      }
+    }
+    else
+    {
+      // Encode multi-input AND
+      //
+      // x <-> a_1 /\ ... /\ a_n
+      //   --> (~x \/ a_1) /\ ... /\ (~x \/ a_n) /\ (x \/ ~a_1 \/ ... \/ ~a_n)
+      if (missing & POS)
+      {
+        for (const AigNode& child : children)
         {
-          // Encode x <-> ite(c,a,b)
-          auto x = std::abs(cur->get_id());
-          auto c = children[0]->get_id();   // cond
-          auto a = -children[1]->get_id();  // then
-          auto b = -children[2]->get_id();  // else
-
-          d_sat_solver.add_clause({-x, -c, a});
-          d_sat_solver.add_clause({-x, c, b});
-          d_sat_solver.add_clause({x, -c, -a});
-          d_sat_solver.add_clause({x, c, -b});
-          d_statistics.num_clauses += 4;
-          d_statistics.num_literals += 12;
+          add_clause({-x, child.get_id()}, scope);
         }
-        else
+      }
+      if (missing & NEG)
+      {
+        std::vector<int64_t> clause{x};
+        for (const AigNode& child : children)
         {
-          // Encode binary AND
-          //
-          // x <-> a /\ b --> (~x \/ a) /\ (~x \/ b) /\ (x \/ ~a \/ ~b)
-
-          auto x = std::abs(cur->get_id());
-          auto a = (*cur)[0].get_id();
-          auto b = (*cur)[1].get_id();
-
-          d_sat_solver.add_clause({-x, a});
-          d_sat_solver.add_clause({-x, b});
-          d_sat_solver.add_clause({x, -a, -b});
-          d_statistics.num_clauses += 3;
-          d_statistics.num_literals += 7;
+          clause.push_back(-child.get_id());
         }
+        add_clause(clause, scope);
       }
     }
+    visit.pop_back();
   } while (!visit.empty());
 }
 
+void
+AigCnfEncoder::add_clause(const std::initializer_list<int64_t>& literals,
+                          size_t scope)
+{
+  ++d_statistics.num_clauses;
+  d_statistics.num_literals += literals.size();
+  if (scope == 0)
+  {
+    d_sat_solver.add_clause(literals);
+    return;
+  }
+  assert(scope <= d_activation.size());
+  d_sat_solver.add(-d_activation[scope - 1]);
+  for (int64_t lit : literals)
+  {
+    d_sat_solver.add(lit);
+  }
+  d_sat_solver.add(0);
+  ++d_scope_clauses[scope - 1];
+}
+
+void
+AigCnfEncoder::add_clause(const std::vector<int64_t>& literals, size_t scope)
+{
+  ++d_statistics.num_clauses;
+  d_statistics.num_literals += literals.size();
+  if (scope > 0)
+  {
+    assert(scope <= d_activation.size());
+    d_sat_solver.add(-d_activation[scope - 1]);
+    ++d_scope_clauses[scope - 1];
+  }
+  for (int64_t lit : literals)
+  {
+    d_sat_solver.add(lit);
+  }
+  d_sat_solver.add(0);
+}
+
 void
 AigCnfEncoder::resize(const AigNode& aig)
 {
@@ -278,7 +543,7 @@ AigCnfEncoder::resize(const AigNode& aig)
   {
     return;
   }
-  d_aig_encoded.resize(pos + 1, false);
+  d_aig_encoded.resize(pos + 1, 0);
 }
 
 bool
@@ -287,17 +552,66 @@ AigCnfEncoder::is_encoded(const AigNode& aig) const
   size_t pos = static_cast<size_t>(std::abs(aig.get_id()) - 1);
   if (pos < d_aig_encoded.size())
   {
-    return d_aig_encoded[pos];
+    return d_aig_encoded[pos] != 0;
   }
   return false;
 }
 
+uint8_t
+AigCnfEncoder::encoded_polarity(const AigNode& aig, size_t scope) const
+{
+  int64_t id = std::abs(aig.get_id());
+  size_t pos = static_cast<size_t>(id - 1);
+  if (pos >= d_aig_encoded.size())
+  {
+    return 0;
+  }
+  uint8_t res = d_aig_encoded[pos];
+  if (res == 0 || d_aig_scope.empty())
+  {
+    return res;
+  }
+  for (uint8_t polarity : {POS, NEG})
+  {
+    if (res & polarity)
+    {
+      auto it = d_aig_scope.find(polarity == POS ? id : -id);
+      if (it != d_aig_scope.end() && it->second > scope)
+      {
+        res &= static_cast<uint8_t>(~polarity);
+      }
+    }
+  }
+  return res;
+}
+
 void
-AigCnfEncoder::set_encoded(const AigNode& aig)
+AigCnfEncoder::set_encoded(const AigNode& aig, uint8_t polarity, size_t scope)
 {
-  size_t pos = static_cast<size_t>(std::abs(aig.get_id()) - 1);
+  int64_t id = std::abs(aig.get_id());
+  size_t pos = static_cast<size_t>(id - 1);
   assert(pos < d_aig_encoded.size());
-  d_aig_encoded[pos] = true;
-  ++d_statistics.num_vars;
+  if (d_aig_encoded[pos] == 0)
+  {
+    ++d_statistics.num_vars;
+  }
+  d_aig_encoded[pos] |= polarity;
+  for (uint8_t pol : {POS, NEG})
+  {
+    if (!(polarity & pol))
+    {
+      continue;
+    }
+    int64_t key = pol == POS ? id : -id;
+    if (scope > 0)
+    {
+      d_aig_scope[key] = scope;
+      d_scope_aigs[scope - 1].push_back(key);
+    }
+    else if (!d_aig_scope.empty())
+    {
+      d_aig_scope.erase(key);
+    }
+  }
 }
 }  // namespace bzla::bitblast
@@ -10,6 +10,10 @@
 
 #ifndef BZLA__BITBLAST_AIG_CNF_H
 #define BZLA__BITBLAST_AIG_CNF_H
+
+#include <unordered_map>
+#include <vector>
+
 #include "bitblast/aig/aig_manager.h"
 
 namespace bzla::bitblast {
@@ -43,38 +47,120 @@ class AigCnfEncoder
     uint64_t num_vars     = 0;  // Number of added variables
     uint64_t num_clauses  = 0;  // Number of added clauses
     uint64_t num_literals = 0;  // Number of added literals
+    uint64_t num_retired  = 0;  // Number of clauses retired via pop()
   };
 
-  AigCnfEncoder(SatInterface& sat_solver) : d_sat_solver(sat_solver){};
+  /**
+   * Constructor.
+   *
+   * @param sat_solver The SAT solver to add the clauses to.
+   * @param polarity_aware True to only add the clauses required for the
+   *        polarity an AIG node occurs with (Plaisted-Greenbaum encoding),
+   *        else full Tseitin clauses are added for every AIG node.
+   */
+  AigCnfEncoder(SatInterface& sat_solver, bool polarity_aware = false)
+      : d_sat_solver(sat_solver), d_polarity_aware(polarity_aware){};
 
   /**
    * Recursively encodes AIG node to CNF.
    *
+   * AND gates with single-parent AND gate children are encoded as one
+   * multi-input AND gate, if-then-else and XOR gates are detected and
+   * encoded natively.
+   *
+   * If polarity-aware encoding is enabled, the node is encoded for the
+   * polarity it occurs with, i.e., only the clauses required to assert
+   * `node` are added.
+   *
    * @param node The AIG node to encode.
    * @param top_level Indicates whether given node is at the top level, which
    *        enables certain optimization.
+   * @param global True to encode the node in the global (bottom) scope, i.e.,
+   *        its clauses are never retired, else it is encoded in the current
+   *        scope.
    * */
-  void encode(const AigNode& node, bool top_level = false);
+  void encode(const AigNode& node, bool top_level = false, bool global = false);
 
+  /**
+   * Get the value of an encoded AIG node in the current model.
+   *
+   * Note: If polarity-aware encoding is enabled, the value is only guaranteed
+   *       to be consistent with the children of the node for AIG constants.
+   */
   int32_t value(const AigNode& node);
 
   /** @return CNF statistics. */
   const Statistics& statistics() const;
 
+  /** Checks whether `aig` was already encoded. */
+  bool is_encoded(const AigNode& aig) const;
+
+  /**
+   * Open a new encoding scope.
+   *
+   * All clauses added in this scope are guarded by the given activation
+   * literal, which has to be assumed when solving (see activation_lits()).
+   * The activation literal must be a fresh variable that is never reused.
+   *
+   * @param activation The activation literal of the new scope.
+   */
+  void push(int64_t activation);
+  /**
+   * Close the current encoding scope.
+   *
+   * Retires all clauses added in this scope by permanently disabling its
+   * activation literal, and resets the encoded flags of all AIG nodes that
+   * were encoded in this scope. These nodes are re-encoded if they are
+   * encoded again in a lower scope.
+   */
+  void pop();
+  /** @return The activation literals of all open scopes. */
+  const std::vector<int64_t>& activation_lits() const { return d_activation; }
+
  private:
+  /** Polarity flags, a node is encoded in positive and/or negative phase. */
+  static constexpr uint8_t POS  = 1;
+  static constexpr uint8_t NEG  = 2;
+  static constexpr uint8_t BOTH = POS | NEG;
+
   /** Encode AIG to CNF. */
-  void _encode(const AigNode& node);
+  void _encode(const AigNode& node, size_t scope);
+  /** Add clause, guarded by the activation literal of the given scope. */
+  void add_clause(const std::initializer_list<int64_t>& literals,
+                  size_t scope);
+  /** Add clause, guarded by the activation literal of the given scope. */
+  void add_clause(const std::vector<int64_t>& literals, size_t scope);
   /** Ensure that `d_aig_encoded` is big enough to store `aig`. */
   void resize(const AigNode& aig);
-  /** Checks whether `aig` was already encoded. */
-  bool is_encoded(const AigNode& aig) const;
-  /** Mark `aig` as encoded. */
-  void set_encoded(const AigNode& aig);
+  /** Mark `aig` as encoded in given scope for given polarities. */
+  void set_encoded(const AigNode& aig, uint8_t polarity, size_t scope);
+  /**
+   * @return The polarities `aig` was already encoded with in given scope or
+   *         below.
+   */
+  uint8_t encoded_polarity(const AigNode& aig, size_t scope) const;
 
-  /** Maps AIG id to flag that indicates whether the AIG was already encoded. */
-  std::vector<bool> d_aig_encoded;
+  /**
+   * Maps AIG id to the polarity flags that indicate whether the AIG was
+   * already encoded in positive and/or negative phase.
+   */
+  std::vector<uint8_t> d_aig_encoded;
+  /**
+   * Maps AIG ids of phases that were encoded in a scope above the global scope
+   * to the scope they were encoded in. The positive phase of an AIG is mapped
+   * via its id, the negative phase via its negated id.
+   */
+  std::unordered_map<int64_t, size_t> d_aig_scope;
+  /** The activation literals of all open scopes. */
+  std::vector<int64_t> d_activation;
+  /** The ids of the AIGs encoded in each open scope. */
+  std::vector<std::vector<int64_t>> d_scope_aigs;
+  /** The number of clauses added in each open scope. */
+  std::vector<uint64_t> d_scope_clauses;
   /** SAT solver. */
   SatInterface& d_sat_solver;
+  /** True if polarity-aware encoding is enabled. */
+  bool d_polarity_aware;
   /** CNF statistics. */
   Statistics d_statistics;
 };
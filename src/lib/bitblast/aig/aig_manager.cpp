@@ -10,112 +10,119 @@
 
 #include "bitblast/aig/aig_manager.h"
 
+#include <algorithm>
 #include <cstdlib>
 
 namespace bzla::bitblast {
 
 // AigNodeUniqueTable
 
-AigNodeUniqueTable::AigNodeUniqueTable() { d_buckets.resize(16, nullptr); }
-
-std::pair<bool, AigNodeData*>
-AigNodeUniqueTable::insert(AigNodeData* d)
+AigNodeUniqueTable::AigNodeUniqueTable(const std::vector<int64_t>& children)
+    : d_children(children)
 {
-  size_t h         = hash(d->d_left, d->d_right);
-  AigNodeData* cur = d_buckets[h];
-  int64_t left_id  = d->d_left.get_id();
-  int64_t right_id = d->d_right.get_id();
+  d_slots.resize(16, 0);
+}
 
-  // Check collision chain.
-  while (cur)
+int64_t
+AigNodeUniqueTable::find(int64_t left, int64_t right) const
+{
+  size_t mask = d_slots.size() - 1;
+  for (size_t i = hash(left, right);; i = (i + 1) & mask)
   {
-    if (cur->d_left.get_id() == left_id && cur->d_right.get_id() == right_id)
+    int64_t id = d_slots[i];
+    if (id == 0)
     {
-      return std::make_pair(false, cur);
+      return 0;
+    }
+    size_t pos = 2 * static_cast<size_t>(id - 1);
+    if (d_children[pos] == left && d_children[pos + 1] == right)
+    {
+      return id;
     }
-    cur = cur->next;
   }
+}
 
-  if (d_num_elements == d_buckets.capacity())
+void
+AigNodeUniqueTable::insert(int64_t id)
+{
+  assert(id > 0);
+  // Maximum load factor is 1/2 to keep probe sequences short.
+  if (2 * (d_num_elements + 1) > d_slots.size())
   {
     resize();
-    h = hash(d->d_left, d->d_right);
   }
-  assert(d->next == nullptr);
-  d->next      = d_buckets[h];
-  d_buckets[h] = d;
-
+  size_t mask = d_slots.size() - 1;
+  size_t i    = hash(id);
+  while (d_slots[i] != 0)
+  {
+    assert(d_slots[i] != id);
+    i = (i + 1) & mask;
+  }
+  d_slots[i] = id;
   ++d_num_elements;
-  return std::make_pair(true, d);
 }
 
 void
-AigNodeUniqueTable::erase(const AigNodeData* d)
+AigNodeUniqueTable::erase(int64_t id)
 {
-  size_t h          = hash(d->d_left, d->d_right);
-  AigNodeData* cur  = d_buckets[h];
-  AigNodeData* prev = nullptr;
-  assert(cur != nullptr);
-
-  // Should not happen
-  if (cur == nullptr)
+  assert(id > 0);
+  size_t mask = d_slots.size() - 1;
+  size_t i    = hash(id);
+  while (d_slots[i] != id)
   {
-    return;
+    assert(d_slots[i] != 0);
+    i = (i + 1) & mask;
   }
 
-  // Find data in collision chain.
-  int64_t left_id  = d->d_left.get_id();
-  int64_t right_id = d->d_right.get_id();
-  while (cur)
+  // Backward shift deletion: move entries of the probe sequence after the
+  // erased slot into the gap if their home slot does not lie in between.
+  for (size_t j = (i + 1) & mask; d_slots[j] != 0; j = (j + 1) & mask)
   {
-    if (cur->d_left.get_id() == left_id && cur->d_right.get_id() == right_id)
+    size_t home = hash(d_slots[j]);
+    if (((j - home) & mask) >= ((j - i) & mask))
     {
-      break;
+      d_slots[i] = d_slots[j];
+      i          = j;
     }
-    prev = cur;
-    cur  = cur->next;
-  }
-  assert(cur);
-
-  // Update collision chain.
-  if (prev == nullptr)
-  {
-    d_buckets[h] = cur->next;
-  }
-  else
-  {
-    prev->next = cur->next;
   }
+  d_slots[i] = 0;
   --d_num_elements;
 }
 
 size_t
-AigNodeUniqueTable::hash(const AigNode& left, const AigNode& right)
+AigNodeUniqueTable::hash(int64_t left, int64_t right) const
 {
-  size_t lhs = static_cast<size_t>(std::abs(left.get_id()));
-  size_t rhs = static_cast<size_t>(std::abs(right.get_id()));
-  size_t h   = 547789289u * lhs + 786695309u * rhs;
-  return h & (d_buckets.capacity() - 1);
+  uint64_t h = 547789289u * static_cast<uint64_t>(left)
+               + 786695309u * static_cast<uint64_t>(right);
+  h *= UINT64_C(0x9e3779b97f4a7c15);
+  return static_cast<size_t>(h >> 32) & (d_slots.size() - 1);
+}
+
+size_t
+AigNodeUniqueTable::hash(int64_t id) const
+{
+  size_t pos = 2 * static_cast<size_t>(id - 1);
+  return hash(d_children[pos], d_children[pos + 1]);
 }
 
 void
 AigNodeUniqueTable::resize()
 {
-  auto buckets = d_buckets;
-
-  d_buckets.clear();
-  d_buckets.resize(d_buckets.capacity() * 2, nullptr);
+  std::vector<int64_t> slots(d_slots.size() * 2, 0);
+  std::swap(slots, d_slots);
+  size_t mask = d_slots.size() - 1;
 
   // Rehash elements.
-  for (auto cur : buckets)
+  for (int64_t id : slots)
   {
-    while (cur)
+    if (id != 0)
     {
-      size_t h     = hash(cur->d_left, cur->d_right);
-      auto next    = cur->next;
-      cur->next    = d_buckets[h];
-      d_buckets[h] = cur;
-      cur          = next;
+      size_t i = hash(id);
+      while (d_slots[i] != 0)
+      {
+        i = (i + 1) & mask;
+      }
+      d_slots[i] = id;
     }
   }
 }
@@ -123,7 +130,9 @@ AigNodeUniqueTable::resize()
 // BitNodeInterface<AigNode>
 
 AigManager::AigManager()
-    : d_true(new_data(), false), d_false(d_true.d_data, true)
+    : d_unique_table(d_children),
+      d_true(this, new_node()),
+      d_false(this, -AigNode::s_true_id)
 {
   assert(d_true.get_id() == AigNode::s_true_id);
   assert(d_false.get_id() == -AigNode::s_true_id);
@@ -137,38 +146,43 @@ AigManager::statistics() const
   return d_statistics;
 }
 
-void
-AigManager::init_id(AigNodeData* d)
+int64_t
+AigManager::new_node(int64_t left, int64_t right)
 {
-  assert(d_aig_id_counter < INT64_MAX);
-  assert(d != nullptr);
-  assert(d->d_id == 0);
-  d_node_data.emplace_back(d);
-  assert(d_node_data.size() == static_cast<size_t>(d_aig_id_counter));
-  d->d_id = d_aig_id_counter++;
-  if (!d->d_left.is_null())
+  assert(d_refs.size() < static_cast<size_t>(INT64_MAX));
+  d_children.push_back(left);
+  d_children.push_back(right);
+  d_refs.push_back(0);
+  d_parents.push_back(0);
+  d_levels.push_back(0);
+  if (left != 0)
   {
-    ++d->d_left.d_data->d_parents;
-    ++d->d_right.d_data->d_parents;
+    assert(right != 0);
+    ++d_refs[index(left)];
+    ++d_parents[index(left)];
+    ++d_refs[index(right)];
+    ++d_parents[index(right)];
+    d_levels.back() =
+        1 + std::max(d_levels[index(left)], d_levels[index(right)]);
   }
+  return static_cast<int64_t>(d_refs.size());
 }
 
-AigNodeData*
-AigManager::find_or_create_and(const AigNode& left, const AigNode& right)
+int64_t
+AigManager::find_or_create_and(int64_t left, int64_t right)
 {
-  assert(std::abs(left.get_id()) < std::abs(right.get_id()));
-  AigNodeData* d          = new AigNodeData(this, left, right);
-  auto [inserted, lookup] = d_unique_table.insert(d);
-  if (!inserted)
+  assert(std::abs(left) < std::abs(right));
+  int64_t id = d_unique_table.find(left, right);
+  if (id != 0)
   {
     ++d_statistics.num_shared;
-    delete d;
-    return lookup;
+    return id;
   }
 
-  init_id(d);
+  id = new_node(left, right);
+  d_unique_table.insert(id);
   ++d_statistics.num_ands;
-  return d;
+  return id;
 }
 
 AigNode
@@ -400,37 +414,14 @@ AigManager::rewrite_and(const AigNode& l, const AigNode& r)
   }
 
   // create AND with left, right
-  AigNodeData* d = find_or_create_and(get_node(left), get_node(right));
-  return AigNode(d);
-}
-
-AigNode
-AigManager::get_node(int64_t id)
-{
-  assert(static_cast<size_t>(std::abs(id)) <= d_node_data.size());
-  return AigNode(d_node_data[std::abs(id) - 1].get(), id < 0);
-}
-
-std::pair<int64_t, int64_t>
-AigManager::get_children(int64_t id) const
-{
-  assert(static_cast<size_t>(std::abs(id)) <= d_node_data.size());
-  const auto& d = d_node_data[std::abs(id) - 1];
-  return {d->d_left.get_id(), d->d_right.get_id()};
-}
-
-AigNodeData*
-AigManager::new_data()
-{
-  AigNodeData* d = new AigNodeData(this);
-  init_id(d);
-  return d;
+  return AigNode(this, find_or_create_and(left, right));
 }
 
 void
-AigManager::garbage_collect(AigNodeData* d)
+AigManager::garbage_collect(int64_t id)
 {
-  assert(d->d_refs == 0);
+  assert(id > 0);
+  assert(d_refs[index(id)] == 0);
 
   if (d_gc_mode)
   {
@@ -440,51 +431,39 @@ AigManager::garbage_collect(AigNodeData* d)
 
   d_gc_mode = true;
 
-  AigNodeData *cur, *data;
-  std::vector<AigNodeData*> visit{d};
-
+  std::vector<int64_t> visit{id};
   do
   {
-    cur = visit.back();
+    int64_t cur = visit.back();
     visit.pop_back();
-    assert(cur->d_refs == 0);
+    size_t pos = 2 * index(cur);
+    assert(d_refs[index(cur)] == 0);
 
     // Decrement reference counts for children of AND nodes
-    if (!cur->d_left.is_null())
+    if (d_children[pos] != 0)
     {
-      assert(!cur->d_right.is_null());
+      assert(d_children[pos + 1] != 0);
 
-      // Erase node data from unique table before we modify children.
+      // Erase node from unique table before we modify children.
       d_unique_table.erase(cur);
 
-      data = cur->d_left.d_data;
-      --data->d_refs;
-      --data->d_parents;
-      cur->d_left.d_data = nullptr;
-      if (data->d_refs == 0)
+      for (size_t i = pos; i < pos + 2; ++i)
       {
-        visit.push_back(data);
-      }
-
-      data = cur->d_right.d_data;
-      --data->d_refs;
-      --data->d_parents;
-      cur->d_right.d_data = nullptr;
-      if (data->d_refs == 0)
-      {
-        visit.push_back(data);
+        size_t child = index(d_children[i]);
+        --d_refs[child];
+        --d_parents[child];
+        d_children[i] = 0;
+        if (d_refs[child] == 0)
+        {
+          visit.push_back(static_cast<int64_t>(child) + 1);
+        }
       }
       --d_statistics.num_ands;
     }
-    else
+    else if (cur != AigNode::s_true_id)
     {
       --d_statistics.num_consts;
     }
-
-    // Delete node data
-    assert(cur->d_id > 0);
-    assert(d_node_data[static_cast<size_t>(cur->d_id) - 1]->d_id == cur->d_id);
-    d_node_data[static_cast<size_t>(cur->d_id) - 1].reset(nullptr);
   } while (!visit.empty());
 
   d_gc_mode = false;
@@ -14,34 +14,57 @@
 #include <cassert>
 #include <cstddef>
 #include <cstdint>
-#include <memory>
+#include <cstdlib>
 #include <vector>
 
 #include "bitblast/aig/aig_node.h"
 
 namespace bzla::bitblast {
 
-// AigNodeUniqueTable
+/**
+ * Open addressing hash table for hash consing of AND gates.
+ *
+ * Stores the ids of AND gates only, the children of a gate are looked up in
+ * the node storage of the AIG manager. Uses linear probing and backward shift
+ * deletion, hence no tombstones are required.
+ */
 class AigNodeUniqueTable
 {
  public:
-  AigNodeUniqueTable();
+  AigNodeUniqueTable(const std::vector<int64_t>& children);
+
+  /**
+   * Find AND gate with given children.
+   * @return The id of the AND gate, or 0 if it does not exist.
+   */
+  int64_t find(int64_t left, int64_t right) const;
+  /**
+   * Insert AND gate with given id. Its children must already be stored in
+   * the node storage.
+   */
+  void insert(int64_t id);
+  /** Erase AND gate with given id. */
+  void erase(int64_t id);
 
-  // AigNodeData* lookup(const AigNode& left, const AigNode& right);
-  std::pair<bool, AigNodeData*> insert(AigNodeData* d);
-  void erase(const AigNodeData* d);
+  /** @return The number of stored AND gates. */
+  size_t size() const { return d_num_elements; }
 
  private:
-  size_t hash(const AigNode& left, const AigNode& right);
+  size_t hash(int64_t left, int64_t right) const;
+  size_t hash(int64_t id) const;
   void resize();
 
+  /** Reference to the children storage of the AIG manager. */
+  const std::vector<int64_t>& d_children;
+  /** The number of stored AND gates. */
   size_t d_num_elements = 0;
-  std::vector<AigNodeData*> d_buckets;
+  /** Hash table slots storing AND gate ids, 0 denotes an empty slot. */
+  std::vector<int64_t> d_slots;
 };
 
 class AigManager
 {
-  friend class AigNodeData;
+  friend class AigNode;
 
  public:
   struct Statistics
@@ -59,13 +82,10 @@ class AigManager
   AigNode mk_const()
   {
     ++d_statistics.num_consts;
-    return AigNode(new_data());
+    return AigNode(this, new_node());
   }
 
-  AigNode mk_not(const AigNode& a)
-  {
-    return AigNode(a.d_data, !a.is_negated());
-  }
+  AigNode mk_not(const AigNode& a) { return AigNode(this, -a.get_id()); }
 
   AigNode mk_and(const AigNode& a, const AigNode& b)
   {
@@ -76,21 +96,47 @@ class AigManager
   const Statistics& statistics() const;
 
  private:
-  /** Counter for AIG ids. */
-  int64_t d_aig_id_counter = AigNode::s_true_id;
+  /** @return The index of the node with given id into the node storage. */
+  static size_t index(int64_t id)
+  {
+    assert(id != 0);
+    return static_cast<size_t>(std::abs(id)) - 1;
+  }
+
+  /** @return The left child id of given node, 0 if it is not an AND gate. */
+  int64_t left(int64_t id) const { return d_children[2 * index(id)]; }
+  /** @return The right child id of given node, 0 if it is not an AND gate. */
+  int64_t right(int64_t id) const { return d_children[2 * index(id) + 1]; }
+
+  void inc_refs(int64_t id) { ++d_refs[index(id)]; }
+  void dec_refs(int64_t id)
+  {
+    size_t i = index(id);
+    assert(d_refs[i] > 0);
+    if (--d_refs[i] == 0)
+    {
+      garbage_collect(std::abs(id));
+    }
+  }
 
-  /** Returns the next free AIG id. */
-  void init_id(AigNodeData* d);
+  /**
+   * Allocate storage for a new node. Node ids are assigned in increasing
+   * order and never reused.
+   *
+   * @param left  Left child id of AND gate, 0 for constants.
+   * @param right Right child id of AND gate, 0 for constants.
+   * @return The id of the new node.
+   */
+  int64_t new_node(int64_t left = 0, int64_t right = 0);
 
   /**
-   * Find already constructed and gate with given children.
+   * Find already constructed and gate with given children or create a new one.
    *
    * @param left Left child of AND gate.
    * @param right Right child of AND gate.
-   * @return Pointer to existing node data or nullptr if AND gate was not yet
-   * constructed.
+   * @return The id of the AND gate.
    */
-  AigNodeData* find_or_create_and(const AigNode& left, const AigNode& right);
+  int64_t find_or_create_and(int64_t left, int64_t right);
 
   /**
    * Implements two-level AIG rewriting from [1].
@@ -101,23 +147,35 @@ class AigManager
   AigNode rewrite_and(const AigNode& left, const AigNode& right);
 
   /** Get AigNode by id. */
-  AigNode get_node(int64_t id);
+  AigNode get_node(int64_t id) { return AigNode(this, id); }
 
   /** Get children ids from AND gate. */
-  std::pair<int64_t, int64_t> get_children(int64_t id) const;
-
-  /**
-   * Construct a new node data.
-   */
-  AigNodeData* new_data();
+  std::pair<int64_t, int64_t> get_children(int64_t id) const
+  {
+    size_t i = 2 * index(id);
+    return {d_children[i], d_children[i + 1]};
+  }
 
   /**
-   * Delete given node data.
+   * Delete given node and all its children that are not referenced.
+   *
+   * @note Deleted nodes are removed from the unique table, but their slots in
+   *       the node storage are not freed. Node ids are never reused since
+   *       clients identify nodes by id, e.g., the CNF encoder uses node ids
+   *       as SAT variables. The node storage thus grows with the number of
+   *       nodes ever created (28 bytes per node), and its memory is not
+   *       returned before the manager is destructed.
    */
-  void garbage_collect(AigNodeData* d);
+  void garbage_collect(int64_t id);
 
-  /** Maps node id to node data and stores all created node data. */
-  std::vector<std::unique_ptr<AigNodeData>> d_node_data;
+  /** Child ids of all nodes, stored as pairs (left, right) at 2 * index. */
+  std::vector<int64_t> d_children;
+  /** Reference count of all nodes. */
+  std::vector<uint32_t> d_refs;
+  /** Number of parents of all nodes. */
+  std::vector<uint32_t> d_parents;
+  /** Level of all nodes, i.e., the length of the longest path to a leaf. */
+  std::vector<uint32_t> d_levels;
   /** AND gate cache used for hash consing. */
   AigNodeUniqueTable d_unique_table;
 
@@ -132,6 +190,105 @@ class AigManager
   Statistics d_statistics;
 };
 
+/* --- AigNode inline methods ----------------------------------------------- */
+
+inline AigNode::AigNode(AigManager* mgr, int64_t id) : d_mgr(mgr), d_id(id)
+{
+  d_mgr->inc_refs(d_id);
+}
+
+inline AigNode::~AigNode()
+{
+  if (!is_null())
+  {
+    d_mgr->dec_refs(d_id);
+  }
+}
+
+inline AigNode::AigNode(const AigNode& other)
+    : d_mgr(other.d_mgr), d_id(other.d_id)
+{
+  assert(!other.is_null());
+  d_mgr->inc_refs(d_id);
+}
+
+inline AigNode&
+AigNode::operator=(const AigNode& other)
+{
+  other.d_mgr->inc_refs(other.d_id);
+  if (!is_null())
+  {
+    d_mgr->dec_refs(d_id);
+  }
+  d_mgr = other.d_mgr;
+  d_id  = other.d_id;
+  return *this;
+}
+
+inline AigNode::AigNode(AigNode&& other) : d_mgr(other.d_mgr), d_id(other.d_id)
+{
+  other.d_mgr = nullptr;
+  other.d_id  = 0;
+}
+
+inline AigNode&
+AigNode::operator=(AigNode&& other)
+{
+  if (this != &other)
+  {
+    if (!is_null())
+    {
+      d_mgr->dec_refs(d_id);
+    }
+    d_mgr       = other.d_mgr;
+    d_id        = other.d_id;
+    other.d_mgr = nullptr;
+    other.d_id  = 0;
+  }
+  return *this;
+}
+
+inline bool
+AigNode::is_and() const
+{
+  return d_mgr->left(d_id) != 0;
+}
+
+inline bool
+AigNode::is_const() const
+{
+  return !is_and() && !is_true() && !is_false();
+}
+
+inline AigNode
+AigNode::operator[](int index) const
+{
+  assert(is_and());
+  assert(index == 0 || index == 1);
+  return AigNode(d_mgr, index == 0 ? d_mgr->left(d_id) : d_mgr->right(d_id));
+}
+
+inline uint32_t
+AigNode::parents() const
+{
+  assert(!is_null());
+  return d_mgr->d_parents[AigManager::index(d_id)];
+}
+
+inline uint32_t
+AigNode::level() const
+{
+  assert(!is_null());
+  return d_mgr->d_levels[AigManager::index(d_id)];
+}
+
+inline uint64_t
+AigNode::get_refs() const
+{
+  assert(!is_null());
+  return d_mgr->d_refs[AigManager::index(d_id)];
+}
+
 }  // namespace bzla::bitblast
 
 #endif
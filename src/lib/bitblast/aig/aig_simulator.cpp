@@ -0,0 +1,145 @@
+/***
+ * Bitwuzla: Satisfiability Modulo Theories (SMT) solver.
+ *
+ * Copyright (C) 2023 by the authors listed in the AUTHORS file at
+ * https://github.com/bitwuzla/bitwuzla/blob/main/AUTHORS
+ *
+ * This file is part of Bitwuzla under the MIT license. See COPYING for more
+ * information at https://github.com/bitwuzla/bitwuzla/blob/main/COPYING
+ */
+
+#include "bitblast/aig/aig_simulator.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstdlib>
+#include <limits>
+
+namespace bzla::bitblast {
+
+AigSimulator::AigSimulator(const std::vector<AigNode>& roots)
+{
+  constexpr size_t none = std::numeric_limits<size_t>::max();
+
+  std::vector<AigNode> visit(roots.begin(), roots.end());
+  while (!visit.empty())
+  {
+    const AigNode& cur  = visit.back();
+    int64_t id          = std::abs(cur.get_id());
+    auto [it, inserted] = d_index.emplace(id, none);
+    if (inserted && cur.is_and())
+    {
+      // Pushing to visit invalidates cur.
+      AigNode left  = cur[0];
+      AigNode right = cur[1];
+      visit.push_back(std::move(left));
+      visit.push_back(std::move(right));
+      continue;
+    }
+    if (it->second == none)
+    {
+      it->second = d_nodes.size();
+      if (cur.is_and())
+      {
+        for (size_t j = 0; j < 2; ++j)
+        {
+          AigNode child = cur[j];
+          d_fanins.push_back((index(child) << 1)
+                             | (child.is_negated() ? 1 : 0));
+        }
+      }
+      else
+      {
+        d_fanins.push_back(0);
+        d_fanins.push_back(0);
+        if (!cur.is_true() && !cur.is_false())
+        {
+          d_inputs.push_back(d_nodes.size());
+        }
+      }
+      d_nodes.push_back(cur);
+    }
+    visit.pop_back();
+  }
+}
+
+size_t
+AigSimulator::index(const AigNode& node) const
+{
+  auto it = d_index.find(std::abs(node.get_id()));
+  assert(it != d_index.end());
+  return it->second;
+}
+
+void
+AigSimulator::simulate(const std::vector<uint64_t>& patterns,
+                       size_t num_words)
+{
+  assert(patterns.size() == d_inputs.size() * num_words);
+  d_num_words = num_words;
+  d_values.resize(d_nodes.size() * num_words);
+
+  for (size_t k = 0, size = d_inputs.size(); k < size; ++k)
+  {
+    std::copy(patterns.begin() + k * num_words,
+              patterns.begin() + (k + 1) * num_words,
+              d_values.begin() + d_inputs[k] * num_words);
+  }
+
+  // Nodes are in topological order, the fanins of a gate are thus always
+  // simulated before the gate. The inner loop over the words is vectorized
+  // by the compiler.
+  uint64_t* values = d_values.data();
+  for (size_t i = 0, size = d_nodes.size(); i < size; ++i)
+  {
+    uint64_t* res = values + i * num_words;
+    if (!d_nodes[i].is_and())
+    {
+      if (d_nodes[i].is_true() || d_nodes[i].is_false())
+      {
+        std::fill(res, res + num_words, ~uint64_t(0));
+      }
+      continue;
+    }
+    size_t l             = d_fanins[2 * i];
+    size_t r             = d_fanins[2 * i + 1];
+    const uint64_t* a    = values + (l >> 1) * num_words;
+    const uint64_t* b    = values + (r >> 1) * num_words;
+    const uint64_t neg_a = l & 1 ? ~uint64_t(0) : 0;
+    const uint64_t neg_b = r & 1 ? ~uint64_t(0) : 0;
+    for (size_t w = 0; w < num_words; ++w)
+    {
+      res[w] = (a[w] ^ neg_a) & (b[w] ^ neg_b);
+    }
+  }
+}
+
+uint64_t
+AigSimulator::value(const AigNode& node, size_t w) const
+{
+  assert(w < d_num_words);
+  uint64_t res = values(index(node))[w];
+  return node.is_negated() ? ~res : res;
+}
+
+bool
+AigSimulator::find_pattern(const std::vector<AigNode>& nodes,
+                           size_t& pattern) const
+{
+  for (size_t w = 0; w < d_num_words; ++w)
+  {
+    uint64_t sat = ~uint64_t(0);
+    for (size_t i = 0, size = nodes.size(); i < size && sat; ++i)
+    {
+      sat &= value(nodes[i], w);
+    }
+    if (sat)
+    {
+      pattern = w * 64 + __builtin_ctzll(sat);
+      return true;
+    }
+  }
+  return false;
+}
+
+}  // namespace bzla::bitblast
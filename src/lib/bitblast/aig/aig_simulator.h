@@ -0,0 +1,126 @@
+/***
+ * Bitwuzla: Satisfiability Modulo Theories (SMT) solver.
+ *
+ * Copyright (C) 2023 by the authors listed in the AUTHORS file at
+ * https://github.com/bitwuzla/bitwuzla/blob/main/AUTHORS
+ *
+ * This file is part of Bitwuzla under the MIT license. See COPYING for more
+ * information at https://github.com/bitwuzla/bitwuzla/blob/main/COPYING
+ */
+
+#ifndef BZLA__BITBLAST_AIG_AIG_SIMULATOR_H
+#define BZLA__BITBLAST_AIG_AIG_SIMULATOR_H
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "bitblast/aig/aig_node.h"
+
+namespace bzla::bitblast {
+
+/**
+ * Word-parallel simulator for AIGs.
+ *
+ * Evaluates the cones of a set of roots on 64 input patterns per 64-bit
+ * word, for an arbitrary number of words at once. The nodes of the cones are
+ * indexed in topological order, where index 0 is the constant true node.
+ * Simulation values are stored per non-negated node, with all words of a
+ * node stored contiguously.
+ */
+class AigSimulator
+{
+ public:
+  /**
+   * Constructor.
+   * @param roots The roots of the cones to simulate.
+   */
+  AigSimulator(const std::vector<AigNode>& roots);
+
+  /** @return The number of (non-negated) nodes in the simulated cones. */
+  size_t size() const { return d_nodes.size(); }
+
+  /**
+   * Get the node with given index. The node is stored as it was first
+   * encountered, i.e., it may be negated.
+   * @param i The index of the node.
+   * @return The node with index `i`.
+   */
+  const AigNode& node(size_t i) const { return d_nodes[i]; }
+
+  /**
+   * Get the index of given node, which must be in the simulated cones.
+   * @param node The node, may be negated.
+   * @return The index of the non-negated `node`.
+   */
+  size_t index(const AigNode& node) const;
+
+  /** @return True if the node with index `i` is an AND gate. */
+  bool is_and(size_t i) const { return d_nodes[i].is_and(); }
+
+  /**
+   * Get fanin of an AND gate.
+   * @param i The index of the AND gate.
+   * @param j The fanin, 0 or 1.
+   * @return The fanin encoded as `(index << 1) | negated`.
+   */
+  size_t fanin(size_t i, size_t j) const { return d_fanins[2 * i + j]; }
+
+  /** @return The indices of the inputs of the simulated cones. */
+  const std::vector<size_t>& inputs() const { return d_inputs; }
+
+  /** @return The number of words simulated by the last simulate() call. */
+  size_t num_words() const { return d_num_words; }
+
+  /**
+   * Simulate the cones on given input patterns.
+   * @param patterns  The input patterns, where the `num_words` words of the
+   *                  k-th input in `inputs()` start at `k * num_words`.
+   * @param num_words The number of words per input.
+   */
+  void simulate(const std::vector<uint64_t>& patterns, size_t num_words);
+
+  /**
+   * Get simulation values of the non-negated node with index `i`.
+   * @return Pointer to `num_words()` words.
+   */
+  const uint64_t* values(size_t i) const
+  {
+    return d_values.data() + i * d_num_words;
+  }
+
+  /**
+   * Get the `w`-th simulation word of given node.
+   * @param node The node, may be negated.
+   * @param w    The index of the word.
+   */
+  uint64_t value(const AigNode& node, size_t w) const;
+
+  /**
+   * Find a pattern of the last simulate() call that satisfies all given
+   * nodes.
+   * @param nodes   The nodes to satisfy, must be in the simulated cones.
+   * @param pattern Set to the index of the pattern, i.e., bit `pattern % 64`
+   *                of word `pattern / 64`, if a pattern was found.
+   * @return True if a satisfying pattern was found.
+   */
+  bool find_pattern(const std::vector<AigNode>& nodes, size_t& pattern) const;
+
+ private:
+  /** The nodes in topological order. */
+  std::vector<AigNode> d_nodes;
+  /** Maps ids of non-negated nodes to their index. */
+  std::unordered_map<int64_t, size_t> d_index;
+  /** Fanins of the nodes, two per node and `(index << 1) | negated`. */
+  std::vector<size_t> d_fanins;
+  /** The indices of the inputs. */
+  std::vector<size_t> d_inputs;
+  /** The number of words per node of the last simulation. */
+  size_t d_num_words = 0;
+  /** The simulation values, `d_num_words` per node. */
+  std::vector<uint64_t> d_values;
+};
+
+}  // namespace bzla::bitblast
+
+#endif
@@ -66,6 +66,16 @@ class AigBitblaster : public BitblasterInterface<AigNode>
 
   /** @return Number of shared AND gates. */
   uint64_t num_aig_shared() const { return d_bit_mgr.statistics().num_shared; }
+
+  /** @return The AIG node representing true. */
+  AigNode mk_true() { return d_bit_mgr.mk_true(); }
+  /** @return The negation of AIG node `a`. */
+  AigNode mk_not(const AigNode& a) { return d_bit_mgr.mk_not(a); }
+  /** @return The AND gate of AIG nodes `a` and `b`. */
+  AigNode mk_and(const AigNode& a, const AigNode& b)
+  {
+    return d_bit_mgr.mk_and(a, b);
+  }
 };
 
 }  // namespace bzla::bitblast
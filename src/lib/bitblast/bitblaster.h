@@ -11,6 +11,7 @@
 #ifndef BZLA__BITBLAST_BITBLASTER_H
 #define BZLA__BITBLAST_BITBLASTER_H
 
+#include <algorithm>
 #include <cassert>
 #include <cmath>
 #include <cstddef>
@@ -46,12 +47,60 @@ class BitInterface
   T mk_ite(const T& c, const T& a, const T& b);
 };
 
+/** Encodings for bit-vector multiplication. */
+enum class MulEncoding
+{
+  /** Shift-and-add array multiplier. */
+  ARRAY,
+  /** Radix-4 Booth recoding, partial products summed with a Wallace tree. */
+  BOOTH,
+  /** Partial products summed with a Wallace tree. */
+  WALLACE,
+  /** Karatsuba-style splitting of wide operands, Wallace tree otherwise. */
+  KARATSUBA,
+};
+
+/** Encodings for unsigned bit-vector division and remainder. */
+enum class DivEncoding
+{
+  /** Restoring shift-subtract divider. */
+  RESTORING,
+  /** Non-restoring divider, adds or subtracts the divisor in each row. */
+  NON_RESTORING,
+  /**
+   * Fresh quotient and remainder bits constrained by a = q * b + r and r < b
+   * via the multiplier (see side_constraints()).
+   */
+  MULTIPLIER,
+};
+
 template <class T>
 class BitblasterInterface
 {
  public:
   using Bits = std::vector<T>;
 
+  /** Configure the encoding used for bit-vector multiplication. */
+  void set_mul_encoding(MulEncoding encoding) { d_mul_encoding = encoding; }
+
+  /** Configure the encoding used for bit-vector division and remainder. */
+  void set_div_encoding(DivEncoding encoding) { d_div_encoding = encoding; }
+
+  /**
+   * Get and clear the side constraints created since the last call.
+   *
+   * Some encodings (e.g., DivEncoding::MULTIPLIER) introduce fresh bits that
+   * are only defined by side constraints. These constraints must be asserted
+   * for the encoded bits to have the intended semantics. Since they only
+   * constrain fresh bits, they can be asserted globally.
+   */
+  Bits take_side_constraints()
+  {
+    Bits res;
+    res.swap(d_side_constraints);
+    return res;
+  }
+
   virtual Bits bv_value(const BitVector& bv_value)
   {
     Bits res;
@@ -343,25 +392,48 @@ class BitblasterInterface
   virtual Bits bv_mul(const Bits& a, const Bits& b)
   {
     // Normalize operands s.t. operands with fixed bits come first
-    if (a > b)
+    const Bits& x = a > b ? b : a;
+    const Bits& y = a > b ? a : b;
+    switch (d_mul_encoding)
     {
-      return mul_helper(b, a);
+      case MulEncoding::BOOTH: return booth_mul_helper(x, y);
+      case MulEncoding::WALLACE: return wallace_mul_helper(x, y);
+      case MulEncoding::KARATSUBA: return karatsuba_mul_helper(x, y);
+      default: assert(d_mul_encoding == MulEncoding::ARRAY);
     }
-    return mul_helper(a, b);
+    return mul_helper(x, y);
   }
 
   virtual Bits bv_udiv(const Bits& a, const Bits& b)
   {
-    auto [res, rem] = udiv_urem_helper(a, b);
+    auto [res, rem] = bv_udiv_urem(a, b);
     return res;
   }
 
   virtual Bits bv_urem(const Bits& a, const Bits& b)
   {
-    auto [res, rem] = udiv_urem_helper(a, b);
+    auto [res, rem] = bv_udiv_urem(a, b);
     return rem;
   }
 
+  /**
+   * Bit-blast unsigned division and remainder of `a` and `b` with a single
+   * divider circuit.
+   *
+   * Returns a pair consisting of the quotient and the remainder.
+   */
+  virtual std::pair<Bits, Bits> bv_udiv_urem(const Bits& a, const Bits& b)
+  {
+    switch (d_div_encoding)
+    {
+      case DivEncoding::NON_RESTORING:
+        return udiv_urem_non_restoring_helper(a, b);
+      case DivEncoding::MULTIPLIER: return udiv_urem_mul_helper(a, b);
+      default: assert(d_div_encoding == DivEncoding::RESTORING);
+    }
+    return udiv_urem_helper(a, b);
+  }
+
   /**
    * Bit-blast special-purpose circuit for square `a*a` (special case of
    * bit-vector multiplication that allows for a simpler circuit).
@@ -419,6 +491,16 @@ class BitblasterInterface
   BitInterface<T> d_bit_mgr;
 
  private:
+  /** Operands smaller than this are not split by karatsuba_mul_helper(). */
+  static constexpr size_t s_karatsuba_min_size = 32;
+
+  /** The encoding used for bit-vector multiplication. */
+  MulEncoding d_mul_encoding = MulEncoding::ARRAY;
+  /** The encoding used for bit-vector division and remainder. */
+  DivEncoding d_div_encoding = DivEncoding::RESTORING;
+  /** Side constraints not yet retrieved via take_side_constraints(). */
+  Bits d_side_constraints;
+
   Bits add_helper(const Bits& a, const Bits& b)
   {
     Bits res;
@@ -474,6 +556,210 @@ class BitblasterInterface
     return res;
   }
 
+  /**
+   * Multiplier that sums up all partial products a[i] * b[j] with a Wallace
+   * tree (see compress_columns()).
+   */
+  Bits wallace_mul_helper(const Bits& a, const Bits& b)
+  {
+    size_t size = a.size();
+    std::vector<Bits> columns(size);
+    // Note: Column i collects the bits of weight 2^i, i.e., bits are indexed
+    //       from the lsb here.
+    for (size_t i = 0, ib = size - 1; i < size; ++i, --ib)
+    {
+      for (size_t j = 0, ia = size - 1; i + j < size; ++j, --ia)
+      {
+        columns[i + j].push_back(d_bit_mgr.mk_and(a[ia], b[ib]));
+      }
+    }
+    return compress_columns(columns);
+  }
+
+  /**
+   * Multiplier with radix-4 Booth recoding of `b`, which halves the number of
+   * partial products. The partial products are summed up with a Wallace tree
+   * (see compress_columns()).
+   */
+  Bits booth_mul_helper(const Bits& a, const Bits& b)
+  {
+    size_t size = a.size();
+    size_t lsb  = size - 1;
+    T false_bit = d_bit_mgr.mk_false();
+    std::vector<Bits> columns(size);
+
+    // Booth digit i is determined by bits b[2i+1], b[2i], b[2i-1] (indexed
+    // from the lsb) and is one of {-2, -1, 0, 1, 2}. Since we only need the
+    // lower `size` bits of the product, it does not matter whether `b` is
+    // interpreted as signed or unsigned, we sign-extend.
+    for (size_t i = 0; i < size; i += 2)
+    {
+      const T& x0 = i == 0 ? false_bit : b[lsb - i + 1];
+      const T& x1 = b[lsb - i];
+      const T& x2 = i + 1 < size ? b[lsb - i - 1] : x1;
+
+      // |digit| = 1
+      T one = mk_xor(x1, x0);
+      // |digit| = 2
+      T two = d_bit_mgr.mk_and(d_bit_mgr.mk_not(one), mk_xor(x2, x1));
+      // digit < 0: partial product is ~(|digit| * a) + 1
+      const T& neg = x2;
+
+      for (size_t j = i; j < size; ++j)
+      {
+        T sel = d_bit_mgr.mk_and(one, a[lsb - (j - i)]);
+        if (j > i)
+        {
+          T sel2 = d_bit_mgr.mk_and(two, a[lsb - (j - i - 1)]);
+          sel    = d_bit_mgr.mk_or(sel, sel2);
+        }
+        columns[j].push_back(mk_xor(sel, neg));
+      }
+      columns[i].push_back(neg);
+    }
+    return compress_columns(columns);
+  }
+
+  /**
+   * Multiplier that splits wide operands into halves a = a1 * 2^k + a0 and
+   * b = b1 * 2^k + b0, and computes
+   *
+   *   a * b mod 2^n = a0 * b0 + ((a1 * b0 + a0 * b1) mod 2^(n-k)) * 2^k
+   *
+   * where the full product a0 * b0 is computed with Karatsuba's algorithm
+   * (see karatsuba_full_mul_helper()).
+   */
+  Bits karatsuba_mul_helper(const Bits& a, const Bits& b)
+  {
+    size_t size = a.size();
+    if (size < s_karatsuba_min_size)
+    {
+      return wallace_mul_helper(a, b);
+    }
+    size_t lo = (size + 1) / 2;
+    size_t hi = size - lo;
+    Bits a0(a.end() - lo, a.end()), a1(a.begin(), a.begin() + hi);
+    Bits b0(b.end() - lo, b.end()), b1(b.begin(), b.begin() + hi);
+
+    Bits low = resize_shl(karatsuba_full_mul_helper(a0, b0), 0, size);
+    Bits cross =
+        add_helper(karatsuba_mul_helper(a1, Bits(b0.end() - hi, b0.end())),
+                   karatsuba_mul_helper(Bits(a0.end() - hi, a0.end()), b1));
+    return add_helper(low, resize_shl(cross, lo, size));
+  }
+
+  /**
+   * Karatsuba multiplier that computes the full product of size 2 * n of two
+   * operands of size n.
+   *
+   * With a = a1 * 2^k + a0 and b = b1 * 2^k + b0:
+   *   z0 = a0 * b0, z2 = a1 * b1, z1 = (a0 + a1) * (b0 + b1) - z0 - z2
+   *   a * b = z2 * 2^(2k) + z1 * 2^k + z0
+   */
+  Bits karatsuba_full_mul_helper(const Bits& a, const Bits& b)
+  {
+    size_t size = a.size();
+    if (size < s_karatsuba_min_size)
+    {
+      return wallace_mul_helper(resize_shl(a, 0, 2 * size),
+                                resize_shl(b, 0, 2 * size));
+    }
+    size_t lo = (size + 1) / 2;
+    size_t hi = size - lo;
+    Bits a0(a.end() - lo, a.end()), a1(a.begin(), a.begin() + hi);
+    Bits b0(b.end() - lo, b.end()), b1(b.begin(), b.begin() + hi);
+
+    Bits z0 = karatsuba_full_mul_helper(a0, b0);
+    Bits z2 = karatsuba_full_mul_helper(a1, b1);
+    Bits sa = add_helper(resize_shl(a0, 0, lo + 1), resize_shl(a1, 0, lo + 1));
+    Bits sb = add_helper(resize_shl(b0, 0, lo + 1), resize_shl(b1, 0, lo + 1));
+    Bits z1 = karatsuba_full_mul_helper(sa, sb);
+    // a - b = ~(~a + b)
+    z1 = bv_not(add_helper(bv_not(z1), resize_shl(z0, 0, z1.size())));
+    z1 = bv_not(add_helper(bv_not(z1), resize_shl(z2, 0, z1.size())));
+
+    Bits res = add_helper(resize_shl(z0, 0, 2 * size),
+                          resize_shl(z1, lo, 2 * size));
+    return add_helper(res, resize_shl(z2, 2 * lo, 2 * size));
+  }
+
+  /**
+   * Sum up the bits of the given columns, where column i holds bits of weight
+   * 2^i. Columns are reduced with a Wallace tree of full adders until each
+   * column holds at most two bits, the remaining two rows are summed up with a
+   * ripple-carry adder. Carries out of the last column are discarded.
+   *
+   * @return The sum of size `columns.size()`.
+   */
+  Bits compress_columns(std::vector<Bits>& columns)
+  {
+    size_t size = columns.size();
+    T false_bit = d_bit_mgr.mk_false();
+
+    for (auto& col : columns)
+    {
+      col.erase(std::remove(col.begin(), col.end(), false_bit), col.end());
+    }
+
+    bool reduce = true;
+    while (reduce)
+    {
+      reduce = false;
+      std::vector<Bits> next(size);
+      for (size_t i = 0; i < size; ++i)
+      {
+        const Bits& col = columns[i];
+        size_t j        = 0;
+        if (col.size() > 2)
+        {
+          for (; j + 2 < col.size(); j += 3)
+          {
+            auto [sum, cout] = full_adder(col[j], col[j + 1], col[j + 2]);
+            next[i].push_back(sum);
+            if (i + 1 < size)
+            {
+              next[i + 1].push_back(cout);
+            }
+          }
+        }
+        next[i].insert(next[i].end(), col.begin() + j, col.end());
+      }
+      for (const auto& col : next)
+      {
+        reduce = reduce || col.size() > 2;
+      }
+      columns = std::move(next);
+    }
+
+    Bits a(size, false_bit), b(size, false_bit);
+    for (size_t i = 0, j = size - 1; i < size; ++i, --j)
+    {
+      if (columns[i].size() > 0)
+      {
+        a[j] = columns[i][0];
+      }
+      if (columns[i].size() > 1)
+      {
+        b[j] = columns[i][1];
+      }
+    }
+    return add_helper(a, b);
+  }
+
+  /**
+   * @return `a` shifted left by `shift`, zero-extended or truncated to size
+   *         `size`.
+   */
+  Bits resize_shl(const Bits& a, size_t shift, size_t size)
+  {
+    Bits res(size, d_bit_mgr.mk_false());
+    for (size_t i = 0; i < a.size() && i + shift < size; ++i)
+    {
+      res[size - 1 - (i + shift)] = a[a.size() - 1 - i];
+    }
+    return res;
+  }
+
   T ult_helper(const Bits& a, const Bits& b)
   {
     size_t lsb = a.size() - 1;
@@ -657,6 +943,112 @@ class BitblasterInterface
     Bits r(rem.rbegin(), rem.rend() - 1);
     return std::make_pair(quot, r);
   }
+
+  /**
+   * Encode non-restoring divider circuit.
+   *
+   * In contrast to the restoring divider, the partial remainder is allowed to
+   * become negative. In each row, the divisor is subtracted from the shifted
+   * remainder if the remainder is non-negative and added otherwise, which
+   * requires one adder/subtractor per row but no multiplexer for restoring
+   * the remainder. The quotient bit is 1 if the new remainder is
+   * non-negative. A negative final remainder is corrected by adding the
+   * divisor once.
+   *
+   * The remainder is kept in size + 2 bits (two's complement) since it is in
+   * [-2b, 2b) after shifting. For b = 0, the remainder never becomes negative,
+   * the quotient is thus ~0 and the remainder is a, as required.
+   *
+   * Returns a pair of bits consisting of the quotient and remainder of the
+   * division operation.
+   */
+  std::pair<Bits, Bits> udiv_urem_non_restoring_helper(const Bits& a,
+                                                       const Bits& b)
+  {
+    size_t size  = a.size();
+    size_t rsize = size + 2;
+    T false_bit  = d_bit_mgr.mk_false();
+
+    // Note: Bits of remainder and divisor are reversed to have lsb at
+    //       position 0.
+    Bits d(rsize, false_bit), rem(rsize, false_bit), quot;
+    for (size_t i = 0; i < size; ++i)
+    {
+      d[i] = b[size - 1 - i];
+    }
+    quot.reserve(size);
+
+    T sign = false_bit;
+    for (size_t i = 0; i < size; ++i)
+    {
+      // rem = 2 * rem + a[i]
+      rem.pop_back();
+      rem.insert(rem.begin(), a[i]);
+
+      // sign = 0: rem = rem - d = rem + ~d + 1
+      // sign = 1: rem = rem + d
+      T sub   = d_bit_mgr.mk_not(sign);
+      T carry = sub;
+      for (size_t j = 0; j < rsize; ++j)
+      {
+        std::tie(rem[j], carry) = full_adder(rem[j], mk_xor(d[j], sub), carry);
+      }
+      sign = rem[rsize - 1];
+      quot.push_back(d_bit_mgr.mk_not(sign));
+    }
+
+    // Correct negative remainder: rem = rem + d
+    T carry = false_bit;
+    for (size_t j = 0; j < size; ++j)
+    {
+      std::tie(rem[j], carry) =
+          full_adder(rem[j], d_bit_mgr.mk_and(sign, d[j]), carry);
+    }
+
+    Bits r(rem.rend() - size, rem.rend());
+    return std::make_pair(quot, r);
+  }
+
+  /**
+   * Encode division via the multiplier circuit.
+   *
+   * Creates fresh bits for quotient `q` and remainder `r` and records the
+   * side constraint
+   *
+   *   b = 0 => q = ~0 /\ r = a
+   *   b != 0 => a = q * b + r /\ r < b
+   *
+   * where q * b + r is computed with 2 * size bits (and can not overflow).
+   *
+   * Returns a pair of bits consisting of the quotient and remainder of the
+   * division operation.
+   */
+  std::pair<Bits, Bits> udiv_urem_mul_helper(const Bits& a, const Bits& b)
+  {
+    size_t size = a.size();
+    Bits q      = bv_constant(size);
+    Bits r      = bv_constant(size);
+
+    T b_zero = d_bit_mgr.mk_true();
+    for (const T& bit : b)
+    {
+      b_zero = d_bit_mgr.mk_and(b_zero, d_bit_mgr.mk_not(bit));
+    }
+    T ones = d_bit_mgr.mk_true();
+    for (const T& bit : q)
+    {
+      ones = d_bit_mgr.mk_and(ones, bit);
+    }
+    T div_zero = d_bit_mgr.mk_and(ones, bv_eq(r, a)[0]);
+
+    Bits prod = bv_mul(resize_shl(q, 0, 2 * size), resize_shl(b, 0, 2 * size));
+    Bits sum  = add_helper(prod, resize_shl(r, 0, 2 * size));
+    T div     = d_bit_mgr.mk_and(bv_eq(sum, resize_shl(a, 0, 2 * size))[0],
+                             ult_helper(r, b));
+
+    d_side_constraints.push_back(d_bit_mgr.mk_ite(b_zero, div_zero, div));
+    return std::make_pair(q, r);
+  }
 };
 
 }  // namespace bzla::bitblast
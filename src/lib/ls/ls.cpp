@@ -479,18 +479,14 @@ LocalSearch<VALUE>::update_unsat_roots(Node<VALUE>* root)
   assert(root->is_root());
 
   uint64_t id = root->id();
-  auto it     = d_roots_unsat.find(id);
-  if (it != d_roots_unsat.end())
+  if (root->assignment().is_true())
   {
-    if (root->assignment().is_true())
-    {
-      /* remove from unsatisfied roots list */
-      d_roots_unsat.erase(it);
-    }
+    /* remove from unsatisfied roots list (no-op if not contained) */
+    d_roots_unsat.erase(id);
   }
-  else if (root->assignment().is_false())
+  else
   {
-    /* add to unsatisfied roots list */
+    /* add to unsatisfied roots list (no-op if already contained) */
     d_roots_unsat.insert(id);
   }
 }
@@ -531,6 +527,180 @@ LocalSearch<VALUE>::normalize_ids()
   } while (!visit.empty());
 }
 
+template <class VALUE>
+typename LocalSearch<VALUE>::ParentsRange
+LocalSearch<VALUE>::parents(uint64_t id)
+{
+  if (d_parents_dirty)
+  {
+    build_parents();
+  }
+  assert(id < d_parents_offsets.size());
+  const uint64_t* data = d_parents.data() + d_parents_offsets[id];
+  return ParentsRange(data, data + d_num_parents[id]);
+}
+
+template <class VALUE>
+void
+LocalSearch<VALUE>::add_parents(const Node<VALUE>* node)
+{
+  // The parents of all nodes are computed on the next rebuild.
+  if (d_parents_dirty)
+  {
+    return;
+  }
+
+  uint64_t id = node->id();
+  assert(id == d_parents_offsets.size());
+  d_parents_offsets.push_back(d_parents.size());
+  d_num_parents.push_back(0);
+  d_parents_capacity.push_back(0);
+
+  uint32_t level = 0;
+  for (uint32_t i = 0, n = node->arity(); i < n; ++i)
+  {
+    uint64_t child = (*node)[i]->id();
+    level          = std::max(level, d_levels[child] + 1);
+
+    // Only register each parent once per child.
+    uint64_t begin = d_parents_offsets[child];
+    uint32_t size  = d_num_parents[child];
+    if (size > 0 && d_parents[begin + size - 1] == id)
+    {
+      continue;
+    }
+    if (size == d_parents_capacity[child])
+    {
+      uint32_t capacity = std::max(2 * size, 2u);
+      if (begin + size == d_parents.size())
+      {
+        d_parents.resize(begin + capacity);
+      }
+      else
+      {
+        // Move the parents to the end, the previous slots are not reused
+        // until the next rebuild.
+        uint64_t end = d_parents.size();
+        d_parents.resize(end + capacity);
+        std::copy(d_parents.begin() + begin,
+                  d_parents.begin() + begin + size,
+                  d_parents.begin() + end);
+        begin                    = end;
+        d_parents_offsets[child] = begin;
+      }
+      d_parents_capacity[child] = capacity;
+    }
+    d_parents[begin + size] = id;
+    d_num_parents[child]    = size + 1;
+  }
+
+  // Parents always have a higher level than their children, new nodes are
+  // thus only added above the existing levels of their cone.
+  d_levels.push_back(level);
+  if (level >= d_cone_buckets.size())
+  {
+    d_cone_buckets.resize(level + 1);
+  }
+  d_cone_queued.push_back(false);
+}
+
+template <class VALUE>
+void
+LocalSearch<VALUE>::build_parents()
+{
+  size_t nnodes = d_nodes.size();
+
+  /* Returns true if the child at index i occurs at a lower index, we only
+   * register each parent once per child. */
+  auto is_duplicate = [](const Node<VALUE>* node, uint32_t i) {
+    for (uint32_t j = 0; j < i; ++j)
+    {
+      if ((*node)[j] == (*node)[i]) return true;
+    }
+    return false;
+  };
+
+  /* count parents */
+  d_num_parents.assign(nnodes, 0);
+  for (const auto& node : d_nodes)
+  {
+    for (uint32_t i = 0, n = node->arity(); i < n; ++i)
+    {
+      if (!is_duplicate(node.get(), i))
+      {
+        d_num_parents[(*node)[i]->id()] += 1;
+      }
+    }
+  }
+  d_parents_offsets.resize(nnodes);
+  uint64_t offset = 0;
+  for (size_t i = 0; i < nnodes; ++i)
+  {
+    d_parents_offsets[i] = offset;
+    offset += d_num_parents[i];
+  }
+  d_parents_capacity = d_num_parents;
+
+  /* fill adjacency array */
+  d_parents.resize(offset);
+  std::vector<uint64_t> pos(d_parents_offsets);
+  for (const auto& node : d_nodes)
+  {
+    for (uint32_t i = 0, n = node->arity(); i < n; ++i)
+    {
+      if (!is_duplicate(node.get(), i))
+      {
+        d_parents[pos[(*node)[i]->id()]++] = node->id();
+      }
+    }
+  }
+
+  /* Compute levels. Node ids are not necessarily topologically ordered after
+   * normalization, thus we compute them via post-order traversal. */
+  constexpr uint32_t unknown = UINT32_MAX;
+  uint32_t max_level         = 0;
+  d_levels.assign(nnodes, unknown);
+  std::vector<Node<VALUE>*> visit;
+  for (const auto& node : d_nodes)
+  {
+    visit.push_back(node.get());
+    while (!visit.empty())
+    {
+      Node<VALUE>* cur = visit.back();
+      if (d_levels[cur->id()] != unknown)
+      {
+        visit.pop_back();
+        continue;
+      }
+      uint32_t level = 0;
+      bool ready     = true;
+      for (uint32_t i = 0, n = cur->arity(); i < n; ++i)
+      {
+        uint32_t l = d_levels[(*cur)[i]->id()];
+        if (l == unknown)
+        {
+          visit.push_back((*cur)[i]);
+          ready = false;
+        }
+        else if (ready)
+        {
+          level = std::max(level, l + 1);
+        }
+      }
+      if (ready)
+      {
+        d_levels[cur->id()] = level;
+        max_level           = std::max(max_level, level);
+        visit.pop_back();
+      }
+    }
+  }
+
+  d_cone_buckets.resize(max_level + 1);
+  d_cone_queued.assign(nnodes, false);
+  d_parents_dirty = false;
+}
+
 template <class VALUE>
 uint64_t
 LocalSearch<VALUE>::update_cone(Node<VALUE>* node, const VALUE& assignment)
@@ -556,64 +726,65 @@ LocalSearch<VALUE>::update_cone(Node<VALUE>* node, const VALUE& assignment)
   node->set_assignment(assignment);
   uint64_t nupdates = 1;
 
-  std::vector<Node<VALUE>*> cone;
-  std::vector<Node<VALUE>*> to_visit;
-  std::unordered_set<Node<VALUE>*> visited;
-
-  /* reset cone */
-  const std::unordered_set<uint64_t>& parents = d_parents.at(node->id());
-  for (uint64_t p : parents)
-  {
-    to_visit.push_back(get_node(p));
-  }
-
-  while (!to_visit.empty())
-  {
-    Node<VALUE>* cur = to_visit.back();
-    to_visit.pop_back();
-
-    if (visited.find(cur) != visited.end()) continue;
-    visited.insert(cur);
-    cone.push_back(cur);
-
-    const std::unordered_set<uint64_t>& parents = d_parents.at(cur->id());
-    for (uint64_t p : parents)
-    {
-      to_visit.push_back(get_node(p));
-    }
-  }
-
-  /* update assignments of cone */
   if (node->is_root())
   {
     update_unsat_roots(node);
   }
 
-  std::sort(
-      cone.begin(), cone.end(), [](const Node<VALUE>* a, const Node<VALUE>* b) {
-        return a->normalized_id() < b->normalized_id();
-      });
-
-  for (Node<VALUE>* cur : cone)
-  {
-    Log(2) << "  node: " << *cur;
-    cur->evaluate();
-    Log(2) << "      -> new assignment: " << cur->assignment();
-    nupdates += 1;
-    if (d_logger.is_log_enabled(2))
+  /* Queue parents of changed nodes, bucketed by level. Parents have a higher
+   * level than their children, thus processing buckets in ascending order
+   * guarantees that all children are up-to-date when a node is evaluated. */
+  uint64_t nqueued = 0;
+  auto enqueue     = [this, &nqueued](uint64_t id) {
+    for (uint64_t p : parents(id))
     {
-      for (const auto& s : cur->log())
+      if (!d_cone_queued[p])
       {
-        Log(2) << s;
+        d_cone_queued[p] = true;
+        d_cone_buckets[d_levels[p]].push_back(p);
+        nqueued += 1;
       }
     }
-    Log(2);
+  };
+  enqueue(node->id());
 
-    if (cur->is_root())
+  VALUE prev;
+  for (size_t level = d_levels[node->id()] + 1;
+       nqueued > 0 && level < d_cone_buckets.size();
+       ++level)
+  {
+    std::vector<uint64_t>& bucket = d_cone_buckets[level];
+    for (size_t i = 0; i < bucket.size(); ++i)
     {
-      update_unsat_roots(cur);
+      Node<VALUE>* cur = get_node(bucket[i]);
+      d_cone_queued[cur->id()] = false;
+      nqueued -= 1;
+
+      Log(2) << "  node: " << *cur;
+      prev = cur->assignment();
+      cur->evaluate();
+      Log(2) << "      -> new assignment: " << cur->assignment();
+      nupdates += 1;
+      if (d_logger.is_log_enabled(2))
+      {
+        for (const auto& s : cur->log())
+        {
+          Log(2) << s;
+        }
+      }
+      Log(2);
+
+      if (cur->assignment().compare(prev) == 0) continue;
+
+      if (cur->is_root())
+      {
+        update_unsat_roots(cur);
+      }
+      enqueue(cur->id());
     }
+    bucket.clear();
   }
+  assert(nqueued == 0);
 #ifndef NDEBUG
   for (uint64_t id : d_roots_unsat)
   {
@@ -646,7 +817,7 @@ LocalSearch<VALUE>::move()
     Log(1) << "    satisfied roots:";
     for (uint64_t id : d_roots)
     {
-      if (d_roots_unsat.find(id) != d_roots_unsat.end()) continue;
+      if (d_roots_unsat.contains(id)) continue;
       Log(1) << "      + " << *get_node(id);
     }
   }
@@ -666,7 +837,7 @@ LocalSearch<VALUE>::move()
     }
 
     Node<VALUE>* root =
-        get_node(d_rng->pick_from_set<std::unordered_set<uint64_t>, uint64_t>(
+        get_node(d_rng->pick_from_set<IndexedSet<uint64_t>, uint64_t>(
             d_roots_unsat));
 
     if (root->is_value_false())
@@ -18,9 +18,9 @@
 #include <unordered_set>
 #include <vector>
 
-namespace bzla {
+#include "rng/rng.h"
 
-class RNG;
+namespace bzla {
 
 namespace util {
 class Statistics;
@@ -107,8 +107,24 @@ class LocalSearch
 {
  public:
   using NodesIdTable = std::vector<std::unique_ptr<Node<VALUE>>>;
-  using ParentsSet   = std::unordered_set<uint64_t>;
-  using ParentsMap   = std::unordered_map<uint64_t, ParentsSet>;
+
+  /** A range over the parent ids of a node in the parents adjacency array. */
+  class ParentsRange
+  {
+   public:
+    ParentsRange(const uint64_t* begin, const uint64_t* end)
+        : d_begin(begin), d_end(end)
+    {
+    }
+    const uint64_t* begin() const { return d_begin; }
+    const uint64_t* end() const { return d_end; }
+    size_t size() const { return d_end - d_begin; }
+    bool empty() const { return d_begin == d_end; }
+
+   private:
+    const uint64_t* d_begin;
+    const uint64_t* d_end;
+  };
 
   struct Statistics
   {
@@ -206,7 +222,8 @@ class LocalSearch
   /**
    * Initialize local search module.
    * Must be called after all options are configured and before nodes are
-   * created.
+   * created. Must further be called on the thread that performs moves if
+   * this is not the thread that created the local search module.
    */
   void init();
 
@@ -357,6 +374,33 @@ class LocalSearch
    * @param root The root to update.
    */
   void update_unsat_roots(Node<VALUE>* root);
+  /**
+   * Get the parents of the node given by id.
+   *
+   * Rebuilds the parents adjacency array (and the node levels) if nodes have
+   * been normalized since it was last built.
+   *
+   * @param id The id of the node to query.
+   * @return The range of (unique) parent ids of the node.
+   */
+  ParentsRange parents(uint64_t id);
+  /**
+   * Register a newly created node in the parents adjacency array, i.e., add
+   * it as parent of its children, and compute its level. Must be called
+   * whenever a node is created.
+   * @param node The new node, must have the highest id of all nodes.
+   */
+  void add_parents(const Node<VALUE>* node);
+  /**
+   * Mark the parents adjacency array as outdated. Must be called whenever
+   * the children of existing nodes are modified.
+   */
+  void invalidate_parents() { d_parents_dirty = true; }
+  /**
+   * Rebuild the parents adjacency array and the node levels from the children
+   * of all nodes.
+   */
+  void build_parents();
   /**
    * Recompute normalized node ids.
    *
@@ -381,7 +425,10 @@ class LocalSearch
   virtual void compute_bounds(Node<VALUE>* node) = 0;
   /**
    * Update the assignment of the given node to the given assignment, and
-   * recompute the assignment of all nodes in its cone of influence
+   * recompute the assignment of all nodes in its cone of influence.
+   *
+   * Nodes are updated in level order, and a node is only re-evaluated if the
+   * assignment of at least one of its children changed.
    *
    * @param node The node to update.
    * @param assignment The new assignment of the given node.
@@ -424,8 +471,11 @@ class LocalSearch
    */
   std::unordered_map<uint64_t, uint64_t> d_roots_cnt;
 
-  /** The set of unsatisfied roots. */
-  std::unordered_set<uint64_t> d_roots_unsat;
+  /**
+   * The set of unsatisfied roots. Supports constant time random picking of
+   * an unsatisfied root in move().
+   */
+  IndexedSet<uint64_t> d_roots_unsat;
   /** Root responsible for unsat result. */
   uint64_t d_false_root;
 
@@ -439,8 +489,36 @@ class LocalSearch
    */
   std::unordered_map<const Node<VALUE>*, bool> d_roots_ineq;
 
-  /** Map nodes to their parent nodes. */
-  ParentsMap d_parents;
+  /**
+   * The parents of all nodes, stored contiguously per node. The parent ids
+   * of the node with id `i` are stored in the `d_num_parents[i]` slots
+   * starting at `d_parents[d_parents_offsets[i]]`.
+   *
+   * Built in compressed sparse row format by build_parents(). Parents of new
+   * nodes are appended by add_parents(), which moves the parents of a node to
+   * the end of d_parents (with doubled capacity) if they do not fit.
+   */
+  std::vector<uint64_t> d_parents;
+  /** The start offsets of the parents of each node in d_parents. */
+  std::vector<uint64_t> d_parents_offsets;
+  /** The number of parents of each node. */
+  std::vector<uint32_t> d_num_parents;
+  /** The number of reserved parent slots of each node in d_parents. */
+  std::vector<uint32_t> d_parents_capacity;
+  /**
+   * The level of each node, i.e., the length of the longest path to a leaf.
+   * Parents always have a higher level than their children.
+   */
+  std::vector<uint32_t> d_levels;
+  /** True if d_parents and d_levels need to be rebuilt. */
+  bool d_parents_dirty = true;
+  /**
+   * The nodes to be updated during a cone update, bucketed by level.
+   * Cached to avoid reallocation on every move.
+   */
+  std::vector<std::vector<uint64_t>> d_cone_buckets;
+  /** True for nodes that are currently queued in d_cone_buckets. */
+  std::vector<bool> d_cone_queued;
 
   /** The target value for each root. */
   std::unique_ptr<VALUE> d_true;
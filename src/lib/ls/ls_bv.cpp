@@ -78,8 +78,7 @@ LocalSearchBV::mk_node(const BitVector& assignment,
   res->set_symbol(symbol);
   d_nodes.push_back(std::move(res));
   assert(get_node(id) == d_nodes.back().get());
-  assert(d_parents.find(id) == d_parents.end());
-  d_parents[id] = {};
+  add_parents(d_nodes.back().get());
   return id;
 }
 
@@ -129,12 +128,12 @@ LocalSearchBV::_mk_node(NodeKind kind,
                         const std::optional<std::string>& symbol)
 {
   uint64_t id = d_nodes.size();
+#ifndef NDEBUG
   for (uint64_t c : children)
   {
     assert(c < id);  // API check
-    assert(d_parents.find(c) != d_parents.end());
-    d_parents.at(c).insert(id);
   }
+#endif
 
   std::unique_ptr<BitVectorNode> res;
 
@@ -276,8 +275,7 @@ LocalSearchBV::_mk_node(NodeKind kind,
   res->set_symbol(symbol);
   d_nodes.push_back(std::move(res));
   assert(get_node(id) == d_nodes.back().get());
-  assert(d_parents.find(id) == d_parents.end());
-  d_parents[id] = {};
+  add_parents(d_nodes.back().get());
 
   return id;
 }
@@ -397,9 +395,8 @@ LocalSearchBV::compute_bounds(Node<BitVector>* node)
   }
   for (uint32_t i = 0, arity = node->arity(); i < arity; ++i)
   {
-    const BitVectorNode* child                  = n->child(i);
-    const std::unordered_set<uint64_t>& parents = d_parents.at(child->id());
-    for (uint64_t pid : parents)
+    const BitVectorNode* child = n->child(i);
+    for (uint64_t pid : parents(child->id()))
     {
       BitVectorNode* p = get_node(pid);
 #ifndef NDEBUG
@@ -590,15 +587,12 @@ LocalSearchBV::normalize_extracts(BitVectorNode* node)
     }
     if (normalized)
     {
-      uint64_t id = normalized->id();
-      assert(d_parents[id].empty());
       // The normalized node is uniquely created for each normalized child1
-      // of an extract, thus only that extract is its parent.
-      d_parents[id] = {ex->id()};
-      // Remove this extract from the parents list of the normalized child
-      assert(!d_parents[ex->child(0)->id()].empty());
-      d_parents[ex->child(0)->id()].erase(ex->id());
+      // of an extract, thus only that extract is its parent. The extract is
+      // removed from the parents of its original child when the parents are
+      // rebuilt.
       ex->normalize(normalized);
+      invalidate_parents();
     }
   }
 }
@@ -32,13 +32,15 @@ class Node
    * Path selection mode.
    * True if path is to be selected based on essential inputs, false if it is
    * to be selected randomly.
+   * @note Thread local to allow running differently configured local search
+   *       instances in parallel (see LocalSearch::init()).
    */
-  static inline bool s_path_sel_essential = true;
+  static inline thread_local bool s_path_sel_essential = true;
   /**
    * Probability for picking an essential input if there is one, and else
    * a random input (see use_path_sel_essential).
    */
-  static inline uint32_t s_prob_pick_ess_input = 990;
+  static inline thread_local uint32_t s_prob_pick_ess_input = 990;
 
   /** Destructor. */
   virtual ~Node();
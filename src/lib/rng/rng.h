@@ -17,6 +17,8 @@
 #include <cstdint>
 #include <memory>
 #include <random>
+#include <unordered_map>
+#include <vector>
 
 namespace bzla {
 
@@ -94,7 +96,12 @@ class RNG
   /** Pick one out of five choices. */
   Choice pick_one_of_five();
 
-  /** Pick random element from given set/vector. */
+  /**
+   * Pick random element from given set/vector.
+   * @note This is linear in the size of the set if the set does not provide
+   *       random access iterators. Use IndexedSet for sets that are
+   *       frequently picked from.
+   */
   template <typename TSet, typename TPicked>
   TPicked pick_from_set(const TSet& data);
 
@@ -110,6 +117,86 @@ class RNG
   gmp_randstate_t d_gmp_randstate;
 };
 
+/**
+ * A set of unique elements that supports insertion, removal and uniform
+ * random picking (via RNG::pick_from_set()) in constant time.
+ *
+ * Elements are stored densely in a vector, and a map from elements to their
+ * position in the vector allows to remove an element by swapping it with the
+ * last element. The order of the elements is thus not stable under erase().
+ */
+template <typename T, typename Hash = std::hash<T>>
+class IndexedSet
+{
+ public:
+  using const_iterator = typename std::vector<T>::const_iterator;
+
+  /**
+   * Insert element.
+   * @param value The element to insert.
+   * @return True if the element was not yet contained in the set.
+   */
+  bool insert(const T& value)
+  {
+    auto [it, inserted] = d_index.emplace(value, d_data.size());
+    if (inserted)
+    {
+      d_data.push_back(value);
+    }
+    return inserted;
+  }
+
+  /**
+   * Remove element.
+   * @param value The element to remove.
+   * @return True if the element was contained in the set.
+   */
+  bool erase(const T& value)
+  {
+    auto it = d_index.find(value);
+    if (it == d_index.end())
+    {
+      return false;
+    }
+    size_t pos = it->second;
+    d_index.erase(it);
+    if (pos + 1 < d_data.size())
+    {
+      d_data[pos]             = std::move(d_data.back());
+      d_index.at(d_data[pos]) = pos;
+    }
+    d_data.pop_back();
+    return true;
+  }
+
+  /** @return True if given element is contained in the set. */
+  bool contains(const T& value) const
+  {
+    return d_index.find(value) != d_index.end();
+  }
+
+  /** Remove all elements. */
+  void clear()
+  {
+    d_data.clear();
+    d_index.clear();
+  }
+
+  /** @return The number of elements in the set. */
+  size_t size() const { return d_data.size(); }
+  /** @return True if the set is empty. */
+  bool empty() const { return d_data.empty(); }
+
+  const_iterator begin() const { return d_data.begin(); }
+  const_iterator end() const { return d_data.end(); }
+
+ private:
+  /** The elements of the set. */
+  std::vector<T> d_data;
+  /** Map element to its position in d_data. */
+  std::unordered_map<T, size_t, Hash> d_index;
+};
+
 template <typename TSet, typename TPicked>
 TPicked
 RNG::pick_from_set(const TSet& set)
@@ -139,7 +139,11 @@ print_help()
   opts.emplace_back(format_shortb("p"),
                     format_longb("print-formula"),
                     "",
-                    "print formula in smt2 format");
+                    "print formula in the configured print format");
+  opts.emplace_back("",
+                    format_longm("print-format"),
+                    format_dflt(dflt_opts.print_format),
+                    "output format for printing the formula {smt2, binary}");
   opts.emplace_back("",
                     format_longb("print-unsat-core"),
                     "",
@@ -159,7 +163,7 @@ print_help()
   opts.emplace_back("",
                     format_longm("lang"),
                     format_dflt(dflt_opts.language),
-                    "input language {smt2, btor2}");
+                    "input language {smt2, btor2, binary}");
 
   // Format library options
   bitwuzla::Options options;
@@ -381,13 +385,23 @@ parse_options(int32_t argc, char* argv[], std::vector<std::string>& args)
     {
       opts.time_limit = parse_arg_uint64_t(argc, i, argv);
     }
+    else if (check_opt_value(arg, "", "--print-format"))
+    {
+      auto [opt, val] = parse_arg_val(argc, i, argv);
+      if (val != "smt2" && val != "binary")
+      {
+        Error() << "invalid print format given `" << val << "`, expected "
+                << "'smt2' or 'binary'";
+      }
+      opts.print_format = val;
+    }
     else if (check_opt_value(arg, "", "--lang"))
     {
       auto [opt, val] = parse_arg_val(argc, i, argv);
-      if (val != "smt2" && val != "btor2")
+      if (val != "smt2" && val != "btor2" && val != "binary")
       {
         Error() << "invalid input language given `" << val << "`, expected "
-                << "'smt2' or 'btor2'";
+                << "'smt2', 'btor2' or 'binary'";
       }
       opts.language = val;
       lang_forced   = true;
@@ -452,6 +466,10 @@ parse_options(int32_t argc, char* argv[], std::vector<std::string>& args)
     {
       opts.language = "btor2";
     }
+    else if (is_input_file(opts.infile_name, ".bzlb"))
+    {
+      opts.language = "binary";
+    }
     else
     {
       opts.language = "smt2";
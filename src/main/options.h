@@ -19,13 +19,14 @@ namespace bzla::main {
 
 struct Options
 {
-  bool print              = false;
-  bool print_unsat_core   = false;
-  bool parse_only         = false;
-  uint8_t bv_format       = 2;
-  uint64_t time_limit     = 0;
-  std::string infile_name = "<stdin>";
-  std::string language    = "smt2";
+  bool print               = false;
+  bool print_unsat_core    = false;
+  bool parse_only          = false;
+  uint8_t bv_format        = 2;
+  uint64_t time_limit      = 0;
+  std::string infile_name  = "<stdin>";
+  std::string language     = "smt2";
+  std::string print_format = "smt2";
 };
 
 /**
@@ -13,54 +13,34 @@
 #include "node/node.h"
 #include "node/node_manager.h"
 #include "solver/fp/floating_point.h"
+#include "solver/fp/rounding_mode.h"
 
 namespace bzla::node {
 
 /* --- NodeData public ----------------------------------------------------- */
 
 NodeData*
-NodeData::alloc(Kind kind, const std::optional<std::string>& symbol)
+NodeData::alloc(NodeDataAllocator& allocator,
+                Kind kind,
+                const std::optional<std::string>& symbol)
 {
-  size_t size = sizeof(NodeData) + sizeof(PayloadSymbol);
-
-  NodeData* data = static_cast<NodeData*>(std::calloc(1, size));
-  if (data == nullptr)
-  {
-    throw std::bad_alloc();
-  }
-  data->d_kind     = kind;
-  auto& payload    = data->payload_symbol();
-  payload.d_symbol = symbol;
+  size_t size    = sizeof(NodeData) + sizeof(PayloadSymbol);
+  NodeData* data = static_cast<NodeData*>(allocator.allocate(size));
+  data->d_kind   = kind;
+  auto& payload  = data->payload_symbol();
+  new (&payload.d_symbol) std::optional<std::string>(symbol);
   return data;
 }
 
 NodeData*
-NodeData::alloc(Kind kind,
+NodeData::alloc(NodeDataAllocator& allocator,
+                Kind kind,
                 const std::vector<Node>& children,
                 const std::vector<uint64_t>& indices)
 {
-  size_t size         = sizeof(NodeData);
-  size_t payload_size = 0;
-
-  if (!children.empty())
-  {
-    payload_size += sizeof(PayloadChildren);
-    payload_size +=
-        sizeof(PayloadChildren::d_children[0]) * (children.size() - 1);
-  }
-
-  if (!indices.empty())
-  {
-    payload_size += sizeof(PayloadIndexed);
-    payload_size += sizeof(PayloadIndexed::d_indices[0]) * (indices.size() - 1);
-  }
-
-  NodeData* data = static_cast<NodeData*>(std::calloc(1, size + payload_size));
-  if (data == nullptr)
-  {
-    throw std::bad_alloc();
-  }
-  data->d_kind = kind;
+  size_t size    = alloc_size(children.size(), indices.size());
+  NodeData* data = static_cast<NodeData*>(allocator.allocate(size));
+  data->d_kind   = kind;
 
   // Connect children payload
   if (!children.empty())
@@ -91,10 +71,12 @@ NodeData::alloc(Kind kind,
 }
 
 void
-NodeData::dealloc(NodeData* data)
+NodeData::dealloc(NodeDataAllocator& allocator, NodeData* data)
 {
+  // Note: Size must be computed before the payload is destructed.
+  size_t size = data->alloc_size();
   data->~NodeData();
-  std::free(data);
+  allocator.deallocate(data, size);
 }
 
 NodeData::~NodeData()
@@ -120,7 +102,7 @@ NodeData::~NodeData()
       payload.d_value.~FloatingPoint();
     }
   }
-  else if (d_kind == Kind::CONSTANT || d_kind == Kind::VALUE)
+  else if (d_kind == Kind::CONSTANT || d_kind == Kind::VARIABLE)
   {
     auto& payload = payload_symbol();
     payload.d_symbol.~optional();
@@ -216,10 +198,60 @@ NodeData::end() const
   return nullptr;
 }
 
+size_t
+NodeData::alloc_size(size_t num_children, size_t num_indices)
+{
+  size_t size = sizeof(NodeData);
+  if (num_children > 0)
+  {
+    size += sizeof(PayloadChildren);
+    size += sizeof(PayloadChildren::d_children[0]) * (num_children - 1);
+  }
+  if (num_indices > 0)
+  {
+    size += sizeof(PayloadIndexed);
+    size += sizeof(PayloadIndexed::d_indices[0]) * (num_indices - 1);
+  }
+  return size;
+}
+
+size_t
+NodeData::alloc_size() const
+{
+  if (d_kind == Kind::CONSTANT || d_kind == Kind::VARIABLE)
+  {
+    return sizeof(NodeData) + sizeof(PayloadSymbol);
+  }
+  if (d_kind == Kind::VALUE)
+  {
+    if (d_type.is_bool())
+    {
+      return alloc_size_value<bool>();
+    }
+    if (d_type.is_bv())
+    {
+      return alloc_size_value<BitVector>();
+    }
+    if (d_type.is_rm())
+    {
+      return alloc_size_value<RoundingMode>();
+    }
+    assert(d_type.is_fp());
+    return alloc_size_value<FloatingPoint>();
+  }
+  return alloc_size(get_num_children(), get_num_indices());
+}
+
 void
 NodeData::gc()
 {
   d_nm->garbage_collect(this);
 }
 
+void
+NodeData::retire()
+{
+  d_nm->retire(this);
+}
+
 }  // namespace bzla::node
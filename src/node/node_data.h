@@ -20,6 +20,7 @@
 #include "bv/bitvector.h"
 #include "node/kind_info.h"
 #include "node/node.h"
+#include "node/node_data_allocator.h"
 #include "type/type.h"
 
 namespace bzla::node {
@@ -65,26 +66,22 @@ class NodeData
   using iterator = const Node*;
 
   /** Allocate node data for constants and variables. */
-  static NodeData* alloc(Kind kind, const std::optional<std::string>& symbol);
+  static NodeData* alloc(NodeDataAllocator& allocator,
+                         Kind kind,
+                         const std::optional<std::string>& symbol);
 
   /** Allocate node data for nodes with children. */
-  static NodeData* alloc(Kind kind,
+  static NodeData* alloc(NodeDataAllocator& allocator,
+                         Kind kind,
                          const std::vector<Node>& children,
                          const std::vector<uint64_t>& indices);
 
   /** Allocate node data for values. */
   template <class T>
-  static NodeData* alloc(const T& value)
+  static NodeData* alloc(NodeDataAllocator& allocator, const T& value)
   {
-    size_t size         = sizeof(NodeData);
-    size_t payload_size = sizeof(PayloadValue<T>);
-
     NodeData* data =
-        static_cast<NodeData*>(std::calloc(1, size + payload_size));
-    if (data == nullptr)
-    {
-      throw std::bad_alloc();
-    }
+        static_cast<NodeData*>(allocator.allocate(alloc_size_value<T>()));
     data->d_kind = Kind::VALUE;
 
     auto& payload   = data->payload_value<T>();
@@ -93,7 +90,7 @@ class NodeData
   }
 
   /** Deallocate node data. */
-  static void dealloc(NodeData* data);
+  static void dealloc(NodeDataAllocator& allocator, NodeData* data);
 
   NodeData() = delete;
   ~NodeData();
@@ -185,16 +182,37 @@ class NodeData
   std::optional<std::reference_wrapper<const std::string>> get_symbol() const;
 
   /** Increase the reference count by one. */
-  void inc_ref() { ++d_refs; }
+  void inc_ref()
+  {
+    if (d_concurrent)
+    {
+      __atomic_add_fetch(&d_refs, 1, __ATOMIC_RELAXED);
+    }
+    else
+    {
+      ++d_refs;
+    }
+  }
 
   /**
    * Decrease the reference count by one.
    *
    * If reference count becomes zero, this node data object will be
-   * automatically garbage collected.
+   * automatically garbage collected. In concurrent mode, garbage collection
+   * is deferred (see NodeManager::enable_concurrency()).
    */
   void dec_ref()
   {
+    if (d_concurrent)
+    {
+      uint32_t refs = __atomic_sub_fetch(&d_refs, 1, __ATOMIC_ACQ_REL);
+      assert(refs != UINT32_MAX);
+      if (refs == 0)
+      {
+        retire();
+      }
+      return;
+    }
     assert(d_refs > 0);
     --d_refs;
     if (d_refs == 0)
@@ -274,13 +292,27 @@ class NodeData
     return *reinterpret_cast<const PayloadSymbol*>(&d_payload);
   }
 
+  /** @return The number of bytes required for node data with children. */
+  static size_t alloc_size(size_t num_children, size_t num_indices);
+
+  /** @return The number of bytes required for value node data. */
+  template <class T>
+  static size_t alloc_size_value()
+  {
+    return sizeof(NodeData) + sizeof(PayloadValue<T>);
+  }
+
+  /** @return The number of bytes this node data was allocated with. */
+  size_t alloc_size() const;
+
   /** Garbage collect this node. */
   void gc();
 
+  /** Schedule this node for deferred garbage collection. */
+  void retire();
+
   /** Associated node manager. */
   NodeManager* d_nm = nullptr;
-  /** Next node in unique table collision chain. */
-  NodeData* d_next = nullptr;
   /** Node id. */
   uint64_t d_id = 0;
   /** Node type. */
@@ -289,6 +321,10 @@ class NodeData
   uint32_t d_refs = 0;
   /** Node kind. */
   Kind d_kind;
+  /** True if reference counting is done atomically. */
+  bool d_concurrent = false;
+  /** True if this node is scheduled for deferred garbage collection. */
+  bool d_retired = false;
 
   /**
    * Payload placeholder.
@@ -0,0 +1,140 @@
+/***
+ * Bitwuzla: Satisfiability Modulo Theories (SMT) solver.
+ *
+ * Copyright (C) 2024 by the authors listed in the AUTHORS file at
+ * https://github.com/bitwuzla/bitwuzla/blob/main/AUTHORS
+ *
+ * This file is part of Bitwuzla under the MIT license. See COPYING for more
+ * information at https://github.com/bitwuzla/bitwuzla/blob/main/COPYING
+ */
+
+#include "node/node_data_allocator.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+namespace bzla::node {
+
+/* --- NodeDataAllocator public -------------------------------------------- */
+
+NodeDataAllocator::~NodeDataAllocator()
+{
+  for (Slab* slab : d_slabs)
+  {
+    std::free(slab);
+  }
+  for (void* ptr : d_large)
+  {
+    std::free(ptr);
+  }
+}
+
+void*
+NodeDataAllocator::allocate(size_t size)
+{
+  std::unique_lock<std::mutex> lock(d_mutex, std::defer_lock);
+  if (d_thread_safe)
+  {
+    lock.lock();
+  }
+
+  if (size > s_max_slot_size)
+  {
+    void* ptr = std::calloc(1, size);
+    if (ptr == nullptr)
+    {
+      throw std::bad_alloc();
+    }
+    d_large.insert(ptr);
+    ++d_stats.d_num_large;
+    return ptr;
+  }
+
+  size_t sc = size_class(size);
+  void* ptr;
+  Slab* slab;
+  size_t idx;
+
+  // Reuse slot from free list if available.
+  if (d_free[sc] != nullptr)
+  {
+    FreeSlot* free = d_free[sc];
+    d_free[sc]     = free->d_next;
+    ptr            = free;
+    slab           = slab_of(ptr);
+    idx            = slot_index(slab, ptr);
+    std::memset(ptr, 0, slab->d_slot_size);
+    ++d_stats.d_num_reused;
+  }
+  // Bump allocate from current slab.
+  else
+  {
+    slab = d_cur_slab[sc];
+    if (slab == nullptr
+        || s_header_size + (slab->d_num_used + 1) * slab->d_slot_size
+               > s_slab_size)
+    {
+      slab           = new_slab(sc);
+      d_cur_slab[sc] = slab;
+    }
+    idx = slab->d_num_used++;
+    ptr = slab->data() + idx * slab->d_slot_size;
+  }
+  assert(!slab->is_live(idx));
+  slab->set_live(idx);
+  return ptr;
+}
+
+void
+NodeDataAllocator::deallocate(void* ptr, size_t size)
+{
+  assert(ptr != nullptr);
+  std::unique_lock<std::mutex> lock(d_mutex, std::defer_lock);
+  if (d_thread_safe)
+  {
+    lock.lock();
+  }
+
+  if (size > s_max_slot_size)
+  {
+    assert(d_large.find(ptr) != d_large.end());
+    d_large.erase(ptr);
+    --d_stats.d_num_large;
+    std::free(ptr);
+    return;
+  }
+
+  size_t sc  = size_class(size);
+  Slab* slab = slab_of(ptr);
+  size_t idx = slot_index(slab, ptr);
+  assert(slab->d_slot_size == (sc + 1) * s_granularity);
+  assert(slab->is_live(idx));
+  slab->clear_live(idx);
+
+  FreeSlot* free = static_cast<FreeSlot*>(ptr);
+  free->d_next   = d_free[sc];
+  d_free[sc]     = free;
+}
+
+/* --- NodeDataAllocator private ------------------------------------------- */
+
+NodeDataAllocator::Slab*
+NodeDataAllocator::new_slab(size_t size_class)
+{
+  void* mem = std::aligned_alloc(s_slab_size, s_slab_size);
+  if (mem == nullptr)
+  {
+    throw std::bad_alloc();
+  }
+  // Slot memory is zero-initialized on allocation.
+  std::memset(mem, 0, s_slab_size);
+  Slab* slab          = static_cast<Slab*>(mem);
+  slab->d_slot_size   = (size_class + 1) * s_granularity;
+  slab->d_num_used    = 0;
+  d_slabs.push_back(slab);
+  ++d_stats.d_num_slabs;
+  return slab;
+}
+
+}  // namespace bzla::node
@@ -0,0 +1,195 @@
+/***
+ * Bitwuzla: Satisfiability Modulo Theories (SMT) solver.
+ *
+ * Copyright (C) 2024 by the authors listed in the AUTHORS file at
+ * https://github.com/bitwuzla/bitwuzla/blob/main/AUTHORS
+ *
+ * This file is part of Bitwuzla under the MIT license. See COPYING for more
+ * information at https://github.com/bitwuzla/bitwuzla/blob/main/COPYING
+ */
+
+#ifndef BZLA_NODE_NODE_DATA_ALLOCATOR_H_INCLUDED
+#define BZLA_NODE_NODE_DATA_ALLOCATOR_H_INCLUDED
+
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <unordered_set>
+#include <vector>
+
+namespace bzla::node {
+
+/**
+ * Slab allocator for node data.
+ *
+ * Node data objects are allocated from fixed-size, aligned slabs that are
+ * split into equally sized slots. Each slab serves exactly one size class,
+ * where size classes are multiples of `s_granularity` bytes up to
+ * `s_max_slot_size`. Freed slots are kept in per size class free lists and
+ * reused by subsequent allocations. Blocks that exceed the maximum slot size
+ * (n-ary nodes with many children) are allocated individually.
+ *
+ * All memory is released in bulk when the allocator is destructed. The
+ * allocator does not know about the objects stored in its memory, hence the
+ * owner is responsible for destructing all live objects (see for_each())
+ * before the allocator is destructed.
+ */
+class NodeDataAllocator
+{
+ public:
+  /** Size of a slab in bytes. Slabs are aligned to this size. */
+  static constexpr size_t s_slab_size = 1 << 16;
+  /** Size class granularity in bytes. */
+  static constexpr size_t s_granularity = 16;
+  /** Maximum slot size, larger blocks are allocated individually. */
+  static constexpr size_t s_max_slot_size = 512;
+  /** The number of size classes. */
+  static constexpr size_t s_num_size_classes =
+      s_max_slot_size / s_granularity;
+
+  struct Statistics
+  {
+    /** The number of allocated slabs. */
+    uint64_t d_num_slabs = 0;
+    /** The number of currently allocated blocks > s_max_slot_size. */
+    uint64_t d_num_large = 0;
+    /** The number of allocations served from a free list. */
+    uint64_t d_num_reused = 0;
+  };
+
+  NodeDataAllocator() = default;
+  ~NodeDataAllocator();
+  NodeDataAllocator(const NodeDataAllocator&)            = delete;
+  NodeDataAllocator& operator=(const NodeDataAllocator&) = delete;
+
+  /**
+   * Allocate zero-initialized block of memory.
+   * @param size The size of the block in bytes.
+   * @return Pointer to the allocated block.
+   */
+  void* allocate(size_t size);
+
+  /**
+   * Return block of memory to the allocator.
+   * @param ptr  The block to deallocate.
+   * @param size The size of the block, must match the size it was allocated
+   *             with.
+   */
+  void deallocate(void* ptr, size_t size);
+
+  /**
+   * Apply given function to all currently allocated blocks.
+   *
+   * @note Blocks must not be allocated or deallocated while iterating.
+   *
+   * @param fun The function to apply, receives a `void*` to the block.
+   */
+  template <class Fun>
+  void for_each(Fun&& fun)
+  {
+    for (Slab* slab : d_slabs)
+    {
+      uint8_t* data = slab->data();
+      for (size_t i = 0; i < slab->d_num_used; ++i)
+      {
+        if (slab->is_live(i))
+        {
+          fun(static_cast<void*>(data + i * slab->d_slot_size));
+        }
+      }
+    }
+    for (void* ptr : d_large)
+    {
+      fun(ptr);
+    }
+  }
+
+  /**
+   * Guard allocations and deallocations with a mutex.
+   * @param thread_safe True to guard allocations and deallocations.
+   * @note Must be called while no other thread uses the allocator.
+   */
+  void set_thread_safe(bool thread_safe = true) { d_thread_safe = thread_safe; }
+
+  /** @return The allocator statistics. */
+  const Statistics& statistics() const { return d_stats; }
+
+ private:
+  /** Slab header, the slot memory is stored directly after the header. */
+  struct Slab
+  {
+    /** The size of the slots in this slab. */
+    uint32_t d_slot_size;
+    /** The number of slots handed out by bump allocation so far. */
+    uint32_t d_num_used;
+    /** Bitmap of live slots. */
+    std::array<uint64_t, s_slab_size / s_granularity / 64> d_live;
+
+    /** @return Pointer to the first slot. */
+    uint8_t* data()
+    {
+      return reinterpret_cast<uint8_t*>(this) + s_header_size;
+    }
+    bool is_live(size_t i) const
+    {
+      return (d_live[i / 64] >> (i % 64)) & 1;
+    }
+    void set_live(size_t i) { d_live[i / 64] |= uint64_t(1) << (i % 64); }
+    void clear_live(size_t i) { d_live[i / 64] &= ~(uint64_t(1) << (i % 64)); }
+  };
+
+  /** Free list entry, stored in the first bytes of a free slot. */
+  struct FreeSlot
+  {
+    FreeSlot* d_next;
+  };
+
+  /** Size of the slab header, padded to the size class granularity. */
+  static constexpr size_t s_header_size =
+      (sizeof(Slab) + s_granularity - 1) / s_granularity * s_granularity;
+
+  /** @return The size class index for a block of `size` bytes. */
+  static size_t size_class(size_t size)
+  {
+    assert(size > 0);
+    return (size - 1) / s_granularity;
+  }
+
+  /** @return The slab containing `ptr`. */
+  static Slab* slab_of(void* ptr)
+  {
+    return reinterpret_cast<Slab*>(reinterpret_cast<uintptr_t>(ptr)
+                                   & ~(uintptr_t(s_slab_size) - 1));
+  }
+
+  /** @return The slot index of `ptr` in `slab`. */
+  static size_t slot_index(Slab* slab, void* ptr)
+  {
+    return (static_cast<uint8_t*>(ptr) - slab->data()) / slab->d_slot_size;
+  }
+
+  /** Allocate new slab for given size class. */
+  Slab* new_slab(size_t size_class);
+
+  /** Free lists, one per size class. */
+  std::array<FreeSlot*, s_num_size_classes> d_free{};
+  /** The slab currently used for bump allocation, one per size class. */
+  std::array<Slab*, s_num_size_classes> d_cur_slab{};
+  /** All allocated slabs. */
+  std::vector<Slab*> d_slabs;
+  /** Blocks larger than s_max_slot_size. */
+  std::unordered_set<void*> d_large;
+
+  /** True if allocations are guarded by d_mutex. */
+  bool d_thread_safe = false;
+  /** Mutex guarding allocations if d_thread_safe is true. */
+  std::mutex d_mutex;
+
+  Statistics d_stats;
+};
+
+}  // namespace bzla::node
+
+#endif
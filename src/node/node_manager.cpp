@@ -24,18 +24,29 @@ using namespace node;
 
 /* --- NodeManager public -------------------------------------------------- */
 
+NodeManager::NodeManager() : d_unique_table(d_allocator) {}
+
 NodeManager::~NodeManager()
 {
-  // Cleanup remaining node data for constants and variables.
+  // Cleanup remaining node data.
   //
   // Note: Automatic reference counting of Node should actually prevent node
   //       data leaks. However, nodes that are stored in static memory do not
   //       get garbage collected. Hence, we have to make sure to invalidate all
-  //       node data before destructing the node manager.
-  for (NodeData* d : d_alloc_nodes)
-  {
-    NodeData::dealloc(d);
-  }
+  //       node data before destructing the node manager. The memory itself is
+  //       released in bulk by the allocator.
+  d_allocator.for_each([](void* ptr) {
+    NodeData* d = static_cast<NodeData*>(ptr);
+    if (d->has_children())
+    {
+      auto& payload = d->payload_children();
+      for (size_t i = 0; i < payload.d_num_children; ++i)
+      {
+        payload.d_children[i].d_data = nullptr;
+      }
+    }
+    d->~NodeData();
+  });
 }
 
 type::TypeManager*
@@ -44,15 +55,66 @@ NodeManager::tm()
   return &d_tm;
 }
 
+void
+NodeManager::enable_concurrency()
+{
+  if (d_concurrent)
+  {
+    return;
+  }
+  d_tm.enable_concurrency();
+  d_allocator.set_thread_safe();
+
+  // Distribute hash consed node data to shards.
+  d_shards.reserve(size_t(1) << s_log_num_shards);
+  for (size_t i = 0, n = size_t(1) << s_log_num_shards; i < n; ++i)
+  {
+    d_shards.emplace_back(new Shard(d_allocator));
+  }
+  d_unique_table.for_each([this](NodeData* d) {
+    shard(d_unique_table.hash(d)).d_table.insert(d);
+  });
+  d_unique_table.clear();
+
+  // Switch reference counting of existing node data to atomic.
+  d_allocator.for_each(
+      [](void* ptr) { static_cast<NodeData*>(ptr)->d_concurrent = true; });
+  d_concurrent = true;
+}
+
+void
+NodeManager::disable_concurrency()
+{
+  if (!d_concurrent)
+  {
+    return;
+  }
+  // Retired node data is garbage collected while reference counting is still
+  // atomic, afterwards all remaining node data is referenced.
+  reclaim();
+
+  for (auto& s : d_shards)
+  {
+    s->d_table.for_each([this](NodeData* d) { d_unique_table.insert(d); });
+    s->d_table.clear();
+  }
+  d_shards.clear();
+
+  d_allocator.for_each(
+      [](void* ptr) { static_cast<NodeData*>(ptr)->d_concurrent = false; });
+  d_allocator.set_thread_safe(false);
+  d_tm.disable_concurrency();
+  d_concurrent = false;
+}
+
 Node
 NodeManager::mk_const(const Type& t, const std::optional<std::string>& symbol)
 {
   assert(!t.is_null());
   assert(t.tm() == &d_tm);
-  NodeData* data = NodeData::alloc(Kind::CONSTANT, symbol);
+  NodeData* data = NodeData::alloc(d_allocator, Kind::CONSTANT, symbol);
   data->d_type   = t;
   init_id(data);
-  d_alloc_nodes.emplace(data);
   return Node(data);
 }
 
@@ -75,64 +137,36 @@ NodeManager::mk_var(const Type& t, const std::optional<std::string>& symbol)
 {
   assert(!t.is_null());
   assert(t.tm() == &d_tm);
-  NodeData* data = NodeData::alloc(Kind::VARIABLE, symbol);
+  NodeData* data = NodeData::alloc(d_allocator, Kind::VARIABLE, symbol);
   data->d_type   = t;
   init_id(data);
-  d_alloc_nodes.emplace(data);
   return Node(data);
 }
 
 Node
 NodeManager::mk_value(bool value)
 {
-  Type type             = mk_bool_type();
-  auto [inserted, data] = d_unique_table.find_or_insert(type, value);
-  if (inserted)
-  {
-    init_id(data);
-    data->d_type = std::move(type);
-  }
-  return Node(data);
+  return Node(find_or_insert_value(mk_bool_type(), value));
 }
 
 Node
 NodeManager::mk_value(const BitVector& value)
 {
-  Type type             = mk_bv_type(value.size());
-  auto [inserted, data] = d_unique_table.find_or_insert(type, value);
-  if (inserted)
-  {
-    init_id(data);
-    data->d_type = std::move(type);
-  }
-  return Node(data);
+  return Node(find_or_insert_value(mk_bv_type(value.size()), value));
 }
 
 Node
 NodeManager::mk_value(const RoundingMode value)
 {
-  Type type             = mk_rm_type();
-  auto [inserted, data] = d_unique_table.find_or_insert(type, value);
-  if (inserted)
-  {
-    init_id(data);
-    data->d_type = std::move(type);
-  }
-  return Node(data);
+  return Node(find_or_insert_value(mk_rm_type(), value));
 }
 
 Node
 NodeManager::mk_value(const FloatingPoint& value)
 {
-  Type type =
-      mk_fp_type(value.get_exponent_size(), value.get_significand_size());
-  auto [inserted, data] = d_unique_table.find_or_insert(type, value);
-  if (inserted)
-  {
-    init_id(data);
-    data->d_type = std::move(type);
-  }
-  return Node(data);
+  return Node(find_or_insert_value(
+      mk_fp_type(value.get_exponent_size(), value.get_significand_size()),
+      value));
 }
 
 Node
@@ -798,12 +832,45 @@ NodeManager::check_type(Kind kind,
 void
 NodeManager::init_id(NodeData* data)
 {
-  assert(d_node_id_counter < UINT64_MAX);
   assert(data != nullptr);
   assert(data->d_id == 0);
-  data->d_id = d_node_id_counter++;
   data->d_nm = this;
-  ++d_stats.d_num_node_data;
+  if (d_concurrent)
+  {
+    data->d_id = __atomic_fetch_add(&d_node_id_counter, 1, __ATOMIC_RELAXED);
+    assert(data->d_id < UINT64_MAX);
+    data->d_concurrent = true;
+    __atomic_add_fetch(&d_stats.d_num_node_data, 1, __ATOMIC_RELAXED);
+  }
+  else
+  {
+    assert(d_node_id_counter < UINT64_MAX);
+    data->d_id = d_node_id_counter++;
+    ++d_stats.d_num_node_data;
+  }
+}
+
+template <class T>
+NodeData*
+NodeManager::find_or_insert_value(const Type& type, const T& value)
+{
+  auto init = [&](std::pair<bool, NodeData*> res) {
+    auto [inserted, data] = res;
+    if (inserted)
+    {
+      init_id(data);
+      data->d_type = type;
+    }
+    return data;
+  };
+
+  if (d_concurrent)
+  {
+    Shard& s = shard(d_unique_table.hash_value(value));
+    std::lock_guard<std::mutex> lock(s.d_mutex);
+    return init(s.d_table.find_or_insert(type, value));
+  }
+  return init(d_unique_table.find_or_insert(type, value));
 }
 
 NodeData*
@@ -812,22 +879,33 @@ NodeManager::find_or_insert_node(node::Kind kind,
                                  const std::vector<Node>& children,
                                  const std::vector<uint64_t>& indices)
 {
-  auto [inserted, data] =
-      d_unique_table.find_or_insert(kind, type, children, indices);
-  if (inserted)
-  {
-    // Initialize new node
-    init_id(data);
-    if (type.is_null())
-    {
-      data->d_type = compute_type(kind, children, indices);
-    }
-    else
+  auto init = [&](std::pair<bool, NodeData*> res) {
+    auto [inserted, data] = res;
+    if (inserted)
     {
-      data->d_type = type;
+      // Initialize new node
+      init_id(data);
+      if (type.is_null())
+      {
+        data->d_type = compute_type(kind, children, indices);
+      }
+      else
+      {
+        data->d_type = type;
+      }
     }
+    return data;
+  };
+
+  if (d_concurrent)
+  {
+    // Note: Node data must be fully initialized before the shard is unlocked
+    //       since other threads may find it right after.
+    Shard& s = shard(d_unique_table.hash(kind, children, indices));
+    std::lock_guard<std::mutex> lock(s.d_mutex);
+    return init(s.d_table.find_or_insert(kind, type, children, indices));
   }
-  return data;
+  return init(d_unique_table.find_or_insert(kind, type, children, indices));
 }
 
 void
@@ -874,18 +952,131 @@ NodeManager::garbage_collect(NodeData* data)
         }
       }
     }
-    else if (kind == Kind::CONSTANT || kind == Kind::VARIABLE)
+    NodeData::dealloc(d_allocator, cur);
+    --d_stats.d_num_node_data;
+    ++d_stats.d_num_node_data_dealloc;
+  } while (!visit.empty());
+
+  d_in_gc_mode = false;
+}
+
+void
+NodeManager::retire(NodeData* data)
+{
+  assert(d_concurrent);
+  bool reclaim;
+  {
+    std::lock_guard<std::mutex> lock(d_retired_mutex);
+    if (!data->d_retired)
     {
-      d_alloc_nodes.erase(cur);
+      data->d_retired = true;
+      d_retired.push_back(data);
     }
-    NodeData::dealloc(cur);
+    reclaim = d_retired.size() >= s_reclaim_threshold;
+  }
+  if (reclaim)
+  {
+    try_reclaim();
+  }
+}
+
+namespace {
+/** The number of epoch guards held by the current thread. */
+thread_local size_t s_num_epoch_guards = 0;
+}  // namespace
+
+void
+NodeManager::try_reclaim()
+{
+  // Note: Reclaiming is not possible if the current thread is still within an
+  //       epoch (of any node manager).
+  if (s_num_epoch_guards == 0 && d_epoch_gate.try_lock())
+  {
+    reclaim();
+    d_epoch_gate.unlock();
+  }
+}
+
+void
+NodeManager::reclaim()
+{
+  assert(d_concurrent);
+  assert(!d_in_gc_mode);
+
+  d_in_gc_mode = true;
+
+  std::vector<NodeData*> visit;
+  {
+    std::lock_guard<std::mutex> lock(d_retired_mutex);
+    visit.swap(d_retired);
+  }
+
+  // Note: A node data object is contained at most once in `visit` (guarded by
+  //       d_retired). Retired node data may have been revived by a unique
+  //       table lookup since it was retired, which we skip.
+  for (size_t i = 0; i < visit.size(); ++i)
+  {
+    NodeData* cur = visit[i];
+    assert(cur->d_retired);
+    cur->d_retired = false;
+    if (cur->d_refs > 0)
+    {
+      continue;
+    }
+
+    size_t num_children = cur->get_num_children();
+    if (num_children > 0 || cur->get_kind() == Kind::VALUE)
+    {
+      shard(d_unique_table.hash(cur)).d_table.erase(cur);
+    }
+
+    if (num_children > 0)
+    {
+      auto& payload = cur->payload_children();
+      for (size_t j = 0; j < num_children; ++j)
+      {
+        Node& child = payload.d_children[j];
+        auto d      = child.d_data;
+        --d->d_refs;
+        child.d_data = nullptr;
+        if (d->d_refs == 0 && !d->d_retired)
+        {
+          d->d_retired = true;
+          visit.push_back(d);
+        }
+      }
+    }
+    NodeData::dealloc(d_allocator, cur);
     --d_stats.d_num_node_data;
     ++d_stats.d_num_node_data_dealloc;
-  } while (!visit.empty());
+  }
 
   d_in_gc_mode = false;
 }
 
+/* --- NodeManager::EpochGuard --------------------------------------------- */
+
+NodeManager::EpochGuard::EpochGuard(NodeManager& nm) : d_nm(nm)
+{
+  if (d_nm.d_concurrent)
+  {
+    d_nm.d_epoch_gate.lock_shared();
+    ++s_num_epoch_guards;
+    d_active = true;
+  }
+}
+
+NodeManager::EpochGuard::~EpochGuard()
+{
+  if (d_active)
+  {
+    d_nm.d_epoch_gate.unlock_shared();
+    --s_num_epoch_guards;
+    // The last thread that leaves the epoch reclaims retired node data.
+    d_nm.try_reclaim();
+  }
+}
+
 const std::optional<std::reference_wrapper<const std::string>>
 NodeManager::get_symbol(const NodeData* data) const
 {
@@ -14,7 +14,9 @@
 #include <cstddef>
 #include <cstdint>
 #include <memory>
+#include <mutex>
 #include <optional>
+#include <shared_mutex>
 #include <string>
 #include <unordered_map>
 #include <unordered_set>
@@ -22,6 +24,7 @@
 
 #include "node/node.h"
 #include "node/node_data.h"
+#include "node/node_data_allocator.h"
 #include "node/node_unique_table.h"
 #include "type/type_manager.h"
 
@@ -36,13 +39,65 @@ class NodeManager
   friend node::NodeData;
 
  public:
-  NodeManager() = default;
+  NodeManager();
   ~NodeManager();
   NodeManager(const NodeManager&)            = delete;
   NodeManager& operator=(const NodeManager&) = delete;
 
+  /**
+   * Marks the calling thread as an active user of a node manager in
+   * concurrent mode.
+   *
+   * Node data whose reference count drops to zero in concurrent mode is not
+   * garbage collected immediately, but retired and reclaimed in bulk in
+   * between epochs, i.e., when no thread holds an epoch guard. Every thread
+   * that concurrently accesses the node manager (or any of its nodes) must
+   * hold an epoch guard for the duration of the access.
+   *
+   * Has no effect if concurrent mode is not enabled.
+   */
+  class EpochGuard
+  {
+   public:
+    EpochGuard(NodeManager& nm);
+    ~EpochGuard();
+    EpochGuard(const EpochGuard&)            = delete;
+    EpochGuard& operator=(const EpochGuard&) = delete;
+
+   private:
+    NodeManager& d_nm;
+    /** True if this guard entered an epoch. */
+    bool d_active = false;
+  };
+
   type::TypeManager* tm();
 
+  /**
+   * Enable concurrent mode.
+   *
+   * In concurrent mode, nodes can be created and shared between multiple
+   * threads. The unique table is split into shards with one lock each,
+   * reference counting is done atomically and garbage collection is deferred
+   * to epoch boundaries (see EpochGuard).
+   *
+   * @note Must be called while no other thread accesses the node manager.
+   */
+  void enable_concurrency();
+
+  /**
+   * Disable concurrent mode.
+   *
+   * Reclaims all retired node data, merges the unique table shards and
+   * switches reference counting of existing node data back to non-atomic.
+   *
+   * @note Must be called while no other thread accesses the node manager and
+   *       no epoch guard is held.
+   */
+  void disable_concurrency();
+
+  /** @return True if concurrent mode is enabled. */
+  bool is_concurrent() const { return d_concurrent; }
+
   /* --- Node interface ---------------------------------------------------- */
 
   /**
@@ -186,13 +241,17 @@ class NodeManager
       const std::vector<Node>& children,
       const std::vector<uint64_t>& indices = {});
 
-#ifndef NDEBUG
   /** @return Current maximum node id. */
-  uint64_t max_node_id() const { return d_node_id_counter; }
-#endif
+  uint64_t max_node_id() const
+  {
+    return __atomic_load_n(&d_node_id_counter, __ATOMIC_RELAXED);
+  }
 
   const auto& statistics() const { return d_stats; }
 
+  /** @return The statistics of the node data allocator. */
+  const auto& allocator_statistics() const { return d_allocator.statistics(); }
+
  private:
   /**
    * Initialize node data.
@@ -204,6 +263,16 @@ class NodeManager
    */
   void init_id(node::NodeData* d);
 
+  /**
+   * Find or insert new value node data.
+   *
+   * @param type The type of the value.
+   * @param value The value.
+   * @return The node data pointer.
+   */
+  template <class T>
+  node::NodeData* find_or_insert_value(const Type& type, const T& value);
+
   /**
    * Find or insert new node data based on given criteria.
    *
@@ -233,6 +302,48 @@ class NodeManager
    */
   void garbage_collect(node::NodeData* d);
 
+  /**
+   * Schedule node data for deferred garbage collection in concurrent mode.
+   *
+   * @param d Node data with reference count zero.
+   */
+  void retire(node::NodeData* d);
+
+  /**
+   * Reclaim retired node data if no thread is within an epoch.
+   */
+  void try_reclaim();
+
+  /**
+   * Garbage collect all retired node data with reference count zero.
+   *
+   * @note Must only be called while no other thread accesses the node
+   *       manager.
+   */
+  void reclaim();
+
+  /** Shard of the unique table in concurrent mode. */
+  struct Shard
+  {
+    Shard(node::NodeDataAllocator& allocator) : d_table(allocator) {}
+    /** Lock guarding d_table. */
+    std::mutex d_mutex;
+    /** The unique table of this shard. */
+    node::NodeUniqueTable d_table;
+  };
+
+  /** @return The shard responsible for nodes with given hash value. */
+  Shard& shard(size_t hash)
+  {
+    uint64_t h = static_cast<uint64_t>(hash) * UINT64_C(0x9e3779b97f4a7c15);
+    return *d_shards[h >> (64 - s_log_num_shards)];
+  }
+
+  /** Log2 of the number of unique table shards. */
+  static constexpr size_t s_log_num_shards = 6;
+  /** Number of retired nodes that triggers a reclamation attempt. */
+  static constexpr size_t s_reclaim_threshold = 1 << 14;
+
   const std::optional<std::reference_wrapper<const std::string>> get_symbol(
       const node::NodeData* d) const;
 
@@ -245,12 +356,26 @@ class NodeManager
   /** Indicates whether node manager is in garbage collection mode. */
   bool d_in_gc_mode = false;
 
-  /** Stores allocated node data objects for constants and variables. */
-  std::unordered_set<node::NodeData*> d_alloc_nodes;
+  /** Allocator for node data objects. */
+  node::NodeDataAllocator d_allocator;
 
   /** Lookup data structure for hash consing of node data. */
   node::NodeUniqueTable d_unique_table;
 
+  /** Indicates whether concurrent mode is enabled. */
+  bool d_concurrent = false;
+  /** Unique table shards, used instead of d_unique_table if concurrent. */
+  std::vector<std::unique_ptr<Shard>> d_shards;
+  /**
+   * Epoch gate, shared by threads that hold an epoch guard, exclusively
+   * locked while reclaiming retired node data.
+   */
+  std::shared_mutex d_epoch_gate;
+  /** Retired node data, pending for reclamation. */
+  std::vector<node::NodeData*> d_retired;
+  /** Lock guarding d_retired. */
+  std::mutex d_retired_mutex;
+
   struct Statistics
   {
     uint64_t d_num_node_data = 0;
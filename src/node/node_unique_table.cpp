@@ -6,34 +6,11 @@ namespace bzla::node {
 
 /* --- NodeUniqueTable public ----------------------------------------------- */
 
-NodeUniqueTable::NodeUniqueTable() { d_buckets.resize(16, nullptr); }
-
-NodeUniqueTable::~NodeUniqueTable()
+NodeUniqueTable::NodeUniqueTable(NodeDataAllocator& allocator)
+    : d_allocator(allocator)
 {
-  // Cleanup remaining node data.
-  //
-  // Note: Automatic reference counting of Node should actually prevent node
-  //       data leaks. However, nodes that are stored in static memory do not
-  //       get garbage collected. Hence, we have to make sure to invalidate all
-  //       node data before destructing the unique table.
-  for (size_t i = 0, size = d_buckets.size(); i < size; ++i)
-  {
-    NodeData* cur = d_buckets[i];
-    while (cur != nullptr)
-    {
-      NodeData* next = cur->d_next;
-      if (cur->has_children())
-      {
-        auto& payload = cur->payload_children();
-        for (size_t j = 0; j < payload.d_num_children; ++j)
-        {
-          payload.d_children[j].d_data = nullptr;
-        }
-      }
-      NodeData::dealloc(cur);
-      cur = next;
-    }
-  }
+  d_ctrl.resize(s_group_size, s_ctrl_empty);
+  d_slots.resize(s_group_size, nullptr);
 }
 
 std::pair<bool, NodeData*>
@@ -44,67 +21,70 @@ NodeUniqueTable::find_or_insert(Kind kind,
 {
   assert(kind != Kind::VALUE);
 
-  size_t hd     = hash(kind, children, indices);
-  size_t h      = bucket_hash(hd);
-  NodeData* cur = d_buckets[h];
-
-  // Check collision chain.
-  while (cur)
-  {
-    // Found existing node
-    if (equals(*cur, kind, type, children, indices))
-    {
-      return std::make_pair(false, cur);
-    }
-    cur = cur->d_next;
-  }
+  return find_or_insert(
+      hash(kind, children, indices),
+      [&](const NodeData* d) {
+        return equals(*d, kind, type, children, indices);
+      },
+      [&]() { return NodeData::alloc(d_allocator, kind, children, indices); });
+}
 
-  // Create new node and insert
-  NodeData* d = NodeData::alloc(kind, children, indices);
-  if (needs_resize())
-  {
-    resize();
-    h = bucket_hash(hd);
-  }
-  assert(d->d_next == nullptr);
-  d->d_next    = d_buckets[h];
-  d_buckets[h] = d;
+void
+NodeUniqueTable::insert(NodeData* d)
+{
+  [[maybe_unused]] auto [inserted, data] = find_or_insert(
+      hash(d), [](const NodeData*) { return false; }, [d]() { return d; });
+  assert(inserted);
+}
 
-  ++d_num_elements;
-  return std::make_pair(true, d);
+void
+NodeUniqueTable::clear()
+{
+  d_ctrl         = std::vector<uint8_t>(s_group_size, s_ctrl_empty);
+  d_slots        = std::vector<NodeData*>(s_group_size, nullptr);
+  d_num_elements = 0;
+  d_num_deleted  = 0;
 }
 
 void
 NodeUniqueTable::erase(const NodeData* d)
 {
-  size_t h       = bucket_hash(hash(d));
-  NodeData* cur  = d_buckets[h];
-  NodeData* prev = nullptr;
-  assert(cur != nullptr);
+  size_t h     = mix(hash(d));
+  uint8_t fp   = fingerprint(h);
+  size_t mask  = num_groups() - 1;
+  size_t group = h & mask;
 
-  // Find data in collision chain.
-  while (cur)
+  for (size_t i = 1;; ++i)
   {
+    const uint8_t* ctrl = &d_ctrl[group * s_group_size];
+    size_t base         = group * s_group_size;
     // Note: No need to use equals() here, we can safely compare the pointers.
-    if (cur == d)
+    for (uint32_t m = match(ctrl, fp); m; m &= m - 1)
     {
-      break;
+      size_t pos = base + __builtin_ctz(m);
+      if (d_slots[pos] == d)
+      {
+        // If the group still has an empty slot, it was never full and hence
+        // no probe sequence continued past this group. We can then mark the
+        // slot as empty instead of deleted.
+        if (match(ctrl, s_ctrl_empty))
+        {
+          d_ctrl[pos] = s_ctrl_empty;
+        }
+        else
+        {
+          d_ctrl[pos] = s_ctrl_deleted;
+          ++d_num_deleted;
+        }
+        d_slots[pos] = nullptr;
+        --d_num_elements;
+        return;
+      }
     }
-    prev = cur;
-    cur  = cur->d_next;
-  }
-  assert(cur);
-
-  // Update collision chain.
-  if (prev == nullptr)
-  {
-    d_buckets[h] = cur->d_next;
-  }
-  else
-  {
-    prev->d_next = cur->d_next;
+    // Node data must be in the table.
+    assert(!match(ctrl, s_ctrl_empty));
+    group = (group + i) & mask;
   }
-  --d_num_elements;
 }
 
 /* --- NodeUniqueTable private ---------------------------------------------- */
@@ -112,24 +92,48 @@ NodeUniqueTable::erase(const NodeData* d)
 void
 NodeUniqueTable::resize()
 {
-  size_t new_size = d_buckets.capacity() * 2;
-  std::vector<NodeData*> buckets(new_size, nullptr);
+  size_t size = d_slots.size();
+  // Only grow if the table is at least half full with live elements,
+  // otherwise rehash in place to get rid of deleted slots.
+  if ((d_num_elements + 1) * 2 > size)
+  {
+    size *= 2;
+  }
+
+  std::vector<uint8_t> ctrl(size, s_ctrl_empty);
+  std::vector<NodeData*> slots(size, nullptr);
+  std::swap(ctrl, d_ctrl);
+  std::swap(slots, d_slots);
+  d_num_deleted = 0;
 
   // Rehash elements.
-  size_t mask = new_size - 1;
-  for (auto cur : d_buckets)
+  for (size_t i = 0, n = slots.size(); i < n; ++i)
   {
-    while (cur)
+    if (ctrl[i] < s_ctrl_empty)
     {
-      size_t h     = bucket_hash(hash(cur), mask);
-      auto next    = cur->d_next;
-      cur->d_next  = buckets[h];
-      buckets[h]   = cur;
-      cur          = next;
+      size_t h     = mix(hash(slots[i]));
+      size_t pos   = find_free_slot(h);
+      d_ctrl[pos]  = fingerprint(h);
+      d_slots[pos] = slots[i];
     }
   }
+}
 
-  d_buckets = std::move(buckets);
+size_t
+NodeUniqueTable::find_free_slot(size_t h) const
+{
+  size_t mask  = num_groups() - 1;
+  size_t group = h & mask;
+  for (size_t i = 1;; ++i)
+  {
+    const uint8_t* ctrl = &d_ctrl[group * s_group_size];
+    uint32_t m = match(ctrl, s_ctrl_empty) | match(ctrl, s_ctrl_deleted);
+    if (m)
+    {
+      return group * s_group_size + __builtin_ctz(m);
+    }
+    group = (group + i) & mask;
+  }
 }
 
 size_t
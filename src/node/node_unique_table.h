@@ -11,18 +11,36 @@
 #ifndef BZLA_NODE_NODE_UNIQUE_TABLE_H_INCLUDED
 #define BZLA_NODE_NODE_UNIQUE_TABLE_H_INCLUDED
 
+#include <cstring>
 #include <iostream>
 #include <vector>
 
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
 #include "node/node_data.h"
 
 namespace bzla::node {
 
+/**
+ * Unique table for hash consing of node data.
+ *
+ * Open addressing hash table that stores one control byte per slot next to
+ * the node data pointers. A control byte is either empty, deleted, or holds
+ * a 7-bit fingerprint of the hash value of the stored node data. Slots are
+ * organized in groups of `s_group_size` slots, and a lookup compares the
+ * fingerprint against all control bytes of a group at once (SSE2 if
+ * available, word-parallel otherwise) before dereferencing any node data.
+ */
 class NodeUniqueTable
 {
  public:
-  NodeUniqueTable();
-  ~NodeUniqueTable();
+  /**
+   * Constructor.
+   * @param allocator The allocator used to allocate new node data.
+   */
+  NodeUniqueTable(NodeDataAllocator& allocator);
 
   /**
    * Find node with specified criteria. If node does not exist yet, allocates
@@ -41,59 +59,162 @@ class NodeUniqueTable
   template <class T>
   std::pair<bool, NodeData*> find_or_insert(const Type& type, const T& value)
   {
-    size_t hd     = hash_value(value);
-    size_t h      = bucket_hash(hd);
-    NodeData* cur = d_buckets[h];
+    return find_or_insert(
+        hash_value(value),
+        [&type, &value](const NodeData* d) {
+          return d->d_kind == Kind::VALUE && d->get_type() == type
+                 && d->payload_value<T>().d_value == value;
+        },
+        [this, &value]() { return NodeData::alloc(d_allocator, value); });
+  }
+
+  /**
+   * Insert node data that is not yet stored in the unique table.
+   * @note The node data must not be equal to any node data in the table.
+   */
+  void insert(NodeData* d);
+
+  /** Delete node data from unique table. */
+  void erase(const NodeData* d);
+
+  /** Remove all node data from the unique table. */
+  void clear();
 
-    // Check collision chain.
-    while (cur)
+  /** @return The number of nodes stored in the unique table. */
+  size_t size() const { return d_num_elements; }
+
+  /**
+   * Apply given function to all stored node data.
+   * @param fun The function to apply, receives a `NodeData*`.
+   */
+  template <class Fun>
+  void for_each(Fun&& fun) const
+  {
+    for (size_t i = 0, size = d_slots.size(); i < size; ++i)
     {
-      if (cur->d_kind == Kind::VALUE && cur->get_type() == type)
+      if (d_ctrl[i] < s_ctrl_empty)
       {
-        const auto& payload = cur->payload_value<T>();
-        if (payload.d_value == value)
+        fun(d_slots[i]);
+      }
+    }
+  }
+
+  /** Hash node data. */
+  size_t hash(const NodeData* d) const;
+
+  /** Compute hash value of node lookup data. */
+  size_t hash(Kind kind,
+              const std::vector<Node>& children,
+              const std::vector<uint64_t>& indices) const;
+
+  /** Compute has value of value node lookup data. */
+  template <class T>
+  size_t hash_value(const T& value) const
+  {
+    return static_cast<size_t>(Kind::VALUE) + std::hash<T>{}(value);
+  }
+
+ private:
+  static constexpr std::array<size_t, 4> s_primes = {
+      333444569u, 76891121u, 456790003u, 111130391u};
+
+  /** Number of slots per group. */
+  static constexpr size_t s_group_size = 16;
+  /** Control byte of an empty slot. */
+  static constexpr uint8_t s_ctrl_empty = 0x80;
+  /** Control byte of a deleted slot. */
+  static constexpr uint8_t s_ctrl_deleted = 0xfe;
+
+  /**
+   * Find node data with given hash value that satisfies `eq`. If no such
+   * node data exists, create new node data via `alloc` and insert it.
+   */
+  template <class Eq, class Alloc>
+  std::pair<bool, NodeData*> find_or_insert(size_t hash,
+                                            Eq&& eq,
+                                            Alloc&& alloc)
+  {
+    size_t h     = mix(hash);
+    uint8_t fp   = fingerprint(h);
+    size_t mask  = num_groups() - 1;
+    size_t group = h & mask;
+    size_t free  = SIZE_MAX;
+
+    for (size_t i = 1;; ++i)
+    {
+      const uint8_t* ctrl = &d_ctrl[group * s_group_size];
+      size_t base         = group * s_group_size;
+
+      // Check all slots in this group with a matching fingerprint.
+      for (uint32_t m = match(ctrl, fp); m; m &= m - 1)
+      {
+        NodeData* d = d_slots[base + __builtin_ctz(m)];
+        if (eq(d))
+        {
+          return std::make_pair(false, d);
+        }
+      }
+      // Remember first deleted slot, we can reuse it if the node is not
+      // found.
+      if (free == SIZE_MAX)
+      {
+        uint32_t m = match(ctrl, s_ctrl_deleted);
+        if (m)
         {
-          return std::make_pair(false, cur);
+          free = base + __builtin_ctz(m);
         }
       }
-      cur = cur->d_next;
+      // An empty slot terminates the probe sequence.
+      uint32_t m = match(ctrl, s_ctrl_empty);
+      if (m)
+      {
+        if (free == SIZE_MAX)
+        {
+          free = base + __builtin_ctz(m);
+        }
+        break;
+      }
+      // Triangular probing visits all groups if the number of groups is a
+      // power of two.
+      group = (group + i) & mask;
     }
 
     // Create new node and insert
-    NodeData* d = NodeData::alloc(value);
-    if (needs_resize())
+    NodeData* d = alloc();
+    if (d_ctrl[free] == s_ctrl_deleted)
+    {
+      assert(d_num_deleted > 0);
+      --d_num_deleted;
+    }
+    else if (needs_resize())
     {
       resize();
-      h = bucket_hash(hd);
+      free = find_free_slot(h);
     }
-    assert(d->d_next == nullptr);
-    d->d_next    = d_buckets[h];
-    d_buckets[h] = d;
-
+    d_ctrl[free]  = fp;
+    d_slots[free] = d;
     ++d_num_elements;
     return std::make_pair(true, d);
   }
 
-  /** Delete node data from unique table. */
-  void erase(const NodeData* d);
-
- private:
-  static constexpr std::array<size_t, 4> s_primes = {
-      333444569u, 76891121u, 456790003u, 111130391u};
+  /** @return The number of slot groups. */
+  size_t num_groups() const { return d_slots.size() / s_group_size; }
 
   /** Check whether unique table needs to be resized. */
-  bool needs_resize() const { return d_num_elements >= d_buckets.capacity(); }
+  bool needs_resize() const
+  {
+    // Maximum load factor (including deleted slots) is 7/8.
+    return (d_num_elements + d_num_deleted + 1) * 8 > d_slots.size() * 7;
+  }
 
   /** Resizes unique table and rehashes node data. */
   void resize();
 
-  /** Hash node data. */
-  size_t hash(const NodeData* d) const;
-
-  /** Compute hash value of node lookup data. */
-  size_t hash(Kind kind,
-              const std::vector<Node>& children,
-              const std::vector<uint64_t>& indices) const;
+  /**
+   * Find first empty or deleted slot in the probe sequence of given mixed
+   * hash value.
+   */
+  size_t find_free_slot(size_t h) const;
 
   /** Compare node data against node lookup data. */
   bool equals(const NodeData& data,
@@ -102,23 +223,6 @@ class NodeUniqueTable
               const std::vector<Node>& children,
               const std::vector<uint64_t>& indices) const;
 
-  /** Compute position in d_buckets based on hash value. */
-  size_t bucket_hash(size_t hash, size_t mask = 0) const
-  {
-    if (mask == 0)
-    {
-      mask = d_buckets.capacity() - 1;
-    }
-    return hash & mask;
-  }
-
-  /** Compute has value of value node lookup data. */
-  template <class T>
-  size_t hash_value(const T& value)
-  {
-    return static_cast<size_t>(Kind::VALUE) + std::hash<T>{}(value);
-  }
-
   inline size_t hash_children(size_t hash,
                               size_t size,
                               const Node* children) const
@@ -141,10 +245,62 @@ class NodeUniqueTable
     return hash;
   }
 
+  /**
+   * Mix bits of hash value. The lower bits select the group, the upper 7 bits
+   * are used as fingerprint.
+   */
+  static size_t mix(size_t hash)
+  {
+    uint64_t h = static_cast<uint64_t>(hash) * UINT64_C(0x9e3779b97f4a7c15);
+    return static_cast<size_t>(h ^ (h >> 32));
+  }
+
+  /** @return The 7-bit fingerprint of a mixed hash value. */
+  static uint8_t fingerprint(size_t h)
+  {
+    return static_cast<uint8_t>(static_cast<uint64_t>(h) >> 57);
+  }
+
+  /**
+   * Match control bytes of a group against given byte.
+   * @return A bit mask with bit i set if control byte i (potentially) matches.
+   */
+  static uint32_t match(const uint8_t* ctrl, uint8_t byte)
+  {
+#ifdef __SSE2__
+    __m128i g = _mm_loadu_si128(reinterpret_cast<const __m128i*>(ctrl));
+    return static_cast<uint32_t>(
+        _mm_movemask_epi8(_mm_cmpeq_epi8(g, _mm_set1_epi8(byte))));
+#else
+    constexpr uint64_t lsbs = UINT64_C(0x0101010101010101);
+    constexpr uint64_t msbs = UINT64_C(0x8080808080808080);
+    uint32_t res            = 0;
+    for (size_t i = 0; i < s_group_size / 8; ++i)
+    {
+      uint64_t w;
+      std::memcpy(&w, ctrl + i * 8, 8);
+      uint64_t x = w ^ (lsbs * byte);
+      // Exact zero byte detection (no false positives due to borrows).
+      uint64_t z = ~(((x & ~msbs) + ~msbs) | x | ~msbs);
+      for (; z; z &= z - 1)
+      {
+        res |= uint32_t(1) << (i * 8 + __builtin_ctzll(z) / 8);
+      }
+    }
+    return res;
+#endif
+  }
+
+  /** The allocator used to allocate node data. */
+  NodeDataAllocator& d_allocator;
   /** Number of nodes stored in unique table. */
   size_t d_num_elements = 0;
-  /** Hash table buckets. */
-  std::vector<NodeData*> d_buckets;
+  /** Number of deleted slots. */
+  size_t d_num_deleted = 0;
+  /** Control bytes, one per slot. */
+  std::vector<uint8_t> d_ctrl;
+  /** Hash table slots. */
+  std::vector<NodeData*> d_slots;
 };
 
 }  // namespace bzla::node
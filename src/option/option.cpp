@@ -189,6 +189,101 @@ Options::Options()
                     "rewrite level",
                     "rewrite-level",
                     "rwl"),
+      portfolio(this,
+                Option::PORTFOLIO,
+                0,
+                0,
+                64,
+                "number of solver configurations to run in parallel "
+                "(0 or 1 disables portfolio mode)",
+                "portfolio"),
+      rewrite_cache_size(this,
+                         Option::REWRITE_CACHE_SIZE,
+                         0,
+                         0,
+                         UINT64_MAX,
+                         "maximum number of cached rewrites (0 for no limit)",
+                         "rewrite-cache-size",
+                         nullptr,
+                         true),
+      rewrite_profile(this,
+                      Option::REWRITE_PROFILE,
+                      false,
+                      "record attempts, successes, cycles and created nodes "
+                      "per rewrite rule",
+                      "rewrite-profile",
+                      nullptr,
+                      true),
+      // BV: bit-blasting engine
+      bv_cube_threads(this,
+                      Option::BV_CUBE_THREADS,
+                      0,
+                      0,
+                      256,
+                      "number of threads for cube-and-conquer solving of "
+                      "bit-blasted formulas (0 or 1 disables cube-and-conquer)",
+                      "bv-cube-threads"),
+      bv_cube_depth(this,
+                    Option::BV_CUBE_DEPTH,
+                    5,
+                    1,
+                    16,
+                    "number of splitting variables for cube-and-conquer, "
+                    "generates 2^n cubes",
+                    "bv-cube-depth",
+                    nullptr,
+                    true),
+      bv_mul_encoding(this,
+                      Option::BV_MUL_ENCODING,
+                      BvMulEncoding::ARRAY,
+                      {{BvMulEncoding::ARRAY, "array"},
+                       {BvMulEncoding::BOOTH, "booth"},
+                       {BvMulEncoding::WALLACE, "wallace"},
+                       {BvMulEncoding::KARATSUBA, "karatsuba"}},
+                      "encoding of bit-vector multiplication when "
+                      "bit-blasting",
+                      "bv-mul-encoding",
+                      nullptr,
+                      true),
+      bv_div_encoding(this,
+                      Option::BV_DIV_ENCODING,
+                      BvDivEncoding::RESTORING,
+                      {{BvDivEncoding::RESTORING, "restoring"},
+                       {BvDivEncoding::NON_RESTORING, "non-restoring"},
+                       {BvDivEncoding::MULTIPLIER, "multiplier"}},
+                      "encoding of unsigned bit-vector division and "
+                      "remainder when bit-blasting",
+                      "bv-div-encoding",
+                      nullptr,
+                      true),
+      bv_sweep(this,
+               Option::BV_SWEEP,
+               false,
+               "merge functionally equivalent AIG nodes via simulation and "
+               "SAT sweeping before CNF encoding",
+               "bv-sweep",
+               nullptr,
+               true),
+      bv_sim_rounds(this,
+                    Option::BV_SIM_ROUNDS,
+                    0,
+                    0,
+                    UINT32_MAX,
+                    "number of rounds of simulating 512 random input patterns "
+                    "on the bit-blasted formula before SAT solving (0 "
+                    "disables simulation)",
+                    "bv-sim-rounds",
+                    nullptr,
+                    true),
+      bv_sat_propagator(this,
+                        Option::BV_SAT_PROPAGATOR,
+                        false,
+                        "check theory consistency of complete assignments "
+                        "during SAT search via an external propagator, "
+                        "disables variable elimination of the SAT solver",
+                        "bv-sat-propagator",
+                        nullptr,
+                        true),
       // BV: propagation-based local search engine
       prop_nprops(this,
                   Option::PROP_NPROPS,
@@ -262,6 +357,13 @@ Options::Options()
                      false,
                      "enable normalization for local search",
                      "prop-normalize"),
+      prop_walkers(this,
+                   Option::PROP_WALKERS,
+                   1,
+                   1,
+                   256,
+                   "number of local search walkers to run in parallel",
+                   "prop-walkers"),
       abstraction(this,
                   Option::ABSTRACTION,
                   false,
@@ -346,6 +448,27 @@ Options::Options()
                       "term abstraction for ite",
                       "abstraction-ite"),
 
+      // Quantifier solver
+      quant_mbqi_persistent(this,
+                            Option::QUANT_MBQI_PERSISTENT,
+                            true,
+                            "keep the MBQI subsolver across checks and assume "
+                            "model values instead of recreating it",
+                            "quant-mbqi-persistent",
+                            nullptr,
+                            true),
+      quant_mbqi_threads(this,
+                         Option::QUANT_MBQI_THREADS,
+                         0,
+                         0,
+                         256,
+                         "number of threads for checking quantifiers for "
+                         "counterexamples in parallel (0 or 1 checks "
+                         "sequentially)",
+                         "quant-mbqi-threads",
+                         nullptr,
+                         true),
+
       // Preprocessing
       preprocess(
           this, Option::PREPROCESS, true, "enable preprocessing", "preprocess"),
@@ -713,6 +836,16 @@ Options::data(Option opt)
 
     case Option::BV_SOLVER: return &bv_solver;
     case Option::REWRITE_LEVEL: return &rewrite_level;
+    case Option::PORTFOLIO: return &portfolio;
+    case Option::REWRITE_CACHE_SIZE: return &rewrite_cache_size;
+    case Option::REWRITE_PROFILE: return &rewrite_profile;
+    case Option::BV_CUBE_THREADS: return &bv_cube_threads;
+    case Option::BV_CUBE_DEPTH: return &bv_cube_depth;
+    case Option::BV_MUL_ENCODING: return &bv_mul_encoding;
+    case Option::BV_DIV_ENCODING: return &bv_div_encoding;
+    case Option::BV_SWEEP: return &bv_sweep;
+    case Option::BV_SIM_ROUNDS: return &bv_sim_rounds;
+    case Option::BV_SAT_PROPAGATOR: return &bv_sat_propagator;
 
     case Option::PROP_NPROPS: return &prop_nprops;
     case Option::PROP_NUPDATES: return &prop_nupdates;
@@ -725,6 +858,7 @@ Options::data(Option opt)
     case Option::PROP_OPT_LT_CONCAT_SEXT: return &prop_opt_lt_concat_sext;
     case Option::PROP_SEXT: return &prop_sext;
     case Option::PROP_NORMALIZE: return &prop_normalize;
+    case Option::PROP_WALKERS: return &prop_walkers;
     case Option::ABSTRACTION: return &abstraction;
     case Option::ABSTRACTION_BV_SIZE: return &abstraction_bv_size;
     case Option::ABSTRACTION_EAGER_REFINE: return &abstraction_eager_refine;
@@ -741,6 +875,9 @@ Options::data(Option opt)
     case Option::ABSTRACTION_EQUAL: return &abstraction_eq;
     case Option::ABSTRACTION_ITE: return &abstraction_ite;
 
+    case Option::QUANT_MBQI_PERSISTENT: return &quant_mbqi_persistent;
+    case Option::QUANT_MBQI_THREADS: return &quant_mbqi_threads;
+
     case Option::PREPROCESS: return &preprocess;
     case Option::PP_CONTRADICTING_ANDS: return &pp_contr_ands;
     case Option::PP_ELIM_BV_EXTRACTS: return &pp_elim_bv_extracts;
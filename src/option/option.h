@@ -34,9 +34,20 @@ enum class Option
   MEMORY_LIMIT,               // numeric
   RELEVANT_TERMS,             // bool
 
-  BV_SOLVER,      // enum
-  REWRITE_LEVEL,  // numeric
-  SAT_SOLVER,     // enum
+  BV_SOLVER,           // enum
+  REWRITE_LEVEL,       // numeric
+  SAT_SOLVER,          // enum
+  PORTFOLIO,           // numeric
+  REWRITE_CACHE_SIZE,  // numeric
+  REWRITE_PROFILE,     // bool
+
+  BV_CUBE_THREADS,    // numeric
+  BV_CUBE_DEPTH,      // numeric
+  BV_MUL_ENCODING,    // enum
+  BV_DIV_ENCODING,    // enum
+  BV_SWEEP,           // bool
+  BV_SIM_ROUNDS,      // numeric
+  BV_SAT_PROPAGATOR,  // bool
 
   PROP_NPROPS,                  // numeric
   PROP_NUPDATES,                // numeric
@@ -48,6 +59,7 @@ enum class Option
   PROP_OPT_LT_CONCAT_SEXT,      // bool
   PROP_SEXT,                    // bool
   PROP_NORMALIZE,               // bool
+  PROP_WALKERS,                 // numeric
 
   // Abstraction module
   ABSTRACTION,                 // bool
@@ -66,6 +78,10 @@ enum class Option
   ABSTRACTION_EQUAL,           // bool
   ABSTRACTION_ITE,             // bool
 
+  // Quantifier solver
+  QUANT_MBQI_PERSISTENT,  // bool
+  QUANT_MBQI_THREADS,     // numeric
+
   // Preprocessing options for enabling/disabling passes
   PREPROCESS,                // bool
   PP_CONTRADICTING_ANDS,     // bool
@@ -112,6 +128,21 @@ enum class BvSolver
   PREPROP,
 };
 
+enum class BvMulEncoding
+{
+  ARRAY,
+  BOOTH,
+  WALLACE,
+  KARATSUBA,
+};
+
+enum class BvDivEncoding
+{
+  RESTORING,
+  NON_RESTORING,
+  MULTIPLIER,
+};
+
 enum class SatSolver
 {
   CADICAL,
@@ -421,6 +452,17 @@ class OptionModeT : public OptionMode
   }
   OptionModeT() = delete;
 
+  /**
+   * Set the current mode of an option with modes.
+   * @param value       The current mode.
+   * @param is_user_set True if this option was configured from outside.
+   */
+  void set(T value, bool is_user_set = false)
+  {
+    d_value       = value;
+    d_is_user_set = is_user_set;
+  }
+
   const T& operator()() const { return d_value; }
 
   /** @return The default value of this option. */
@@ -480,6 +522,18 @@ class Options
   OptionModeT<BvSolver> bv_solver;
   OptionModeT<SatSolver> sat_solver;
   OptionNumeric rewrite_level;
+  OptionNumeric portfolio;
+  OptionNumeric rewrite_cache_size;
+  OptionBool rewrite_profile;
+
+  // BV: bit-blasting engine
+  OptionNumeric bv_cube_threads;
+  OptionNumeric bv_cube_depth;
+  OptionModeT<BvMulEncoding> bv_mul_encoding;
+  OptionModeT<BvDivEncoding> bv_div_encoding;
+  OptionBool bv_sweep;
+  OptionNumeric bv_sim_rounds;
+  OptionBool bv_sat_propagator;
 
   // BV: propagation-based local search engine
   OptionNumeric prop_nprops;
@@ -492,6 +546,7 @@ class Options
   OptionBool prop_opt_lt_concat_sext;
   OptionBool prop_sext;
   OptionBool prop_normalize;
+  OptionNumeric prop_walkers;
 
   OptionBool abstraction;
   OptionNumeric abstraction_bv_size;
@@ -509,6 +564,10 @@ class Options
   OptionBool abstraction_eq;
   OptionBool abstraction_ite;
 
+  // Quantifier solver
+  OptionBool quant_mbqi_persistent;
+  OptionNumeric quant_mbqi_threads;
+
   // Preprocessing
   OptionBool preprocess;
   OptionBool pp_contr_ands;
@@ -0,0 +1,180 @@
+/***
+ * Bitwuzla: Satisfiability Modulo Theories (SMT) solver.
+ *
+ * Copyright (C) 2023 by the authors listed in the AUTHORS file at
+ * https://github.com/bitwuzla/bitwuzla/blob/main/AUTHORS
+ *
+ * This file is part of Bitwuzla under the MIT license. See COPYING for more
+ * information at https://github.com/bitwuzla/bitwuzla/blob/main/COPYING
+ */
+
+#include "parser/binary/parser.h"
+
+#include <unordered_set>
+
+namespace bzla {
+namespace parser::binary {
+
+/* Parser public ------------------------------------------------------------ */
+
+Parser::Parser(bitwuzla::TermManager& tm,
+               bitwuzla::Options& options,
+               std::ostream* out)
+    : bzla::parser::Parser(tm, options, out)
+{
+  init_bitwuzla();
+}
+
+Parser::~Parser() {}
+
+bool
+Parser::parse(const std::string& input, bool parse_only, bool parse_file)
+{
+  d_done = false;
+
+  std::istream* instream = &std::cin;
+  std::ifstream infile;
+  std::stringstream instring;
+
+  if (parse_file)
+  {
+    if (input != "<stdin>")
+    {
+      infile.open(input, std::ifstream::in | std::ifstream::binary);
+      if (!infile)
+      {
+        d_error = "failed to open '" + input + "'";
+        return false;
+      }
+      instream = &infile;
+    }
+  }
+  else
+  {
+    instring << input;
+    instream = &instring;
+  }
+
+  bool res = parse(parse_file ? input : "<string>", *instream, parse_only);
+  if (infile.is_open())
+  {
+    infile.close();
+  }
+  return res;
+}
+
+bool
+Parser::parse(const std::string& infile_name,
+              std::istream& input,
+              bool parse_only)
+{
+  util::Timer timer(d_statistics.time_parse);
+  Log(2) << "parse " << infile_name;
+
+  d_infile_name = infile_name;
+
+  if (!d_error.empty())
+  {
+    d_error = "parser in unsafe state after parse error";
+    return false;
+  }
+
+  try
+  {
+    d_bitwuzla->load_formula(input);
+  }
+  catch (bitwuzla::Exception& e)
+  {
+    // Remove the "invalid call to '...', prefix
+    const std::string& msg = e.msg();
+    size_t pos             = msg.find("', ");
+    d_error = d_infile_name + ": "
+              + (pos == std::string::npos ? msg : msg.substr(pos + 3));
+    return false;
+  }
+  collect_declared_funs();
+  d_done = true;
+
+  Msg(1) << "parsed " << d_bitwuzla->get_assertions().size()
+         << " assertions in "
+         << ((double) d_statistics.time_parse.elapsed() / 1000) << " seconds";
+
+  if (!parse_only && !terminate())
+  {
+    d_result = d_bitwuzla->check_sat();
+    (*d_out) << d_result << std::endl;
+  }
+  return true;
+}
+
+bool
+Parser::parse_term(const std::string& input, bitwuzla::Term& res)
+{
+  (void) input;
+  (void) res;
+  d_error = "parsing terms is not supported for binary input";
+  return false;
+}
+
+bool
+Parser::parse_sort(const std::string& input, bitwuzla::Sort& res)
+{
+  (void) input;
+  (void) res;
+  d_error = "parsing sorts is not supported for binary input";
+  return false;
+}
+
+std::vector<bitwuzla::Sort>
+Parser::get_declared_sorts() const
+{
+  return {};
+}
+
+std::vector<bitwuzla::Term>
+Parser::get_declared_funs() const
+{
+  return d_declared_funs;
+}
+
+/* Parser private ----------------------------------------------------------- */
+
+void
+Parser::collect_declared_funs()
+{
+  std::unordered_set<bitwuzla::Term> cache;
+  std::vector<bitwuzla::Term> visit = d_bitwuzla->get_assertions();
+  d_declared_funs.clear();
+  while (!visit.empty())
+  {
+    bitwuzla::Term cur = visit.back();
+    visit.pop_back();
+    if (!cache.insert(cur).second)
+    {
+      continue;
+    }
+    if (cur.is_const())
+    {
+      if (cur.symbol())
+      {
+        d_declared_funs.push_back(cur);
+      }
+    }
+    else
+    {
+      std::vector<bitwuzla::Term> children = cur.children();
+      visit.insert(visit.end(), children.begin(), children.end());
+    }
+  }
+}
+
+/* Parser::Statistics ------------------------------------------------------- */
+
+Parser::Statistics::Statistics()
+    : time_parse(
+        d_stats.new_stat<util::TimerStatistic>("parser::binary::time_parse"))
+{
+}
+
+}  // namespace parser::binary
+}  // namespace bzla
@@ -0,0 +1,80 @@
+/***
+ * Bitwuzla: Satisfiability Modulo Theories (SMT) solver.
+ *
+ * Copyright (C) 2023 by the authors listed in the AUTHORS file at
+ * https://github.com/bitwuzla/bitwuzla/blob/main/AUTHORS
+ *
+ * This file is part of Bitwuzla under the MIT license. See COPYING for more
+ * information at https://github.com/bitwuzla/bitwuzla/blob/main/COPYING
+ */
+
+#ifndef BZLA_PARSER_BINARY_PARSER_H_INCLUDED
+#define BZLA_PARSER_BINARY_PARSER_H_INCLUDED
+
+#include "parser/parser.h"
+
+namespace bzla {
+namespace parser::binary {
+
+/**
+ * Parser for formulas in the Bitwuzla binary format.
+ *
+ * Loads the formula into the Bitwuzla instance and, if not parse-only, checks
+ * the loaded assertions for satisfiability.
+ */
+class Parser : public bzla::parser::Parser
+{
+ public:
+  /**
+   * Constructor.
+   * @param options     The associated Bitwuzla options. Parser creates
+   *                    Bitwuzla instance from these options.
+   * @param out         The output stream.
+   */
+  Parser(bitwuzla::TermManager& tm,
+         bitwuzla::Options& options,
+         std::ostream* out = &std::cout);
+  /** Destructor. */
+  ~Parser();
+
+  bool parse(const std::string& input,
+             bool parse_only,
+             bool parse_file) override;
+  bool parse(const std::string& infile_name,
+             std::istream& input,
+             bool parse_only) override;
+
+  /** Not supported for binary input, always returns false. */
+  bool parse_term(const std::string& input, bitwuzla::Term& res) override;
+  /** Not supported for binary input, always returns false. */
+  bool parse_sort(const std::string& input, bitwuzla::Sort& res) override;
+  std::vector<bitwuzla::Sort> get_declared_sorts() const override;
+  std::vector<bitwuzla::Term> get_declared_funs() const override;
+
+ private:
+  /** Collect the constants with symbols of the loaded assertions. */
+  void collect_declared_funs();
+
+  /** The constants with symbols of the loaded assertions. */
+  std::vector<bitwuzla::Term> d_declared_funs;
+
+  /** Parse statistics. */
+  struct Statistics
+  {
+    Statistics();
+
+    util::Statistics d_stats;
+
+    /**
+     * The time required for parsing.
+     * @note This is not parse-only, it includes time for the check-sat call.
+     */
+    util::TimerStatistic& time_parse;
+
+  } d_statistics;
+};
+
+}  // namespace parser::binary
+}  // namespace bzla
+
+#endif
@@ -0,0 +1,521 @@
+/***
+ * Bitwuzla: Satisfiability Modulo Theories (SMT) solver.
+ *
+ * Copyright (C) 2023 by the authors listed in the AUTHORS file at
+ * https://github.com/bitwuzla/bitwuzla/blob/main/AUTHORS
+ *
+ * This file is part of Bitwuzla under the MIT license. See COPYING for more
+ * information at https://github.com/bitwuzla/bitwuzla/blob/main/COPYING
+ */
+
+#include "parser/binary/reader.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "bv/bitvector.h"
+#include "node/node_manager.h"
+#include "printer/binary_printer.h"
+#include "solver/fp/floating_point.h"
+#include "solver/fp/rounding_mode.h"
+
+namespace bzla::parser::binary {
+
+using namespace node;
+
+namespace {
+/**
+ * The maximum number of table entries reserved in advance, larger tables
+ * grow while reading.
+ */
+constexpr uint64_t s_max_reserve = 1 << 20;
+}  // namespace
+
+Reader::Reader(NodeManager& nm, std::istream& in)
+    : d_nm(nm), d_in(in), d_buffer(s_buffer_size)
+{
+}
+
+bool
+Reader::read()
+{
+  if (!read_header() || !read_types() || !read_values() || !read_nodes()
+      || !read_roots())
+  {
+    return false;
+  }
+  if (d_pos < d_size || fill())
+  {
+    return error("unexpected data after end of input");
+  }
+  return true;
+}
+
+/* --- Reader private ------------------------------------------------------- */
+
+bool
+Reader::read_header()
+{
+  std::string magic;
+  if (!read_bytes(std::strlen(BinaryPrinter::s_magic), magic))
+  {
+    return false;
+  }
+  if (magic != BinaryPrinter::s_magic)
+  {
+    return error("invalid binary input, missing magic bytes '"
+                 + std::string(BinaryPrinter::s_magic) + "'");
+  }
+  uint64_t version, num_kinds;
+  if (!read_uint(version))
+  {
+    return false;
+  }
+  if (version != BinaryPrinter::s_version)
+  {
+    return error("unsupported binary format version "
+                 + std::to_string(version) + ", expected "
+                 + std::to_string(BinaryPrinter::s_version));
+  }
+  if (!read_uint(num_kinds))
+  {
+    return false;
+  }
+  if (num_kinds != static_cast<uint64_t>(Kind::NUM_KINDS))
+  {
+    return error("binary input was written with incompatible node kinds");
+  }
+  return true;
+}
+
+bool
+Reader::read_types()
+{
+  uint64_t num_types;
+  if (!read_uint(num_types))
+  {
+    return false;
+  }
+  d_types.reserve(std::min(num_types, s_max_reserve));
+  for (uint64_t i = 0; i < num_types; ++i)
+  {
+    uint64_t tag;
+    if (!read_uint(tag))
+    {
+      return false;
+    }
+    auto num_tags = static_cast<uint64_t>(BinaryPrinter::TypeTag::NUM_TAGS);
+    switch (static_cast<BinaryPrinter::TypeTag>(std::min(tag, num_tags)))
+    {
+      case BinaryPrinter::TypeTag::BOOL:
+        d_types.push_back(d_nm.mk_bool_type());
+        break;
+
+      case BinaryPrinter::TypeTag::BV: {
+        uint64_t size;
+        if (!read_uint(size))
+        {
+          return false;
+        }
+        if (size == 0)
+        {
+          return error("invalid bit-vector type of size 0");
+        }
+        d_types.push_back(d_nm.mk_bv_type(size));
+      }
+      break;
+
+      case BinaryPrinter::TypeTag::FP: {
+        uint64_t exp_size, sig_size;
+        if (!read_uint(exp_size) || !read_uint(sig_size))
+        {
+          return false;
+        }
+        if (exp_size < 2 || sig_size < 2)
+        {
+          return error("invalid floating-point type");
+        }
+        d_types.push_back(d_nm.mk_fp_type(exp_size, sig_size));
+      }
+      break;
+
+      case BinaryPrinter::TypeTag::RM:
+        d_types.push_back(d_nm.mk_rm_type());
+        break;
+
+      case BinaryPrinter::TypeTag::ARRAY: {
+        Type index, elem;
+        if (!read_type(index) || !read_type(elem))
+        {
+          return false;
+        }
+        d_types.push_back(d_nm.mk_array_type(index, elem));
+      }
+      break;
+
+      case BinaryPrinter::TypeTag::FUN: {
+        uint64_t num;
+        if (!read_uint(num))
+        {
+          return false;
+        }
+        if (num < 2)
+        {
+          return error("invalid function type with " + std::to_string(num)
+                       + " types");
+        }
+        std::vector<Type> types;
+        for (uint64_t j = 0; j < num; ++j)
+        {
+          types.emplace_back();
+          if (!read_type(types.back()))
+          {
+            return false;
+          }
+          if (types.back().is_fun())
+          {
+            return error("invalid function type over function types");
+          }
+        }
+        d_types.push_back(d_nm.mk_fun_type(types));
+      }
+      break;
+
+      case BinaryPrinter::TypeTag::UNINTERPRETED: {
+        std::optional<std::string> symbol;
+        if (!read_symbol(symbol))
+        {
+          return false;
+        }
+        d_types.push_back(d_nm.mk_uninterpreted_type(symbol));
+      }
+      break;
+
+      default: return error("invalid type tag " + std::to_string(tag));
+    }
+  }
+  return true;
+}
+
+bool
+Reader::read_values()
+{
+  uint64_t num_values;
+  if (!read_uint(num_values))
+  {
+    return false;
+  }
+  d_nodes.reserve(std::min(num_values, s_max_reserve));
+  for (uint64_t i = 0; i < num_values; ++i)
+  {
+    Type type;
+    if (!read_type(type))
+    {
+      return false;
+    }
+    if (type.is_bool())
+    {
+      uint64_t value;
+      if (!read_uint(value))
+      {
+        return false;
+      }
+      if (value > 1)
+      {
+        return error("invalid Boolean value");
+      }
+      d_nodes.push_back(d_nm.mk_value(value == 1));
+    }
+    else if (type.is_bv())
+    {
+      BitVector bv;
+      if (!read_bv(type.bv_size(), bv))
+      {
+        return false;
+      }
+      d_nodes.push_back(d_nm.mk_value(bv));
+    }
+    else if (type.is_fp())
+    {
+      BitVector bv;
+      if (!read_bv(type.fp_ieee_bv_size(), bv))
+      {
+        return false;
+      }
+      d_nodes.push_back(d_nm.mk_value(FloatingPoint(type, bv)));
+    }
+    else if (type.is_rm())
+    {
+      uint64_t value;
+      if (!read_uint(value))
+      {
+        return false;
+      }
+      if (value >= static_cast<uint64_t>(RoundingMode::NUM_RM))
+      {
+        return error("invalid rounding mode value");
+      }
+      d_nodes.push_back(d_nm.mk_value(static_cast<RoundingMode>(value)));
+    }
+    else
+    {
+      return error("invalid value of type " + type.str());
+    }
+  }
+  return true;
+}
+
+bool
+Reader::read_nodes()
+{
+  uint64_t num_nodes;
+  if (!read_uint(num_nodes))
+  {
+    return false;
+  }
+  d_nodes.reserve(d_nodes.size() + std::min(num_nodes, s_max_reserve));
+  std::vector<Node> children;
+  std::vector<uint64_t> indices;
+  for (uint64_t i = 0; i < num_nodes; ++i)
+  {
+    uint64_t id = d_nodes.size();
+    uint64_t k;
+    if (!read_uint(k))
+    {
+      return false;
+    }
+    Kind kind = static_cast<Kind>(
+        std::min(k, static_cast<uint64_t>(Kind::NUM_KINDS)));
+    if (kind == Kind::NULL_NODE || kind == Kind::VALUE
+        || kind == Kind::NUM_KINDS)
+    {
+      return error("invalid node kind " + std::to_string(k));
+    }
+
+    if (kind == Kind::CONSTANT || kind == Kind::VARIABLE)
+    {
+      Type type;
+      std::optional<std::string> symbol;
+      if (!read_type(type) || !read_symbol(symbol))
+      {
+        return false;
+      }
+      d_nodes.push_back(kind == Kind::CONSTANT ? d_nm.mk_const(type, symbol)
+                                               : d_nm.mk_var(type, symbol));
+    }
+    else if (kind == Kind::CONST_ARRAY)
+    {
+      Type type;
+      Node elem;
+      if (!read_type(type) || !read_child(id, elem))
+      {
+        return false;
+      }
+      if (!type.is_array() || type.array_element() != elem.type())
+      {
+        return error("invalid constant array of type " + type.str());
+      }
+      d_nodes.push_back(d_nm.mk_const_array(type, elem));
+    }
+    else
+    {
+      uint64_t num_children, num_indices;
+      if (!read_uint(num_children))
+      {
+        return false;
+      }
+      children.resize(num_children);
+      for (Node& child : children)
+      {
+        if (!read_child(id, child))
+        {
+          return false;
+        }
+      }
+      if (!read_uint(num_indices))
+      {
+        return false;
+      }
+      indices.resize(num_indices);
+      for (uint64_t& index : indices)
+      {
+        if (!read_uint(index))
+        {
+          return false;
+        }
+      }
+      auto [ok, msg] = d_nm.check_type(kind, children, indices);
+      if (!ok)
+      {
+        return error(msg);
+      }
+      d_nodes.push_back(d_nm.mk_node(kind, children, indices));
+    }
+  }
+  return true;
+}
+
+bool
+Reader::read_roots()
+{
+  uint64_t num_roots;
+  if (!read_uint(num_roots))
+  {
+    return false;
+  }
+  d_roots.reserve(std::min(num_roots, s_max_reserve));
+  d_levels.reserve(std::min(num_roots, s_max_reserve));
+  for (uint64_t i = 0; i < num_roots; ++i)
+  {
+    uint64_t id, level;
+    if (!read_uint(id) || !read_uint(level))
+    {
+      return false;
+    }
+    if (id >= d_nodes.size())
+    {
+      return error("invalid node id " + std::to_string(id));
+    }
+    if (!d_levels.empty() && level < d_levels.back())
+    {
+      return error("assertion levels are not in ascending order");
+    }
+    if (level > num_roots)
+    {
+      return error("invalid assertion level " + std::to_string(level));
+    }
+    d_roots.push_back(d_nodes[id]);
+    d_levels.push_back(level);
+  }
+  return true;
+}
+
+bool
+Reader::read_type(Type& res)
+{
+  uint64_t id;
+  if (!read_uint(id))
+  {
+    return false;
+  }
+  if (id >= d_types.size())
+  {
+    return error("invalid type id " + std::to_string(id));
+  }
+  res = d_types[id];
+  return true;
+}
+
+bool
+Reader::read_child(uint64_t id, Node& res)
+{
+  uint64_t offset;
+  if (!read_uint(offset))
+  {
+    return false;
+  }
+  if (offset == 0 || offset > id)
+  {
+    return error("invalid child offset " + std::to_string(offset));
+  }
+  res = d_nodes[id - offset];
+  return true;
+}
+
+bool
+Reader::read_bv(uint64_t size, BitVector& res)
+{
+  for (uint64_t lo = 0; lo < size; lo += 64)
+  {
+    uint64_t chunk_size = std::min<uint64_t>(size - lo, 64);
+    uint64_t value;
+    if (!read_uint(value))
+    {
+      return false;
+    }
+    if (chunk_size < 64 && (value >> chunk_size) != 0)
+    {
+      return error("bit-vector value exceeds size " + std::to_string(size));
+    }
+    BitVector chunk = BitVector::from_ui(chunk_size, value);
+    res             = lo == 0 ? chunk : chunk.bvconcat(res);
+  }
+  return true;
+}
+
+bool
+Reader::read_symbol(std::optional<std::string>& res)
+{
+  uint64_t size;
+  if (!read_uint(size))
+  {
+    return false;
+  }
+  if (size == 0)
+  {
+    res = std::nullopt;
+    return true;
+  }
+  res.emplace();
+  return read_bytes(size - 1, *res);
+}
+
+bool
+Reader::read_uint(uint64_t& res)
+{
+  res = 0;
+  for (uint64_t shift = 0;; shift += 7)
+  {
+    if (d_pos == d_size && !fill())
+    {
+      return error("unexpected end of input");
+    }
+    uint8_t byte = static_cast<uint8_t>(d_buffer[d_pos++]);
+    // The 10th byte only holds the most significant bit.
+    if (shift == 63 && byte > 1)
+    {
+      return error("integer exceeds 64 bits");
+    }
+    res |= static_cast<uint64_t>(byte & 0x7f) << shift;
+    if ((byte & 0x80) == 0)
+    {
+      return true;
+    }
+  }
+}
+
+bool
+Reader::read_bytes(size_t size, std::string& res)
+{
+  res.clear();
+  while (res.size() < size)
+  {
+    if (d_pos == d_size && !fill())
+    {
+      return error("unexpected end of input");
+    }
+    size_t n = std::min(size - res.size(), d_size - d_pos);
+    res.append(d_buffer.data() + d_pos, n);
+    d_pos += n;
+  }
+  return true;
+}
+
+bool
+Reader::fill()
+{
+  d_offset += d_size;
+  d_in.read(d_buffer.data(), d_buffer.size());
+  d_size = d_in.gcount();
+  d_pos  = 0;
+  return d_size > 0;
+}
+
+bool
+Reader::error(const std::string& error_msg)
+{
+  d_error = "byte " + std::to_string(d_offset + d_pos) + ": " + error_msg;
+  return false;
+}
+
+}  // namespace bzla::parser::binary
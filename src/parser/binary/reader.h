@@ -0,0 +1,136 @@
+/***
+ * Bitwuzla: Satisfiability Modulo Theories (SMT) solver.
+ *
+ * Copyright (C) 2023 by the authors listed in the AUTHORS file at
+ * https://github.com/bitwuzla/bitwuzla/blob/main/AUTHORS
+ *
+ * This file is part of Bitwuzla under the MIT license. See COPYING for more
+ * information at https://github.com/bitwuzla/bitwuzla/blob/main/COPYING
+ */
+
+#ifndef BZLA_PARSER_BINARY_READER_H_INCLUDED
+#define BZLA_PARSER_BINARY_READER_H_INCLUDED
+
+#include <istream>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "node/node.h"
+#include "type/type.h"
+
+namespace bzla {
+
+class BitVector;
+class NodeManager;
+
+namespace parser::binary {
+
+/**
+ * Streaming reader for the Bitwuzla binary format.
+ *
+ * The input is consumed in one pass through a fixed size buffer, types and
+ * nodes are created in the node manager as soon as they are read.
+ * @see BinaryPrinter for a description of the format.
+ */
+class Reader
+{
+ public:
+  /**
+   * Constructor.
+   * @param nm The node manager to create the nodes in.
+   * @param in The input stream, must be opened in binary mode.
+   */
+  Reader(NodeManager& nm, std::istream& in);
+
+  /**
+   * Read the input.
+   * @return False on error. The error message can be queried via
+   *         `error_msg()`.
+   */
+  bool read();
+
+  /** @return The roots of the input. */
+  const std::vector<Node>& roots() const { return d_roots; }
+  /** @return The assertion levels of the roots. */
+  const std::vector<uint64_t>& levels() const { return d_levels; }
+
+  /** @return The error message. */
+  const std::string& error_msg() const { return d_error; }
+
+ private:
+  /** The size of the input buffer. */
+  static constexpr size_t s_buffer_size = 1 << 16;
+
+  /** Read the header. */
+  bool read_header();
+  /** Read the type table. */
+  bool read_types();
+  /** Read the value table. */
+  bool read_values();
+  /** Read the node table. */
+  bool read_nodes();
+  /** Read the roots. */
+  bool read_roots();
+
+  /**
+   * Read a type id.
+   * @param res Output parameter to store the type.
+   */
+  bool read_type(Type& res);
+  /**
+   * Read a child of the node with given id.
+   * @param id  The id of the node.
+   * @param res Output parameter to store the child.
+   */
+  bool read_child(uint64_t id, Node& res);
+  /** Read a bit-vector of given size. */
+  bool read_bv(uint64_t size, BitVector& res);
+  /** Read a symbol. */
+  bool read_symbol(std::optional<std::string>& res);
+  /** Read an unsigned LEB128 integer. */
+  bool read_uint(uint64_t& res);
+  /** Read given number of bytes. */
+  bool read_bytes(size_t size, std::string& res);
+  /** Refill the buffer, returns false on end of input. */
+  bool fill();
+
+  /**
+   * Set error message.
+   * @param error_msg The error message.
+   * @return Always returns false to allow using the result of this function
+   *         call to indicate a read error.
+   */
+  bool error(const std::string& error_msg);
+
+  /** The associated node manager. */
+  NodeManager& d_nm;
+  /** The input stream. */
+  std::istream& d_in;
+
+  /** The input buffer. */
+  std::vector<char> d_buffer;
+  /** The position of the next byte in the buffer. */
+  size_t d_pos = 0;
+  /** The number of valid bytes in the buffer. */
+  size_t d_size = 0;
+  /** The number of bytes consumed before the current buffer. */
+  uint64_t d_offset = 0;
+
+  /** The types of the type table. */
+  std::vector<Type> d_types;
+  /** The nodes, indexed by node id. */
+  std::vector<Node> d_nodes;
+  /** The roots. */
+  std::vector<Node> d_roots;
+  /** The assertion levels of the roots. */
+  std::vector<uint64_t> d_levels;
+
+  /** The error message in case of a read error. */
+  std::string d_error;
+};
+
+}  // namespace parser::binary
+}  // namespace bzla
+
+#endif
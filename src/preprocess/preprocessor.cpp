@@ -142,6 +142,35 @@ Preprocessor::process(const Node& term)
   return processed;
 }
 
+std::vector<Node>
+Preprocessor::process(const std::vector<Node>& terms)
+{
+  util::Timer timer(d_stats.time_process);
+  std::vector<Node> res;
+  res.reserve(terms.size());
+  for (const Node& term : terms)
+  {
+    res.push_back(d_pass_rewrite.process(term));
+  }
+  for (Node& term : res)
+  {
+    term = d_pass_variable_substitution.process(term);
+  }
+  for (Node& term : res)
+  {
+    term = d_pass_elim_lambda.process(term);
+  }
+  for (Node& term : res)
+  {
+    term = d_pass_embedded_constraints.process(term);
+  }
+  for (Node& term : res)
+  {
+    term = d_pass_rewrite.process(term);
+  }
+  return res;
+}
+
 std::vector<Node>
 Preprocessor::post_process_unsat_core(
     const std::vector<Node>& assertions,
@@ -51,6 +51,12 @@ class Preprocessor
   /** Preprocess given term based on last preprocess() call. */
   Node process(const Node& term);
 
+  /**
+   * Preprocess given terms based on last preprocess() call. Applies each
+   * pass to all terms before applying the next pass.
+   */
+  std::vector<Node> process(const std::vector<Node>& terms);
+
   /**
    * Post-process unsat core with preprocessed assertions to get unsat core in
    * terms of original assertions.
@@ -0,0 +1,350 @@
+/***
+ * Bitwuzla: Satisfiability Modulo Theories (SMT) solver.
+ *
+ * Copyright (C) 2023 by the authors listed in the AUTHORS file at
+ * https://github.com/bitwuzla/bitwuzla/blob/main/AUTHORS
+ *
+ * This file is part of Bitwuzla under the MIT license. See COPYING for more
+ * information at https://github.com/bitwuzla/bitwuzla/blob/main/COPYING
+ */
+
+#include "printer/binary_printer.h"
+
+#include <algorithm>
+
+#include "backtrack/assertion_stack.h"
+#include "bv/bitvector.h"
+#include "node/node_ref_vector.h"
+#include "node/unordered_node_ref_map.h"
+#include "solver/fp/floating_point.h"
+#include "solver/fp/rounding_mode.h"
+
+namespace bzla {
+
+using namespace node;
+
+namespace {
+/** The size of the output buffer before it is flushed. */
+constexpr size_t s_buffer_size = 1 << 16;
+}  // namespace
+
+void
+BinaryPrinter::print_formula(std::ostream& os,
+                             const backtrack::AssertionView& assertions)
+{
+  // Scopes without assertions are not stored, the stored level of an
+  // assertion is the number of non-empty scopes opened before it. The levels
+  // are thus bounded by the number of assertions.
+  std::vector<Node> roots;
+  std::vector<uint64_t> levels;
+  uint64_t level = 0;
+  for (size_t i = 0, n = assertions.size(); i < n; ++i)
+  {
+    if (i > 0 && assertions.level(i) != assertions.level(i - 1))
+    {
+      ++level;
+    }
+    roots.push_back(assertions[i]);
+    levels.push_back(level);
+  }
+  BinaryPrinter(os).print(roots, levels);
+}
+
+void
+BinaryPrinter::print(std::ostream& os, const std::vector<Node>& terms)
+{
+  BinaryPrinter(os).print(terms, std::vector<uint64_t>(terms.size(), 0));
+}
+
+/* --- BinaryPrinter private ------------------------------------------------ */
+
+BinaryPrinter::BinaryPrinter(std::ostream& os) : d_os(os) {}
+
+void
+BinaryPrinter::print(const std::vector<Node>& roots,
+                     const std::vector<uint64_t>& levels)
+{
+  assert(roots.size() == levels.size());
+
+  // Collect values and all other nodes.
+  std::vector<Node> values, nodes;
+  unordered_node_ref_map<bool> cache;
+  node_ref_vector visit(roots.begin(), roots.end());
+  while (!visit.empty())
+  {
+    const Node& cur     = visit.back();
+    auto [it, inserted] = cache.emplace(cur, false);
+    if (inserted)
+    {
+      visit.insert(visit.end(), cur.begin(), cur.end());
+      continue;
+    }
+    else if (!it->second)
+    {
+      it->second = true;
+      Kind kind  = cur.kind();
+      if (kind == Kind::VALUE)
+      {
+        add_type(cur.type());
+        values.push_back(cur);
+      }
+      else
+      {
+        if (kind == Kind::CONSTANT || kind == Kind::VARIABLE
+            || kind == Kind::CONST_ARRAY)
+        {
+          add_type(cur.type());
+        }
+        nodes.push_back(cur);
+      }
+    }
+    visit.pop_back();
+  }
+
+  // Children are always created before their parents, hence ordering by id
+  // is a topological order that additionally preserves the creation order of
+  // the constants when reading the nodes back in.
+  auto cmp = [](const Node& a, const Node& b) { return a.id() < b.id(); };
+  std::sort(values.begin(), values.end(), cmp);
+  std::sort(nodes.begin(), nodes.end(), cmp);
+
+  unordered_node_ref_map<uint64_t> ids;
+  for (const Node& value : values)
+  {
+    ids.emplace(value, ids.size());
+  }
+  for (const Node& node : nodes)
+  {
+    ids.emplace(node, ids.size());
+  }
+
+  // Header
+  d_buffer.append(s_magic, 4);
+  write_uint(s_version);
+  write_uint(static_cast<uint64_t>(Kind::NUM_KINDS));
+
+  // Types
+  write_uint(d_types.size());
+  for (const Type& type : d_types)
+  {
+    if (type.is_bool())
+    {
+      write_uint(static_cast<uint64_t>(TypeTag::BOOL));
+    }
+    else if (type.is_bv())
+    {
+      write_uint(static_cast<uint64_t>(TypeTag::BV));
+      write_uint(type.bv_size());
+    }
+    else if (type.is_fp())
+    {
+      write_uint(static_cast<uint64_t>(TypeTag::FP));
+      write_uint(type.fp_exp_size());
+      write_uint(type.fp_sig_size());
+    }
+    else if (type.is_rm())
+    {
+      write_uint(static_cast<uint64_t>(TypeTag::RM));
+    }
+    else if (type.is_array())
+    {
+      write_uint(static_cast<uint64_t>(TypeTag::ARRAY));
+      write_uint(d_type_ids.at(type.array_index()));
+      write_uint(d_type_ids.at(type.array_element()));
+    }
+    else if (type.is_fun())
+    {
+      const std::vector<Type>& types = type.fun_types();
+      write_uint(static_cast<uint64_t>(TypeTag::FUN));
+      write_uint(types.size());
+      for (const Type& t : types)
+      {
+        write_uint(d_type_ids.at(t));
+      }
+    }
+    else
+    {
+      assert(type.is_uninterpreted());
+      const auto& symbol = type.uninterpreted_symbol();
+      write_uint(static_cast<uint64_t>(TypeTag::UNINTERPRETED));
+      write_symbol(symbol ? &*symbol : nullptr);
+    }
+    flush(s_buffer_size);
+  }
+
+  // Values
+  write_uint(values.size());
+  for (const Node& value : values)
+  {
+    write_uint(d_type_ids.at(value.type()));
+    write_value(value);
+    flush(s_buffer_size);
+  }
+
+  // Nodes
+  write_uint(nodes.size());
+  for (const Node& node : nodes)
+  {
+    Kind kind   = node.kind();
+    uint64_t id = ids.at(node);
+    write_uint(static_cast<uint64_t>(kind));
+    if (kind == Kind::CONSTANT || kind == Kind::VARIABLE)
+    {
+      auto symbol = node.symbol();
+      write_uint(d_type_ids.at(node.type()));
+      write_symbol(symbol ? &symbol->get() : nullptr);
+    }
+    else if (kind == Kind::CONST_ARRAY)
+    {
+      write_uint(d_type_ids.at(node.type()));
+      write_uint(id - ids.at(node[0]));
+    }
+    else
+    {
+      write_uint(node.num_children());
+      for (const Node& child : node)
+      {
+        write_uint(id - ids.at(child));
+      }
+      write_uint(node.num_indices());
+      for (size_t i = 0, n = node.num_indices(); i < n; ++i)
+      {
+        write_uint(node.index(i));
+      }
+    }
+    flush(s_buffer_size);
+  }
+
+  // Roots
+  write_uint(roots.size());
+  for (size_t i = 0, n = roots.size(); i < n; ++i)
+  {
+    write_uint(ids.at(roots[i]));
+    write_uint(levels[i]);
+  }
+  flush();
+}
+
+void
+BinaryPrinter::add_type(const Type& type)
+{
+  if (d_type_ids.find(type) != d_type_ids.end())
+  {
+    return;
+  }
+
+  std::vector<Type> visit{type};
+  do
+  {
+    Type cur = visit.back();
+    if (d_type_ids.find(cur) != d_type_ids.end())
+    {
+      visit.pop_back();
+      continue;
+    }
+
+    // Component types are added first.
+    size_t size = visit.size();
+    if (cur.is_array())
+    {
+      for (const Type& t : {cur.array_element(), cur.array_index()})
+      {
+        if (d_type_ids.find(t) == d_type_ids.end())
+        {
+          visit.push_back(t);
+        }
+      }
+    }
+    else if (cur.is_fun())
+    {
+      for (const Type& t : cur.fun_types())
+      {
+        if (d_type_ids.find(t) == d_type_ids.end())
+        {
+          visit.push_back(t);
+        }
+      }
+    }
+    if (visit.size() == size)
+    {
+      d_type_ids.emplace(cur, d_types.size());
+      d_types.push_back(cur);
+      visit.pop_back();
+    }
+  } while (!visit.empty());
+}
+
+void
+BinaryPrinter::write_value(const Node& value)
+{
+  const Type& type = value.type();
+  if (type.is_bool())
+  {
+    write_uint(value.value<bool>() ? 1 : 0);
+  }
+  else if (type.is_bv())
+  {
+    write_bv(value.value<BitVector>());
+  }
+  else if (type.is_fp())
+  {
+    write_bv(value.value<FloatingPoint>().as_bv());
+  }
+  else
+  {
+    assert(type.is_rm());
+    write_uint(static_cast<uint64_t>(value.value<RoundingMode>()));
+  }
+}
+
+void
+BinaryPrinter::write_bv(const BitVector& bv)
+{
+  uint64_t size = bv.size();
+  if (size <= 64)
+  {
+    write_uint(bv.to_uint64());
+    return;
+  }
+  for (uint64_t lo = 0; lo < size; lo += 64)
+  {
+    uint64_t hi = std::min(lo + 64, size) - 1;
+    write_uint(bv.bvextract(hi, lo).to_uint64());
+  }
+}
+
+void
+BinaryPrinter::write_symbol(const std::string* symbol)
+{
+  if (symbol == nullptr)
+  {
+    write_uint(0);
+    return;
+  }
+  write_uint(symbol->size() + 1);
+  d_buffer.append(*symbol);
+  flush(s_buffer_size);
+}
+
+void
+BinaryPrinter::write_uint(uint64_t value)
+{
+  while (value >= 0x80)
+  {
+    d_buffer.push_back(static_cast<char>((value & 0x7f) | 0x80));
+    value >>= 7;
+  }
+  d_buffer.push_back(static_cast<char>(value));
+}
+
+void
+BinaryPrinter::flush(size_t size)
+{
+  if (d_buffer.size() > size)
+  {
+    d_os.write(d_buffer.data(), d_buffer.size());
+    d_buffer.clear();
+  }
+}
+
+}  // namespace bzla
@@ -0,0 +1,146 @@
+/***
+ * Bitwuzla: Satisfiability Modulo Theories (SMT) solver.
+ *
+ * Copyright (C) 2023 by the authors listed in the AUTHORS file at
+ * https://github.com/bitwuzla/bitwuzla/blob/main/AUTHORS
+ *
+ * This file is part of Bitwuzla under the MIT license. See COPYING for more
+ * information at https://github.com/bitwuzla/bitwuzla/blob/main/COPYING
+ */
+
+#ifndef BZLA_PRINTER_BINARY_PRINTER_H_INCLUDED
+#define BZLA_PRINTER_BINARY_PRINTER_H_INCLUDED
+
+#include <ostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "node/node.h"
+
+namespace bzla {
+
+class BitVector;
+
+namespace backtrack {
+class AssertionView;
+}
+
+/**
+ * Printer for the Bitwuzla binary format.
+ *
+ * The binary format stores a set of root terms (e.g., the assertions on the
+ * assertion stack) together with their assertion levels. It is a single
+ * sequence of unsigned LEB128 integers (varints) and raw symbol bytes without
+ * any absolute offsets, and can be read in one pass from a stream or directly
+ * from memory (e.g., a memory-mapped file).
+ *
+ * Layout:
+ *   header: the magic bytes "BZLB", the format version and the number of
+ *           node kinds (the kinds are stored by their internal value)
+ *   types:  the number of types, followed by the types in topological order,
+ *           each given as TypeTag followed by its payload:
+ *             BV            size
+ *             FP            exponent size, significand size
+ *             ARRAY         index type id, element type id
+ *             FUN           number of types, type ids (codomain last)
+ *             UNINTERPRETED symbol
+ *   values: the number of values, followed by the values, each given as its
+ *           type id followed by its payload:
+ *             Boolean        0 or 1
+ *             bit-vector     the value in 64 bit chunks, least significant
+ *                            chunk first
+ *             floating-point its IEEE-754 bit-vector representation, encoded
+ *                            as bit-vector
+ *             rounding mode  the rounding mode
+ *   nodes:  the number of nodes, followed by the nodes in topological order,
+ *           each given as its kind followed by:
+ *             CONSTANT, VARIABLE  type id, symbol
+ *             CONST_ARRAY         type id, child
+ *             otherwise           number of children, children, number of
+ *                                 indices, indices
+ *   roots:  the number of roots, followed by the roots, each given as node id
+ *           and assertion level (ascending and at most the number of roots)
+ *
+ * Values get node ids 0 to the number of values - 1 in the order of the
+ * value table, the nodes of the node table get the subsequent ids. Children
+ * are encoded as the difference between the id of the node and the id of the
+ * child. Symbols are encoded as their length + 1 followed by their bytes,
+ * where 0 denotes that no symbol is set.
+ */
+class BinaryPrinter
+{
+ public:
+  /** The magic bytes at the beginning of the binary format. */
+  static constexpr const char* s_magic = "BZLB";
+  /** The version of the binary format. */
+  static constexpr uint64_t s_version = 1;
+
+  /** The tags of the types in the type table. */
+  enum class TypeTag
+  {
+    BOOL,
+    BV,
+    FP,
+    RM,
+    ARRAY,
+    FUN,
+    UNINTERPRETED,
+    NUM_TAGS,
+  };
+
+  /**
+   * Print given assertions with their assertion levels to given stream.
+   * Scopes without assertions are omitted.
+   * @param os         The output stream.
+   * @param assertions The assertions.
+   */
+  static void print_formula(std::ostream& os,
+                            const backtrack::AssertionView& assertions);
+  /**
+   * Print given terms to given stream, all terms are at assertion level 0.
+   * @param os    The output stream.
+   * @param terms The terms.
+   */
+  static void print(std::ostream& os, const std::vector<Node>& terms);
+
+ private:
+  /**
+   * Constructor.
+   * @param os The output stream.
+   */
+  BinaryPrinter(std::ostream& os);
+
+  /**
+   * Print given root terms and their levels.
+   * @param roots  The roots.
+   * @param levels The assertion levels of the roots.
+   */
+  void print(const std::vector<Node>& roots,
+             const std::vector<uint64_t>& levels);
+
+  /** Add given type and its component types to the type table. */
+  void add_type(const Type& type);
+  /** Write value payload. */
+  void write_value(const Node& value);
+  /** Write bit-vector in 64 bit chunks. */
+  void write_bv(const BitVector& bv);
+  /** Write symbol, nullptr if no symbol is set. */
+  void write_symbol(const std::string* symbol);
+  /** Write unsigned LEB128 integer. */
+  void write_uint(uint64_t value);
+  /** Flush the buffer to the output stream if it exceeds `size` bytes. */
+  void flush(size_t size = 0);
+
+  /** The output stream. */
+  std::ostream& d_os;
+  /** The output buffer. */
+  std::string d_buffer;
+  /** Maps types to their id. */
+  std::unordered_map<Type, uint64_t> d_type_ids;
+  /** The types in topological order. */
+  std::vector<Type> d_types;
+};
+
+}  // namespace bzla
+#endif
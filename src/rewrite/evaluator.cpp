@@ -10,13 +10,479 @@
 
 #include "rewrite/evaluator.h"
 
+#include "bv/bitvector.h"
+#include "node/kind_info.h"
 #include "node/node_manager.h"
+#include "node/node_ref_vector.h"
 #include "solver/fp/floating_point.h"
 
 namespace bzla {
 
 using namespace node;
 
+namespace {
+
+/** @return True if given kind has a Boolean result. */
+bool
+is_bool_result(Kind kind)
+{
+  switch (kind)
+  {
+    case Kind::EQUAL:
+    case Kind::DISTINCT:
+    case Kind::AND:
+    case Kind::IMPLIES:
+    case Kind::NOT:
+    case Kind::OR:
+    case Kind::XOR:
+    case Kind::BV_NEGO:
+    case Kind::BV_SADDO:
+    case Kind::BV_SDIVO:
+    case Kind::BV_SGE:
+    case Kind::BV_SGT:
+    case Kind::BV_SLE:
+    case Kind::BV_SLT:
+    case Kind::BV_SMULO:
+    case Kind::BV_SSUBO:
+    case Kind::BV_UADDO:
+    case Kind::BV_UGE:
+    case Kind::BV_UGT:
+    case Kind::BV_ULE:
+    case Kind::BV_ULT:
+    case Kind::BV_UMULO:
+    case Kind::BV_USUBO: return true;
+    default: return false;
+  }
+}
+
+/**
+ * @return The size of the result of a Boolean or bit-vector operator applied
+ *         to operands of given sizes.
+ */
+uint64_t
+result_size(Kind kind,
+            const std::vector<uint64_t>& sizes,
+            const std::vector<uint64_t>& indices)
+{
+  if (is_bool_result(kind))
+  {
+    return 1;
+  }
+  switch (kind)
+  {
+    case Kind::ITE: return sizes[1];
+    case Kind::BV_COMP:
+    case Kind::BV_REDAND:
+    case Kind::BV_REDOR:
+    case Kind::BV_REDXOR: return 1;
+    case Kind::BV_CONCAT: return sizes[0] + sizes[1];
+    case Kind::BV_EXTRACT: return indices[0] - indices[1] + 1;
+    case Kind::BV_REPEAT: return sizes[0] * indices[0];
+    case Kind::BV_SIGN_EXTEND:
+    case Kind::BV_ZERO_EXTEND: return sizes[0] + indices[0];
+    default: return sizes[0];
+  }
+}
+
+/** @return The mask for the lower `size` bits of a word. */
+uint64_t
+mask(uint64_t size)
+{
+  return size >= 64 ? ~uint64_t(0) : (uint64_t(1) << size) - 1;
+}
+
+/** @return The value of given size, sign-extended to 64 bits. */
+int64_t
+to_signed(uint64_t value, uint64_t size)
+{
+  uint64_t shift = 64 - size;
+  return static_cast<int64_t>(value << shift) >> shift;
+}
+
+/** @return True if given signed value is representable with `size` bits. */
+bool
+fits_signed(int64_t value, uint64_t size)
+{
+  return to_signed(static_cast<uint64_t>(value) & mask(size), size) == value;
+}
+
+}  // namespace
+
+uint64_t
+Evaluator::evaluate_native(Kind kind,
+                           const std::vector<uint64_t>& values,
+                           const std::vector<uint64_t>& sizes,
+                           const std::vector<uint64_t>& indices)
+{
+  uint64_t size = sizes[0];
+  uint64_t m    = mask(size);
+  uint64_t a    = values[0];
+  uint64_t b    = values.size() > 1 ? values[1] : 0;
+  bool msb_a    = (a >> (size - 1)) & 1;
+  bool msb_b    = values.size() > 1 && ((b >> (sizes[1] - 1)) & 1);
+
+  auto neg  = [m](uint64_t x) { return (~x + 1) & m; };
+  auto udiv = [m](uint64_t x, uint64_t y) { return y == 0 ? m : x / y; };
+  auto urem = [](uint64_t x, uint64_t y) { return y == 0 ? x : x % y; };
+
+  switch (kind)
+  {
+    case Kind::EQUAL:
+    case Kind::BV_COMP: return a == b;
+    case Kind::DISTINCT:
+      for (size_t i = 0, n = values.size(); i < n; ++i)
+      {
+        for (size_t j = i + 1; j < n; ++j)
+        {
+          if (values[i] == values[j])
+          {
+            return 0;
+          }
+        }
+      }
+      return 1;
+    case Kind::ITE: return a ? b : values[2];
+
+    case Kind::NOT:
+    case Kind::BV_NOT: return ~a & m;
+    case Kind::AND:
+    case Kind::BV_AND: return a & b;
+    case Kind::OR:
+    case Kind::BV_OR: return a | b;
+    case Kind::XOR:
+    case Kind::BV_XOR: return a ^ b;
+    case Kind::IMPLIES: return (~a | b) & 1;
+    case Kind::BV_NAND: return ~(a & b) & m;
+    case Kind::BV_NOR: return ~(a | b) & m;
+    case Kind::BV_XNOR: return ~(a ^ b) & m;
+
+    case Kind::BV_ADD: return (a + b) & m;
+    case Kind::BV_SUB: return (a - b) & m;
+    case Kind::BV_MUL: return (a * b) & m;
+    case Kind::BV_NEG: return neg(a);
+    case Kind::BV_INC: return (a + 1) & m;
+    case Kind::BV_DEC: return (a - 1) & m;
+    case Kind::BV_UDIV: return udiv(a, b);
+    case Kind::BV_UREM: return urem(a, b);
+    case Kind::BV_SDIV: {
+      uint64_t res = udiv(msb_a ? neg(a) : a, msb_b ? neg(b) : b);
+      return msb_a != msb_b ? neg(res) : res;
+    }
+    case Kind::BV_SREM: {
+      uint64_t res = urem(msb_a ? neg(a) : a, msb_b ? neg(b) : b);
+      return msb_a ? neg(res) : res;
+    }
+    case Kind::BV_SMOD: {
+      uint64_t res = urem(msb_a ? neg(a) : a, msb_b ? neg(b) : b);
+      if (res == 0 || (!msb_a && !msb_b))
+      {
+        return res;
+      }
+      if (msb_a && !msb_b)
+      {
+        return (neg(res) + b) & m;
+      }
+      if (!msb_a)
+      {
+        return (res + b) & m;
+      }
+      return neg(res);
+    }
+
+    case Kind::BV_SHL: return b >= size ? 0 : (a << b) & m;
+    case Kind::BV_SHR: return b >= size ? 0 : a >> b;
+    case Kind::BV_ASHR:
+      if (b >= size)
+      {
+        return msb_a ? m : 0;
+      }
+      return static_cast<uint64_t>(to_signed(a, size) >> b) & m;
+
+    case Kind::BV_ULT: return a < b;
+    case Kind::BV_ULE: return a <= b;
+    case Kind::BV_UGT: return a > b;
+    case Kind::BV_UGE: return a >= b;
+    case Kind::BV_SLT: return to_signed(a, size) < to_signed(b, size);
+    case Kind::BV_SLE: return to_signed(a, size) <= to_signed(b, size);
+    case Kind::BV_SGT: return to_signed(a, size) > to_signed(b, size);
+    case Kind::BV_SGE: return to_signed(a, size) >= to_signed(b, size);
+
+    case Kind::BV_CONCAT: return (a << sizes[1]) | b;
+    case Kind::BV_EXTRACT:
+      return (a >> indices[1]) & mask(indices[0] - indices[1] + 1);
+    case Kind::BV_ZERO_EXTEND: return a;
+    case Kind::BV_SIGN_EXTEND:
+      return static_cast<uint64_t>(to_signed(a, size))
+             & mask(size + indices[0]);
+    case Kind::BV_REPEAT: {
+      uint64_t res = a;
+      for (uint64_t i = 1; i < indices[0]; ++i)
+      {
+        res = (res << size) | a;
+      }
+      return res;
+    }
+
+    case Kind::BV_REDAND: return a == m;
+    case Kind::BV_REDOR: return a != 0;
+    case Kind::BV_REDXOR: return __builtin_popcountll(a) & 1;
+
+    case Kind::BV_ROL:
+    case Kind::BV_ROLI:
+    case Kind::BV_ROR:
+    case Kind::BV_RORI: {
+      uint64_t shift =
+          (kind == Kind::BV_ROLI || kind == Kind::BV_RORI ? indices[0] : b)
+          % size;
+      if (kind == Kind::BV_ROR || kind == Kind::BV_RORI)
+      {
+        shift = (size - shift) % size;
+      }
+      return shift == 0 ? a : ((a << shift) | (a >> (size - shift))) & m;
+    }
+
+    case Kind::BV_UADDO: return ((a + b) & m) < a;
+    case Kind::BV_USUBO: return a < b;
+    case Kind::BV_UMULO: {
+      uint64_t res;
+      return __builtin_mul_overflow(a, b, &res) || res > m;
+    }
+    case Kind::BV_SADDO: {
+      int64_t res;
+      return __builtin_add_overflow(
+                 to_signed(a, size), to_signed(b, size), &res)
+             || !fits_signed(res, size);
+    }
+    case Kind::BV_SSUBO: {
+      int64_t res;
+      return __builtin_sub_overflow(
+                 to_signed(a, size), to_signed(b, size), &res)
+             || !fits_signed(res, size);
+    }
+    case Kind::BV_SMULO: {
+      int64_t res;
+      return __builtin_mul_overflow(
+                 to_signed(a, size), to_signed(b, size), &res)
+             || !fits_signed(res, size);
+    }
+    case Kind::BV_NEGO: return a == (uint64_t(1) << (size - 1));
+    case Kind::BV_SDIVO: return a == (uint64_t(1) << (size - 1)) && b == m;
+
+    default: assert(false);
+  }
+  return 0;
+}
+
+BitVector
+Evaluator::evaluate_bv(Kind kind,
+                       const std::vector<BitVector>& values,
+                       const std::vector<uint64_t>& indices)
+{
+  const BitVector& a = values[0];
+  const BitVector& b = values.size() > 1 ? values[1] : values[0];
+  uint64_t size      = a.size();
+
+  switch (kind)
+  {
+    case Kind::EQUAL:
+    case Kind::BV_COMP: return a.bveq(b);
+    case Kind::DISTINCT:
+      for (size_t i = 0, n = values.size(); i < n; ++i)
+      {
+        for (size_t j = i + 1; j < n; ++j)
+        {
+          if (values[i] == values[j])
+          {
+            return BitVector::mk_false();
+          }
+        }
+      }
+      return BitVector::mk_true();
+    case Kind::ITE: return a.is_true() ? b : values[2];
+
+    case Kind::NOT:
+    case Kind::BV_NOT: return a.bvnot();
+    case Kind::AND:
+    case Kind::BV_AND: return a.bvand(b);
+    case Kind::OR:
+    case Kind::BV_OR: return a.bvor(b);
+    case Kind::XOR:
+    case Kind::BV_XOR: return a.bvxor(b);
+    case Kind::IMPLIES: return a.bvimplies(b);
+    case Kind::BV_NAND: return a.bvnand(b);
+    case Kind::BV_NOR: return a.bvnor(b);
+    case Kind::BV_XNOR: return a.bvxnor(b);
+
+    case Kind::BV_ADD: return a.bvadd(b);
+    case Kind::BV_SUB: return a.bvsub(b);
+    case Kind::BV_MUL: return a.bvmul(b);
+    case Kind::BV_NEG: return a.bvneg();
+    case Kind::BV_INC: return a.bvinc();
+    case Kind::BV_DEC: return a.bvdec();
+    case Kind::BV_UDIV: return a.bvudiv(b);
+    case Kind::BV_UREM: return a.bvurem(b);
+    case Kind::BV_SDIV: return a.bvsdiv(b);
+    case Kind::BV_SREM: return a.bvsrem(b);
+    case Kind::BV_SMOD: {
+      BitVector res = (a.msb() ? a.bvneg() : a).bvurem(b.msb() ? b.bvneg() : b);
+      if (res.is_zero() || (!a.msb() && !b.msb()))
+      {
+        return res;
+      }
+      if (a.msb() && !b.msb())
+      {
+        return res.bvneg().bvadd(b);
+      }
+      if (!a.msb())
+      {
+        return res.bvadd(b);
+      }
+      return res.bvneg();
+    }
+
+    case Kind::BV_SHL: return a.bvshl(b);
+    case Kind::BV_SHR: return a.bvshr(b);
+    case Kind::BV_ASHR: return a.bvashr(b);
+
+    case Kind::BV_ULT: return a.bvult(b);
+    case Kind::BV_ULE: return a.bvule(b);
+    case Kind::BV_UGT: return a.bvugt(b);
+    case Kind::BV_UGE: return a.bvuge(b);
+    case Kind::BV_SLT: return a.bvslt(b);
+    case Kind::BV_SLE: return a.bvsle(b);
+    case Kind::BV_SGT: return a.bvsgt(b);
+    case Kind::BV_SGE: return a.bvsge(b);
+
+    case Kind::BV_CONCAT: return a.bvconcat(b);
+    case Kind::BV_EXTRACT: return a.bvextract(indices[0], indices[1]);
+    case Kind::BV_ZERO_EXTEND: return a.bvzext(indices[0]);
+    case Kind::BV_SIGN_EXTEND: return a.bvsext(indices[0]);
+    case Kind::BV_REPEAT: {
+      BitVector res = a;
+      for (uint64_t i = 1; i < indices[0]; ++i)
+      {
+        res.ibvconcat(a);
+      }
+      return res;
+    }
+
+    case Kind::BV_REDAND: return a.bvredand();
+    case Kind::BV_REDOR: return a.bvredor();
+    case Kind::BV_REDXOR: {
+      bool res = false;
+      for (uint64_t i = 0; i < size; ++i)
+      {
+        res ^= a.bit(i);
+      }
+      return BitVector::from_ui(1, res);
+    }
+
+    case Kind::BV_ROL:
+    case Kind::BV_ROLI:
+    case Kind::BV_ROR:
+    case Kind::BV_RORI: {
+      uint64_t shift =
+          kind == Kind::BV_ROLI || kind == Kind::BV_RORI
+              ? indices[0] % size
+              : b.bvurem(BitVector::from_ui(size, size)).to_uint64(true);
+      if (kind == Kind::BV_ROR || kind == Kind::BV_RORI)
+      {
+        shift = (size - shift) % size;
+      }
+      if (shift == 0)
+      {
+        return a;
+      }
+      return a.bvextract(size - shift - 1, 0)
+          .bvconcat(a.bvextract(size - 1, size - shift));
+    }
+
+    case Kind::BV_UADDO: return BitVector::from_ui(1, a.is_uadd_overflow(b));
+    case Kind::BV_USUBO: return a.bvult(b);
+    case Kind::BV_UMULO: return BitVector::from_ui(1, a.is_umul_overflow(b));
+    case Kind::BV_SADDO:
+      return BitVector::from_ui(
+          1, a.msb() == b.msb() && a.bvadd(b).msb() != a.msb());
+    case Kind::BV_SSUBO:
+      return BitVector::from_ui(
+          1, a.msb() != b.msb() && a.bvsub(b).msb() != a.msb());
+    case Kind::BV_SMULO: {
+      BitVector res = a.bvsext(size).bvmul(b.bvsext(size));
+      return BitVector::from_ui(
+          1, res != res.bvextract(size - 1, 0).bvsext(size));
+    }
+    case Kind::BV_NEGO: return BitVector::from_ui(1, a.is_min_signed());
+    case Kind::BV_SDIVO:
+      return BitVector::from_ui(1, a.is_min_signed() && b.is_ones());
+
+    default: assert(false);
+  }
+  return BitVector();
+}
+
+namespace {
+
+/** @return The size of a Boolean or bit-vector type. */
+uint64_t
+size_of(const Type& type)
+{
+  return type.is_bool() ? 1 : type.bv_size();
+}
+
+/**
+ * Evaluate Boolean or bit-vector operator on value nodes, on machine words
+ * if possible.
+ */
+Node
+evaluate_bool_bv(NodeManager& nm,
+                 Kind kind,
+                 const std::vector<Node>& values,
+                 const std::vector<uint64_t>& indices)
+{
+  std::vector<uint64_t> sizes;
+  bool native = true;
+  for (const Node& value : values)
+  {
+    sizes.push_back(size_of(value.type()));
+    native = native && sizes.back() <= 64;
+  }
+  uint64_t size = result_size(kind, sizes, indices);
+  bool is_bool  = is_bool_result(kind);
+
+  if (native && size <= 64)
+  {
+    std::vector<uint64_t> args;
+    for (const Node& value : values)
+    {
+      args.push_back(value.type().is_bool()
+                         ? value.value<bool>()
+                         : value.value<BitVector>().to_uint64());
+    }
+    uint64_t res = Evaluator::evaluate_native(kind, args, sizes, indices);
+    if (is_bool)
+    {
+      return nm.mk_value(res != 0);
+    }
+    return nm.mk_value(BitVector::from_ui(size, res));
+  }
+
+  std::vector<BitVector> args;
+  for (const Node& value : values)
+  {
+    args.push_back(value.type().is_bool()
+                       ? BitVector::from_ui(1, value.value<bool>())
+                       : value.value<BitVector>());
+  }
+  BitVector res = Evaluator::evaluate_bv(kind, args, indices);
+  if (is_bool)
+  {
+    return nm.mk_value(res.is_true());
+  }
+  return nm.mk_value(res);
+}
+
+}  // namespace
+
 Node
 Evaluator::evaluate(NodeManager& nm,
                     Kind kind,
@@ -25,9 +491,20 @@ Evaluator::evaluate(NodeManager& nm,
 {
   switch (kind)
   {
-    // TODO: bool
-    // TODO: bit-vectors
     case Kind::EQUAL: return nm.mk_value(values[0] == values[1]);
+    case Kind::DISTINCT:
+      for (size_t i = 0, n = values.size(); i < n; ++i)
+      {
+        for (size_t j = i + 1; j < n; ++j)
+        {
+          if (values[i] == values[j])
+          {
+            return nm.mk_value(false);
+          }
+        }
+      }
+      return nm.mk_value(true);
+    case Kind::ITE: return values[0].value<bool>() ? values[1] : values[2];
     case Kind::FP_IS_INF:
       return nm.mk_value(values[0].value<FloatingPoint>().fpisinf());
     case Kind::FP_IS_NAN:
@@ -98,9 +575,156 @@ Evaluator::evaluate(NodeManager& nm,
                                        values[0].value<RoundingMode>(),
                                        values[1].value<BitVector>(),
                                        false));
-    default: std::cerr << kind << std::endl; assert(false);
+    default:
+      assert(KindInfo::is_bool(kind) || KindInfo::is_bv(kind));
+      return evaluate_bool_bv(nm, kind, values, indices);
   }
   return Node();
 }
 
+Node
+Evaluator::evaluate(NodeManager& nm,
+                    const Node& term,
+                    const std::unordered_map<Node, Node>& model)
+{
+  // Values of size <= 64 are stored in `d_native`, others in `d_bv`.
+  struct Value
+  {
+    uint64_t d_native = 0;
+    BitVector d_bv;
+    bool d_done = false;
+  };
+  std::unordered_map<Node, Value> cache;
+  std::vector<uint64_t> native_args, sizes;
+  std::vector<BitVector> bv_args;
+
+  node::node_ref_vector visit{term};
+  do
+  {
+    const Node& cur     = visit.back();
+    auto [it, inserted] = cache.emplace(cur, Value());
+    if (inserted)
+    {
+      const Type& type = cur.type();
+      if (!type.is_bool() && !type.is_bv())
+      {
+        return Node();
+      }
+      Node value;
+      if (cur.is_value())
+      {
+        value = cur;
+      }
+      else if (cur.is_const())
+      {
+        auto mit = model.find(cur);
+        if (mit == model.end())
+        {
+          return Node();
+        }
+        value = mit->second;
+      }
+      else if (is_bool_bv_op(cur))
+      {
+        visit.insert(visit.end(), cur.begin(), cur.end());
+        continue;
+      }
+      else
+      {
+        return Node();
+      }
+      assert(value.is_value());
+      if (type.is_bool())
+      {
+        it->second.d_native = value.value<bool>();
+      }
+      else if (type.bv_size() <= 64)
+      {
+        it->second.d_native = value.value<BitVector>().to_uint64();
+      }
+      else
+      {
+        it->second.d_bv = value.value<BitVector>();
+      }
+      it->second.d_done = true;
+    }
+    else if (!it->second.d_done)
+    {
+      Kind kind = cur.kind();
+      sizes.clear();
+      bool native = true;
+      for (const Node& child : cur)
+      {
+        sizes.push_back(size_of(child.type()));
+        native = native && sizes.back() <= 64;
+      }
+      uint64_t size = size_of(cur.type());
+      Value& res    = it->second;
+      if (native && size <= 64)
+      {
+        native_args.clear();
+        for (const Node& child : cur)
+        {
+          native_args.push_back(cache.at(child).d_native);
+        }
+        res.d_native =
+            evaluate_native(kind, native_args, sizes, cur.indices());
+      }
+      else
+      {
+        bv_args.clear();
+        for (size_t i = 0, n = cur.num_children(); i < n; ++i)
+        {
+          const Value& value = cache.at(cur[i]);
+          bv_args.push_back(sizes[i] <= 64
+                                ? BitVector::from_ui(sizes[i], value.d_native)
+                                : value.d_bv);
+        }
+        BitVector bv = evaluate_bv(kind, bv_args, cur.indices());
+        if (size <= 64)
+        {
+          res.d_native = bv.to_uint64();
+        }
+        else
+        {
+          res.d_bv = std::move(bv);
+        }
+      }
+      res.d_done = true;
+    }
+    visit.pop_back();
+  } while (!visit.empty());
+
+  const Value& value = cache.at(term);
+  if (term.type().is_bool())
+  {
+    return nm.mk_value(value.d_native != 0);
+  }
+  uint64_t size = term.type().bv_size();
+  if (size <= 64)
+  {
+    return nm.mk_value(BitVector::from_ui(size, value.d_native));
+  }
+  return nm.mk_value(value.d_bv);
+}
+
+bool
+Evaluator::is_bool_bv_op(const Node& node)
+{
+  Kind kind = node.kind();
+  if (KindInfo::is_bool(kind) || KindInfo::is_bv(kind))
+  {
+    return true;
+  }
+  if (kind == Kind::EQUAL || kind == Kind::DISTINCT)
+  {
+    return node[0].type().is_bool() || node[0].type().is_bv();
+  }
+  if (kind == Kind::ITE)
+  {
+    return node.type().is_bool() || node.type().is_bv();
+  }
+  return false;
+}
+
 }  // namespace bzla
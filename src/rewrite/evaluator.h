@@ -8,17 +8,88 @@
  * information at https://github.com/bitwuzla/bitwuzla/blob/main/COPYING
  */
 
+#ifndef BZLA_REWRITE_EVALUATOR_H_INCLUDED
+#define BZLA_REWRITE_EVALUATOR_H_INCLUDED
+
+#include <unordered_map>
+#include <vector>
+
 #include "node/node.h"
 
 namespace bzla {
 
+class BitVector;
+class NodeManager;
+
+/**
+ * Evaluator for operators applied to values.
+ *
+ * Boolean and bit-vector operators are evaluated on machine words if the
+ * operands and the result are of size <= 64, and on BitVector otherwise.
+ * Booleans are treated as bit-vectors of size one.
+ */
 class Evaluator
 {
  public:
+  /**
+   * Evaluate operator on values.
+   * @param nm      The node manager used to create the resulting value.
+   * @param kind    The kind of the operator.
+   * @param values  The operands, must be values.
+   * @param indices The indices of the operator.
+   * @return The resulting value.
+   */
   static Node evaluate(NodeManager& nm,
                        node::Kind kind,
                        const std::vector<Node>& values,
                        const std::vector<uint64_t>& indices = {});
+
+  /**
+   * Evaluate Boolean or bit-vector term. Values of intermediate terms are
+   * not created as nodes.
+   * @param nm    The node manager used to create the resulting value.
+   * @param term  The term to evaluate.
+   * @param model Maps the constants in `term` to their values.
+   * @return The value of `term`, or a null node if `term` contains subterms
+   *         that are not Boolean or bit-vector operators, values or
+   *         constants in `model`.
+   */
+  static Node evaluate(NodeManager& nm,
+                       const Node& term,
+                       const std::unordered_map<Node, Node>& model);
+
+  /**
+   * @return True if given node is a Boolean or bit-vector operator, i.e.,
+   *         the node can be evaluated on machine words or BitVector.
+   */
+  static bool is_bool_bv_op(const Node& node);
+
+  /**
+   * Evaluate Boolean or bit-vector operator on machine words. The operands
+   * and the result must be of size <= 64.
+   * @param kind    The kind of the operator.
+   * @param values  The operands, Booleans are 0 or 1.
+   * @param sizes   The sizes of the operands.
+   * @param indices The indices of the operator.
+   * @return The result, Booleans are 0 or 1.
+   */
+  static uint64_t evaluate_native(node::Kind kind,
+                                  const std::vector<uint64_t>& values,
+                                  const std::vector<uint64_t>& sizes,
+                                  const std::vector<uint64_t>& indices);
+
+  /**
+   * Evaluate Boolean or bit-vector operator on bit-vectors.
+   * @param kind    The kind of the operator.
+   * @param values  The operands, Booleans are bit-vectors of size one.
+   * @param indices The indices of the operator.
+   * @return The result, Booleans are bit-vectors of size one.
+   */
+  static BitVector evaluate_bv(node::Kind kind,
+                               const std::vector<BitVector>& values,
+                               const std::vector<uint64_t>& indices);
 };
 
 }  // namespace bzla
+
+#endif
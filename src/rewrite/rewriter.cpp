@@ -21,17 +21,17 @@
 #include "rewrite/rewrites_bv.h"
 #include "rewrite/rewrites_fp.h"
 #include "util/logger.h"
-
-#define BZLA_APPLY_RW_RULE(rw_rule)                                \
-  do                                                               \
-  {                                                                \
-    std::tie(res, kind) =                                          \
-        RewriteRule<RewriteRuleKind::rw_rule>::apply(*this, node); \
-    if (res != node)                                               \
-    {                                                              \
-      d_stats_rewrites << kind;                                    \
-      goto DONE;                                                   \
-    }                                                              \
+#include "util/resources.h"
+
+#define BZLA_APPLY_RW_RULE(rw_rule)                                   \
+  do                                                                  \
+  {                                                                   \
+    std::tie(res, kind) = apply_rule<RewriteRuleKind::rw_rule>(node); \
+    if (res != node)                                                  \
+    {                                                                 \
+      d_stats_rewrites << kind;                                       \
+      goto DONE;                                                      \
+    }                                                                 \
   } while (false);
 
 #define BZLA_ELIM_KIND_IMPL(name, rule)           \
@@ -92,63 +92,36 @@ diff(uint64_t max_id, const Node& rewritten)
 
 /* === Rewriter public ====================================================== */
 
-Rewriter::Rewriter(Env& env, uint8_t level)
+Rewriter::Rewriter(Env& env, uint8_t level, uint64_t cache_size, bool profile)
     : d_env(env),
       d_logger(env.logger()),
       d_level(level),
+      d_cache_limit(cache_size),
       d_stats_rewrites(env.statistics().new_stat<util::HistogramStatistic>(
-          "rewriter::rewrite"))
+          "rewriter::rewrite")),
+      d_stats_evicted(
+          env.statistics().new_stat<uint64_t>("rewriter::cache::num_evicted"))
 {
   assert(d_level <= option::Options::REWRITE_LEVEL_MAX);
-  (void) d_env;  // only used in debug mode
+  if (profile)
+  {
+    d_profile.reset(new RuleProfile(env.statistics()));
+  }
 }
 
-const Node&
+Rewriter::~Rewriter() {}
+
+Node
 Rewriter::rewrite(const Node& node)
 {
-  node::node_ref_vector visit{node};
-  do
+  if (!d_in_rewrite)
   {
-    const Node& cur = visit.back();
-    auto [it, inserted] = d_cache.emplace(cur, Node());
-    if (inserted)
-    {
-      visit.insert(visit.end(), cur.begin(), cur.end());
-      continue;
-    }
-    else if (it->second.is_null())
-    {
-      if (cur.num_children())
-      {
-#ifndef NDEBUG
-        // Reset nodes counter
-        d_num_nodes = 0;
-        // Save current maximum node id
-        int64_t max_id = d_env.nm().max_node_id();
-#endif
-        it->second = _rewrite(node::utils::rebuild_node(nm(), cur, d_cache));
-#ifndef NDEBUG
-        uint64_t thresh = d_env.options().dbg_rw_node_thresh();
-        if (thresh > 0 && d_num_nodes > 0)
-        {
-          auto [new_nodes, depth] = diff(max_id, it->second);
-          Warn(new_nodes >= thresh) << "_rewrite() introduced " << new_nodes
-                                    << " new nodes up to depth " << depth;
-        }
-#endif
-      }
-      else
-      {
-        it->second = cur;
-      }
-    }
-    visit.pop_back();
-  } while (!visit.empty());
-  assert(d_cache.find(node) != d_cache.end());
-  return d_cache.at(node);
+    evict();
+  }
+  return _rewrite(node);
 }
 
-const Node&
+Node
 Rewriter::mk_node(node::Kind kind,
                   const std::vector<Node>& children,
                   const std::vector<uint64_t>& indices)
@@ -157,24 +130,22 @@ Rewriter::mk_node(node::Kind kind,
   uint64_t max_id = d_env.nm().max_node_id();
 #endif
   Node node = d_env.nm().mk_node(kind, children, indices);
-  ++d_num_rec_calls;
+  // Nodes created by rewrite rules applied in _rewrite() are rewritten by
+  // _rewrite() after the rule returned.
+  if (d_in_rewrite)
+  {
 #ifndef NDEBUG
-  auto [it, inserted] = d_rec_cache.insert(node);
-  assert(inserted);  // Rewrite cycle detected if this fails.
+    if (node.id() >= max_id)
+    {
+      ++d_num_nodes;
+    }
 #endif
-  const Node& res = _rewrite(node);
-#ifndef NDEBUG
-  if (res.id() >= max_id)
-  {
-    ++d_num_nodes;
+    return node;
   }
-  d_rec_cache.erase(node);
-#endif
-  --d_num_rec_calls;
-  return res;
+  return rewrite(node);
 }
 
-const Node&
+Node
 Rewriter::invert_node(const Node& node)
 {
   assert(node.type().is_bool() || node.type().is_bv());
@@ -185,7 +156,7 @@ Rewriter::invert_node(const Node& node)
   return mk_node(node::Kind::BV_NOT, {node});
 }
 
-const Node&
+Node
 Rewriter::invert_node_if(bool condition, const Node& node)
 {
   assert(node.type().is_bool() || node.type().is_bv());
@@ -349,7 +320,74 @@ Rewriter::is_bv_xnor(const Node& node, Node& child0, Node& child1)
 void
 Rewriter::clear_cache()
 {
-  d_cache.clear();
+  std::vector<CacheEntry>().swap(d_cache);
+  d_cache_size = 0;
+}
+
+Rewriter::CacheEntry&
+Rewriter::cache_entry(const Node& node)
+{
+  assert(!node.is_null());
+  uint64_t id = node.id();
+  if (id >= d_cache.size())
+  {
+    d_cache.resize(id + 1);
+  }
+  return d_cache[id];
+}
+
+void
+Rewriter::cache(const Node& node, const Node& rewritten)
+{
+  CacheEntry& entry = cache_entry(node);
+  if (entry.d_rewritten.is_null())
+  {
+    ++d_cache_size;
+  }
+  entry.d_rewritten  = rewritten;
+  entry.d_generation = d_generation;
+}
+
+void
+Rewriter::evict()
+{
+  assert(!d_in_rewrite);
+  if (d_cache_limit > 0 && d_cache_size > d_cache_limit)
+  {
+    uint64_t size = d_cache_size;
+    // Evict entries that were not accessed in the current generation, and
+    // clear the cache if that does not suffice.
+    d_cache_size = 0;
+    for (CacheEntry& entry : d_cache)
+    {
+      if (!entry.d_rewritten.is_null() && entry.d_generation == d_generation)
+      {
+        ++d_cache_size;
+      }
+      else
+      {
+        entry = CacheEntry();
+      }
+    }
+    if (d_cache_size > d_cache_limit)
+    {
+      clear_cache();
+    }
+    else
+    {
+      // Release the memory of evicted entries with the highest ids.
+      while (!d_cache.empty() && d_cache.back().d_rewritten.is_null())
+      {
+        d_cache.pop_back();
+      }
+      if (d_cache.size() < d_cache.capacity() / 2)
+      {
+        d_cache.shrink_to_fit();
+      }
+    }
+    d_stats_evicted += size - d_cache_size;
+  }
+  ++d_generation;
 }
 
 NodeManager&
@@ -360,30 +398,178 @@ Rewriter::nm()
 
 /* === Rewriter private ===================================================== */
 
-const Node&
-Rewriter::_rewrite(const Node& node)
+Rewriter::RuleProfile::RuleProfile(util::Statistics& stats)
+    : d_attempts(stats.new_stat<util::HistogramStatistic>(
+          "rewriter::profile::attempts")),
+      d_successes(stats.new_stat<util::HistogramStatistic>(
+          "rewriter::profile::successes")),
+      d_cycles(stats.new_stat<util::HistogramStatistic>(
+          "rewriter::profile::cycles")),
+      d_nodes(
+          stats.new_stat<util::HistogramStatistic>("rewriter::profile::nodes"))
 {
-  // Lookup rewrite cache
-  auto [it, inserted] = d_cache.emplace(node, Node());
-  if (!inserted && !it->second.is_null())
+}
+
+template <RewriteRuleKind K>
+std::pair<Node, RewriteRuleKind>
+Rewriter::apply_rule(const Node& node)
+{
+  if (!d_profile)
   {
-    return it->second;
+    return RewriteRule<K>::apply(*this, node);
   }
-
-  // Limit rewrite recursion depth if we run into rewrite cycles in production
-  // mode. Ideally, this should not happen, but if it does, we do not crash.
-  if (d_num_rec_calls >= RECURSION_LIMIT)
+  uint64_t max_id = d_env.nm().max_node_id();
+  uint64_t start  = util::cycle_count();
+  auto res        = RewriteRule<K>::apply(*this, node);
+  d_profile->d_cycles.add(K, util::cycle_count() - start);
+  d_profile->d_nodes.add(K, d_env.nm().max_node_id() - max_id);
+  d_profile->d_attempts << K;
+  if (res.first != node)
   {
-    assert(false);
-    d_recursion_limit_reached = true;
-    it->second                = node;
-    return it->second;
+    d_profile->d_successes << K;
   }
+  return res;
+}
+
+Node
+Rewriter::_rewrite(const Node& node)
+{
+  bool in_rewrite = d_in_rewrite;
+  d_in_rewrite    = true;
 
-  // Normalize before rewriting
-  Node n = normalize_commutative(node);
+  std::vector<RewriteFrame> visit{{node, Node(), 0}};
+  do
+  {
+    RewriteFrame& frame = visit.back();
+    CacheEntry& entry   = cache_entry(frame.d_node);
+    if (!entry.d_rewritten.is_null())
+    {
+      entry.d_generation = d_generation;
+      visit.pop_back();
+      continue;
+    }
 
+    if (!frame.d_result.is_null())
+    {
+      // The result of the rules applied to the node was pushed on top of it
+      // and is thus rewritten.
+      Node res = cache_entry(frame.d_result).d_rewritten;
+      assert(!res.is_null());
+      cache(frame.d_node, res);
+      visit.pop_back();
+      continue;
+    }
+
+    Node cur = frame.d_node;
+    if (!entry.d_visited)
+    {
+      entry.d_visited = true;
+      for (const Node& child : cur)
+      {
+        CacheEntry& child_entry = cache_entry(child);
+        // A child that is visited but not rewritten yet depends on the
+        // rewritten form of the node, i.e., we ran into a rewrite cycle.
+        if (child_entry.d_visited && child_entry.d_rewritten.is_null())
+        {
+          assert(false);
+          d_recursion_limit_reached = true;
+          continue;
+        }
+        visit.push_back({child, Node(), 0});
+      }
+      continue;
+    }
+
+    if (cur.num_children() == 0)
+    {
+      cache(cur, cur);
+      visit.pop_back();
+      continue;
+    }
+
+#ifndef NDEBUG
+    // Reset nodes counter
+    d_num_nodes = 0;
+    // Save current maximum node id
+    int64_t max_id = d_env.nm().max_node_id();
+#endif
+    std::vector<Node> children;
+    bool changed = false;
+    for (const Node& child : cur)
+    {
+      // Children involved in a rewrite cycle are not rewritten.
+      const Node& rewritten = cache_entry(child).d_rewritten;
+      children.push_back(rewritten.is_null() ? child : rewritten);
+      changed |= children.back() != child;
+    }
+    // Normalize before rewriting
+    Node n   = normalize_commutative(
+        changed ? node::utils::rebuild_node(nm(), cur, children) : cur);
+    Node res = apply_rules(n);
+#ifndef NDEBUG
+    uint64_t thresh = d_env.options().dbg_rw_node_thresh();
+    if (thresh > 0 && d_num_nodes > 0)
+    {
+      auto [new_nodes, depth] = diff(max_id, res);
+      Warn(new_nodes >= thresh) << "_rewrite() introduced " << new_nodes
+                                << " new nodes up to depth " << depth;
+    }
+#endif
+    if (res == n)
+    {
+      cache(cur, n);
+      visit.pop_back();
+      continue;
+    }
+
+    // Rewrite the result of the applied rules before completing the node.
+    CacheEntry& res_entry = cache_entry(res);
+    if (!res_entry.d_rewritten.is_null())
+    {
+      res_entry.d_generation = d_generation;
+      cache(cur, res_entry.d_rewritten);
+      visit.pop_back();
+      continue;
+    }
+    // Limit the number of consecutive rule applications if we run into
+    // rewrite cycles in production mode. Ideally, this should not happen, but
+    // if it does, we do not crash.
+    uint64_t depth = visit.back().d_depth;
+    if (res_entry.d_visited || depth >= RECURSION_LIMIT)
+    {
+      assert(false);
+      d_recursion_limit_reached = true;
+      cache(cur, res);
+      visit.pop_back();
+      continue;
+    }
+    visit.back().d_result = res;
+    visit.push_back({res, Node(), depth + 1});
+  } while (!visit.empty());
+
+  d_in_rewrite    = in_rewrite;
+  const Node& res = cache_entry(node).d_rewritten;
+  assert(!res.is_null());
+  return res;
+}
+
+Node
+Rewriter::apply_rules(const Node& n)
+{
   Node res;
+  // Constant folding of Boolean and bit-vector operators via the evaluator,
+  // which avoids eliminating operators with value operands.
+  if (d_level >= 1)
+  {
+    RewriteRuleKind kind;
+    std::tie(res, kind) = apply_rule<RewriteRuleKind::EVAL>(n);
+    if (res != n)
+    {
+      d_stats_rewrites << kind;
+      goto NORMALIZE;
+    }
+  }
+
   switch (n.kind())
   {
     case node::Kind::AND: res = rewrite_and(n); break;
@@ -505,22 +691,14 @@ Rewriter::_rewrite(const Node& node)
     default: assert(false);
   }
 
+NORMALIZE:
   // Normalize again
   res = normalize_commutative(res);
 
   assert(!res.is_null());
-  assert(res.type() == node.type());
+  assert(res.type() == n.type());
 
-  // Get iterator again in case a recursive call changed the size of d_cache
-  // and invalidated the iterator.
-  it = d_cache.find(node);
-  assert(it != d_cache.end());
-  assert(it->second.is_null());
-
-  // Cache result
-  it->second = res;
-
-  return it->second;
+  return res;
 }
 
 /* Boolean rewrites --------------------------------------------------------- */
@@ -1465,9 +1643,12 @@ DONE:
 std::ostream&
 operator<<(std::ostream& out, RewriteRuleKind kind)
 {
-  /* Boolean rewrites ---------------------------- */
   switch (kind)
   {
+    /* Constant folding ---------------------------- */
+    case RewriteRuleKind::EVAL: out << "EVAL"; break;
+
+    /* Boolean rewrites ---------------------------- */
     case RewriteRuleKind::AND_EVAL: out << "AND_EVAL"; break;
     case RewriteRuleKind::AND_SPECIAL_CONST: out << "AND_SPECIAL_CONST"; break;
     case RewriteRuleKind::AND_CONST: out << "AND_CONST"; break;
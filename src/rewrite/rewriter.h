@@ -11,10 +11,8 @@
 #ifndef BZLA_REWRITE_REWRITER_H_INCLUDED
 #define BZLA_REWRITE_REWRITER_H_INCLUDED
 
-#include <unordered_map>
-#ifndef NDEBUG
-#include <unordered_set>
-#endif
+#include <memory>
+#include <vector>
 
 #include "node/node.h"
 #include "util/statistics.h"
@@ -26,6 +24,7 @@ class Logger;
 }
 
 class Env;
+enum class RewriteRuleKind;
 
 /* -------------------------------------------------------------------------- */
 
@@ -38,15 +37,24 @@ class Rewriter
    * @param level The rewriting level; level 0 disables all rewrites
    *              except for operator elimination, level 1 enables one-level
    *              rewrites, level 2 multi-level rewrites.
+   * @param cache_size The maximum number of cached rewrites, 0 for no limit.
+   *                   The bound is enforced at the beginning of rewrite()
+   *                   calls by evicting entries that were not accessed in the
+   *                   previous call.
+   * @param profile True to record per-rule profiling statistics.
    */
-  Rewriter(Env& env, uint8_t level = 0);
+  Rewriter(Env& env,
+           uint8_t level       = 0,
+           uint64_t cache_size = 0,
+           bool profile        = false);
+  ~Rewriter();
 
   /**
    * Rewrite given node.
    * @param node The node to rewrite.
    * @return The rewritten node or `node` if no rewrites applied.
    */
-  const Node& rewrite(const Node& node);
+  Node rewrite(const Node& node);
 
   /**
    * Create node and apply rewriting.
@@ -55,23 +63,23 @@ class Rewriter
    * @param indices  The indices of the node to create.
    * @return The created, rewritten node.
    */
-  const Node& mk_node(node::Kind kind,
-                      const std::vector<Node>& children,
-                      const std::vector<uint64_t>& indices = {});
+  Node mk_node(node::Kind kind,
+               const std::vector<Node>& children,
+               const std::vector<uint64_t>& indices = {});
 
   /**
    * Helper to create an inverted Boolean or bit-vector node.
    * @param node The node to invert.
    * @return The inverted node.
    */
-  const Node& invert_node(const Node& node);
+  Node invert_node(const Node& node);
   /**
    * Helper to conditionally create an inverted Boolean or bit-vector node.
    * @param condition True to invert the given node.
    * @param node The node to invert.
    * @return The inverted node.
    */
-  const Node& invert_node_if(bool condition, const Node& node);
+  Node invert_node_if(bool condition, const Node& node);
 
   /**
    * @return True if given node corresponds to a (rewritten) OR node.
@@ -129,10 +137,83 @@ class Rewriter
   NodeManager& nm();
 
  private:
-  /** The limit for recursive calls to _rewrite(). */
+  /**
+   * The limit for the number of consecutive rule applications to the results
+   * of rule applications in _rewrite().
+   */
   static constexpr uint64_t RECURSION_LIMIT = 4096;
 
-  const Node& _rewrite(const Node& node);
+  /** Rewrite cache entry. */
+  struct CacheEntry
+  {
+    /** The rewritten node, null if not rewritten yet. */
+    Node d_rewritten;
+    /** The value of `d_generation` when the entry was last accessed. */
+    uint64_t d_generation : 63;
+    /** True if the children of the node were pushed in _rewrite(). */
+    bool d_visited : 1;
+
+    CacheEntry() : d_generation(0), d_visited(false) {}
+  };
+
+  /**
+   * Per-rule profiling statistics, indexed by rule kind. Nodes created by a
+   * rule are rewritten after the rule returned, which is not included.
+   */
+  struct RuleProfile
+  {
+    RuleProfile(util::Statistics& stats);
+    /** The number of attempts to apply a rule. */
+    util::HistogramStatistic& d_attempts;
+    /** The number of successful applications of a rule. */
+    util::HistogramStatistic& d_successes;
+    /** The number of cycles spent in a rule. */
+    util::HistogramStatistic& d_cycles;
+    /** The number of nodes created while applying a rule. */
+    util::HistogramStatistic& d_nodes;
+  };
+
+  /** Work stack entry of _rewrite(). */
+  struct RewriteFrame
+  {
+    /** The node to rewrite. */
+    Node d_node;
+    /** The result of the rules applied to the node, null if not applied. */
+    Node d_result;
+    /** The number of consecutive rule applications that yielded the node. */
+    uint64_t d_depth;
+  };
+
+  /**
+   * Rewrite given node. Nodes are rewritten in post-order with an explicit
+   * work stack. Nodes created by rules are not rewritten on construction,
+   * the result of the rules applied to a node is instead pushed on top of
+   * the node and rewritten before the node is completed.
+   */
+  Node _rewrite(const Node& node);
+  /**
+   * Apply the rewrite rules for the kind of given node, whose children are
+   * rewritten.
+   */
+  Node apply_rules(const Node& node);
+
+  /** Apply rewrite rule K to given node, profiled if enabled. */
+  template <RewriteRuleKind K>
+  std::pair<Node, RewriteRuleKind> apply_rule(const Node& node);
+
+  /**
+   * Get the cache entry of given node. The returned reference is invalidated
+   * if the cache grows, i.e., on calls to cache_entry() for other nodes.
+   */
+  CacheEntry& cache_entry(const Node& node);
+  /** Cache the rewritten form of given node. */
+  void cache(const Node& node, const Node& rewritten);
+  /**
+   * Evict entries that were not accessed since the previous call if the
+   * cache exceeds its bound, and start a new generation. Must only be called
+   * if no rewrites are in progress.
+   */
+  void evict();
 
   /* Core ---------------------------------------- */
   Node rewrite_eq(const Node& node);
@@ -254,24 +335,40 @@ class Rewriter
 
   /** True to enable rewriting, false to only enable operator elimination. */
   uint8_t d_level;
-  /** Cache for rewritten nodes, maps node to its rewritten form. */
-  std::unordered_map<Node, Node> d_cache;
+  /**
+   * Cache for rewritten nodes, indexed by node id. Node ids are never reused.
+   */
+  std::vector<CacheEntry> d_cache;
+  /** The number of cached rewrites. */
+  uint64_t d_cache_size = 0;
+  /** The maximum number of cached rewrites, 0 for no limit. */
+  uint64_t d_cache_limit;
+  /** The current cache generation, incremented on each evict() call. */
+  uint64_t d_generation = 1;
 #ifndef NDEBUG
-  /** Cache for detecting rewrite cycles in debug mode. */
-  std::unordered_set<Node> d_rec_cache;
   /** Counter for new nodes created during rewriting. */
   uint64_t d_num_nodes = 0;
 #endif
-  uint64_t d_num_rec_calls = 0;
+  /** Indicates whether a call to _rewrite() is in progress. */
+  bool d_in_rewrite = false;
   /** Indicates whether rewrite recursion limit was reached. */
   bool d_recursion_limit_reached = false;
   util::HistogramStatistic& d_stats_rewrites;
+  /** Number of cache entries evicted due to the cache bound. */
+  uint64_t& d_stats_evicted;
+  /** Per-rule profiling statistics, null if profiling is disabled. */
+  std::unique_ptr<RuleProfile> d_profile;
 };
 
 /* -------------------------------------------------------------------------- */
 
 enum class RewriteRuleKind
 {
+  /* Constant folding ---------------------------- */
+
+  // Level 1+
+  EVAL,
+
   /* Boolean rewrites ---------------------------- */
 
   // Level 1+
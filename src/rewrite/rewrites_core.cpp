@@ -19,6 +19,7 @@
 #include "node/node_ref_vector.h"
 #include "node/node_utils.h"
 #include "node/unordered_node_ref_set.h"
+#include "rewrite/evaluator.h"
 #include "rewrite/rewrite_utils.h"
 #include "solver/fp/floating_point.h"
 #include "solver/fp/rounding_mode.h"
@@ -27,6 +28,33 @@ namespace bzla {
 
 using namespace node;
 
+/* evaluation --------------------------------------------------------------- */
+
+/**
+ * Constant folding of Boolean and bit-vector operators, matches when all
+ * operands are values.
+ */
+template <>
+Node
+RewriteRule<RewriteRuleKind::EVAL>::_apply(Rewriter& rewriter, const Node& node)
+{
+  if (node.num_children() == 0 || !Evaluator::is_bool_bv_op(node))
+  {
+    return node;
+  }
+  std::vector<Node> values;
+  for (const Node& child : node)
+  {
+    if (!child.is_value())
+    {
+      return node;
+    }
+    values.push_back(child);
+  }
+  return Evaluator::evaluate(
+      rewriter.nm(), node.kind(), values, node.indices());
+}
+
 /* equal -------------------------------------------------------------------- */
 
 /**
@@ -15,6 +15,12 @@
 
 namespace bzla {
 
+/* evaluation --------------------------------------------------------------- */
+
+template <>
+Node RewriteRule<RewriteRuleKind::EVAL>::_apply(Rewriter& rewriter,
+                                                const Node& node);
+
 /* equal -------------------------------------------------------------------- */
 
 template <>
@@ -10,6 +10,9 @@
 
 #include "sat/cadical.h"
 
+#include <algorithm>
+#include <cstdlib>
+
 namespace bzla::sat {
 
 /* CadicalTerminator public ------------------------------------------------- */
@@ -26,6 +29,82 @@ CadicalTerminator::terminate()
   return d_terminator->terminate();
 }
 
+/* CadicalPropagator public ------------------------------------------------- */
+
+CadicalPropagator::CadicalPropagator(Cadical& solver, Propagator* propagator)
+    : CaDiCaL::ExternalPropagator(), d_solver(solver), d_propagator(propagator)
+{
+  // Only complete assignments are checked.
+  is_lazy = true;
+}
+
+void
+CadicalPropagator::notify_assignment(int lit, bool is_fixed)
+{
+  (void) lit;
+  (void) is_fixed;
+}
+
+void
+CadicalPropagator::notify_backtrack(size_t new_level)
+{
+  (void) new_level;
+}
+
+bool
+CadicalPropagator::cb_check_found_model(const std::vector<int>& model)
+{
+  auto& values = d_solver.d_model;
+  std::fill(values.begin(), values.end(), 0);
+  for (int lit : model)
+  {
+    size_t var = std::abs(lit);
+    if (var >= values.size())
+    {
+      values.resize(var + 1, 0);
+    }
+    values[var] = lit > 0 ? 1 : -1;
+  }
+
+  size_t num_lits        = d_solver.d_clauses.size();
+  d_solver.d_in_callback = true;
+  bool accept            = d_propagator->check_model();
+  d_solver.d_in_callback = false;
+  // All literals of external clauses must be observed. Observed variables are
+  // not eliminated or substituted by CaDiCaL.
+  auto& clauses = d_solver.d_clauses;
+  for (size_t i = num_lits, size = clauses.size(); i < size; ++i)
+  {
+    if (clauses[i] != 0)
+    {
+      d_solver.observe(std::abs(clauses[i]));
+    }
+  }
+  // Rejecting the assignment without providing a clause would result in
+  // checking the same assignment again.
+  return accept || d_solver.d_clauses.size() == num_lits;
+}
+
+bool
+CadicalPropagator::cb_has_external_clause()
+{
+  return d_solver.d_clauses_pos < d_solver.d_clauses.size();
+}
+
+int
+CadicalPropagator::cb_add_external_clause_lit()
+{
+  auto& clauses = d_solver.d_clauses;
+  assert(d_solver.d_clauses_pos < clauses.size());
+  int lit = clauses[d_solver.d_clauses_pos++];
+  if (d_solver.d_clauses_pos == clauses.size())
+  {
+    clauses.clear();
+    d_solver.d_clauses_pos = 0;
+  }
+  return lit;
+}
+
 /* Cadical public ----------------------------------------------------------- */
 
 Cadical::Cadical()
@@ -38,6 +117,18 @@ Cadical::Cadical()
 void
 Cadical::add(int32_t lit)
 {
+  // Clauses added by the propagator are passed to CaDiCaL via callbacks.
+  if (d_in_callback)
+  {
+    d_clauses.push_back(lit);
+    return;
+  }
+  // Clauses added by the propagator may refer to any variable, which must
+  // hence not be eliminated or substituted by CaDiCaL.
+  if (d_propagator && lit != 0)
+  {
+    freeze(lit);
+  }
   d_solver->add(lit);
 }
 
@@ -50,6 +141,15 @@ Cadical::assume(int32_t lit)
 int32_t
 Cadical::value(int32_t lit)
 {
+  if (d_in_callback)
+  {
+    size_t var = std::abs(lit);
+    if (var >= d_model.size())
+    {
+      return 0;
+    }
+    return lit < 0 ? -d_model[var] : d_model[var];
+  }
   int32_t val = d_solver->val(lit);
   if (val > 0) return 1;
   if (val < 0) return -1;
@@ -72,6 +172,14 @@ Result
 Cadical::solve()
 {
   int32_t res = d_solver->solve();
+  // Add clauses of the propagator that were not requested by CaDiCaL before
+  // search terminated.
+  for (size_t size = d_clauses.size(); d_clauses_pos < size; ++d_clauses_pos)
+  {
+    d_solver->add(d_clauses[d_clauses_pos]);
+  }
+  d_clauses.clear();
+  d_clauses_pos = 0;
   if (res == 10) return Result::SAT;
   if (res == 20) return Result::UNSAT;
   return Result::UNKNOWN;
@@ -91,12 +199,60 @@ Cadical::configure_terminator(Terminator* terminator)
   }
 }
 
+void
+Cadical::connect_propagator(Propagator* propagator)
+{
+  if (propagator)
+  {
+    d_propagator.reset(new CadicalPropagator(*this, propagator));
+    d_solver->connect_external_propagator(d_propagator.get());
+  }
+  else
+  {
+    d_solver->disconnect_external_propagator();
+    d_propagator.reset();
+  }
+}
+
+void
+Cadical::observe(int32_t var)
+{
+  assert(d_propagator);
+  assert(var > 0);
+  if (static_cast<size_t>(var) >= d_observed.size())
+  {
+    d_observed.resize(var + 1, false);
+  }
+  if (!d_observed[var])
+  {
+    d_observed[var] = true;
+    d_solver->add_observed_var(var);
+  }
+}
+
 const char *
 Cadical::get_version() const
 {
   return d_solver->version();
 }
 
+/* Cadical private ---------------------------------------------------------- */
+
+void
+Cadical::freeze(int32_t lit)
+{
+  size_t var = std::abs(lit);
+  if (var >= d_frozen.size())
+  {
+    d_frozen.resize(var + 1, false);
+  }
+  if (!d_frozen[var])
+  {
+    d_frozen[var] = true;
+    d_solver->freeze(var);
+  }
+}
+
 /* -------------------------------------------------------------------------- */
 
 }  // namespace bzla::sat
@@ -13,6 +13,7 @@
 
 #include <cadical.hpp>
 #include <memory>
+#include <vector>
 
 #include "sat/sat_solver.h"
 #include "terminator.h"
@@ -30,8 +31,34 @@ class CadicalTerminator : public CaDiCaL::Terminator
   bzla::Terminator* d_terminator = nullptr;
 };
 
+class Cadical;
+
+/**
+ * Lazy external propagator (IPASIR-UP) that forwards complete assignments to
+ * a sat::Propagator.
+ */
+class CadicalPropagator : public CaDiCaL::ExternalPropagator
+{
+ public:
+  CadicalPropagator(Cadical& solver, Propagator* propagator);
+  ~CadicalPropagator() {}
+
+  void notify_assignment(int lit, bool is_fixed) override;
+  void notify_new_decision_level() override {}
+  void notify_backtrack(size_t new_level) override;
+  bool cb_check_found_model(const std::vector<int>& model) override;
+  bool cb_has_external_clause() override;
+  int cb_add_external_clause_lit() override;
+
+ private:
+  Cadical& d_solver;
+  Propagator* d_propagator = nullptr;
+};
+
 class Cadical : public SatSolver
 {
+  friend CadicalPropagator;
+
  public:
   Cadical();
 
@@ -42,12 +69,38 @@ class Cadical : public SatSolver
   int32_t fixed(int32_t lit) override;
   Result solve() override;
   void configure_terminator(Terminator* terminator) override;
+  bool supports_propagator() const override { return true; }
+  void connect_propagator(Propagator* propagator) override;
+  void observe(int32_t var) override;
   const char *get_name() const override { return "CaDiCaL"; }
   const char *get_version() const override;
 
  private:
+  /** Freeze the variable of given literal, if not already frozen. */
+  void freeze(int32_t lit);
+
   std::unique_ptr<CaDiCaL::Solver> d_solver   = nullptr;
   std::unique_ptr<CaDiCaL::Terminator> d_term = nullptr;
+  std::unique_ptr<CadicalPropagator> d_propagator;
+
+  /** True while the connected propagator checks an assignment. */
+  bool d_in_callback = false;
+  /** The values of the observed variables of the assignment to check. */
+  std::vector<int8_t> d_model;
+  /**
+   * Clauses added while checking an assignment, each terminated with 0.
+   * Passed to CaDiCaL as external clauses.
+   */
+  std::vector<int32_t> d_clauses;
+  /** The index of the next literal in `d_clauses` to pass to CaDiCaL. */
+  size_t d_clauses_pos = 0;
+  /**
+   * The variables frozen while a propagator is connected. Clauses added by
+   * the propagator may refer to any of them.
+   */
+  std::vector<bool> d_frozen;
+  /** The variables observed by the connected propagator. */
+  std::vector<bool> d_observed;
 };
 
 }  // namespace bzla::sat
@@ -11,6 +11,7 @@
 #ifndef BZLA_SAT_SAT_SOLVER_H_INCLUDED
 #define BZLA_SAT_SAT_SOLVER_H_INCLUDED
 
+#include <cassert>
 #include <cstdint>
 #include <string>
 
@@ -19,6 +20,24 @@
 
 namespace bzla::sat {
 
+/**
+ * Interface for external propagators that check complete assignments during
+ * search, see SatSolver::connect_propagator().
+ */
+class Propagator
+{
+ public:
+  virtual ~Propagator(){};
+  /**
+   * Check complete assignment found by the SAT solver. The values of
+   * observed variables can be queried via SatSolver::value(), and lemma
+   * clauses can be added via SatSolver::add().
+   * @return False if clauses were added that are falsified by the current
+   *         assignment, and true if the assignment is accepted.
+   */
+  virtual bool check_model() = 0;
+};
+
 class SatSolver
 {
  public:
@@ -68,6 +87,32 @@ class SatSolver
    */
   virtual void configure_terminator(Terminator *terminator) = 0;
 
+  /**
+   * Determine if this SAT solver supports external propagators.
+   * @return True if connect_propagator() is supported.
+   */
+  virtual bool supports_propagator() const { return false; }
+  /**
+   * Connect an external propagator that is called on complete assignments
+   * during search.
+   * @param propagator The propagator, nullptr to disconnect.
+   */
+  virtual void connect_propagator(Propagator *propagator)
+  {
+    (void) propagator;
+    assert(false);
+  }
+  /**
+   * Observe variable, i.e., make its value available to the connected
+   * propagator. Observed variables are not eliminated by the SAT solver.
+   * @param var The variable to observe.
+   */
+  virtual void observe(int32_t var)
+  {
+    (void) var;
+    assert(false);
+  }
+
   // virtual int32_t repr(int32_t) = 0;
 
   /**
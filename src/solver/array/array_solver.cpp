@@ -38,6 +38,7 @@ ArraySolver::ArraySolver(Env& env, SolverState& state)
     : Solver(env, state),
       d_selects(state.backtrack_mgr()),
       d_equalities(state.backtrack_mgr()),
+      d_scope_tracker(state.backtrack_mgr(), *this),
       d_active_parents(state.backtrack_mgr()),
       d_stats(env.statistics(), "solver::array::"),
       d_logger(env.logger())
@@ -52,11 +53,10 @@ ArraySolver::check()
   Log(1);
   Log(1) << "*** check arrays";
 
-  d_array_models.clear();
-
   // Nothing to check
   if (d_equalities.empty() && d_selects.empty())
   {
+    reset_models();
     return true;
   }
 
@@ -69,6 +69,7 @@ ArraySolver::check()
   // Get current assignment for register equalities and populate
   // d_active_equalities.
   Log(2) << "active equalities:";
+  size_t num_active_parents = d_active_parents.size();
   for (const Node& eq : d_equalities)
   {
     bool val = d_solver_state.value(eq).value<bool>();
@@ -77,6 +78,16 @@ ArraySolver::check()
     compute_parents(eq);
   }
 
+  // Accesses may propagate upwards to new parents, recheck all.
+  if (d_active_parents.size() != num_active_parents)
+  {
+    reset_models();
+  }
+  else
+  {
+    invalidate_accesses();
+  }
+
   // Check selects and equalities until fixed-point
   size_t i_sel = 0, i_eq = 0;
   while (i_sel < d_selects.size() || i_eq < d_equalities.size())
@@ -212,6 +223,12 @@ ArraySolver::check_access(const Node& access)
     return;
   }
 
+  // Still valid from a previous check() call.
+  if (d_access_info.find(access) != d_access_info.end())
+  {
+    return;
+  }
+
   // equality over constant arrays not yet supported
   if (access.kind() == Kind::CONST_ARRAY)
   {
@@ -221,9 +238,18 @@ ArraySolver::check_access(const Node& access)
 
   Log(2);
   Log(1) << "check: " << access;
-  Access acc(access, d_solver_state);
+  ++d_stats.num_accesses_checked;
+  AccessInfo& info =
+      d_access_info.emplace(access, Access(access, d_solver_state))
+          .first->second;
+  const Access& acc = info.access;
   Log(2) << "index:   " << acc.index_value();
   Log(2) << "element: " << acc.element_value();
+  // Equalities of array elements are not recorded as dependencies.
+  if (acc.element().type().is_array())
+  {
+    info.complete = false;
+  }
   node_ref_vector visit{acc.array()};
   do
   {
@@ -243,24 +269,36 @@ ArraySolver::check_access(const Node& access)
         Log(2) << "access1: " << acc.get();
         Log(2) << "access2: " << it->get();
         add_congruence_lemma(array, acc, *it);
+        info.complete = false;
         break;
       }
+      // This access has to be checked again if the entry is invalidated.
+      if (it->get() != access)
+      {
+        d_access_info.at(it->get()).dups.push_back(access);
+      }
     }
     else
     {
+      info.arrays.push_back(array);
       if (array.kind() == Kind::STORE)
       {
-        Node index_value = d_solver_state.value(array[1]);
+        Node index_value = dependency_value(array[1], info);
         Log(2) << "index: " << index_value;
         // Check access-over-write consistency
         if (acc.index_value() == index_value)
         {
+          if (info.complete)
+          {
+            dependency_value(array[2], info);
+          }
           if (!is_equal(acc, array[2]))
           {
             Log(2) << "\u2716 access store lemma";
             Log(2) << "access: " << acc.get();
             Log(2) << "store: " << array;
             add_access_store_lemma(acc, array);
+            info.complete = false;
             break;
           }
         }
@@ -273,15 +311,20 @@ ArraySolver::check_access(const Node& access)
       }
       else if (array.kind() == Kind::CONST_ARRAY)
       {
+        if (info.complete)
+        {
+          dependency_value(array[0], info);
+        }
         if (!is_equal(acc, array[0]))
         {
           add_access_const_array_lemma(acc, array);
+          info.complete = false;
           break;
         }
       }
       else if (array.kind() == Kind::ITE)
       {
-        Node cond_value = d_solver_state.value(array[0]);
+        Node cond_value = dependency_value(array[0], info);
         visit.push_back(cond_value.value<bool>() ? array[1] : array[2]);
         ++d_stats.num_propagations_down;
         Log(2) << "D ite: " << visit.back();
@@ -304,7 +347,7 @@ ArraySolver::check_access(const Node& access)
         {
           if (parent.kind() == Kind::STORE)
           {
-            Node index_value = d_solver_state.value(parent[1]);
+            Node index_value = dependency_value(parent[1], info);
             if (index_value != acc.index_value())
             {
               visit.push_back(parent);
@@ -315,7 +358,8 @@ ArraySolver::check_access(const Node& access)
           else if (parent.kind() == Kind::ITE)
           {
             assert(parent.type().is_array());
-            bool cond_value = d_solver_state.value(parent[0]).value<bool>();
+            bool cond_value =
+                dependency_value(parent[0], info).value<bool>();
             if ((cond_value && array == parent[1])
                 || (!cond_value && array == parent[2]))
             {
@@ -328,7 +372,7 @@ ArraySolver::check_access(const Node& access)
           {
             assert(parent.kind() == Kind::EQUAL);
             assert(parent[0].type().is_array());
-            bool eq_value = d_solver_state.value(parent).value<bool>();
+            bool eq_value = dependency_value(parent, info).value<bool>();
             if (eq_value)
             {
               if (parent[0] == array)
@@ -350,6 +394,80 @@ ArraySolver::check_access(const Node& access)
   } while (!visit.empty());
 }
 
+void
+ArraySolver::invalidate_accesses()
+{
+  std::vector<Node> invalid;
+  for (const auto& [access, info] : d_access_info)
+  {
+    if (!is_valid(info))
+    {
+      invalid.push_back(access);
+    }
+  }
+
+  while (!invalid.empty())
+  {
+    Node access = invalid.back();
+    invalid.pop_back();
+    auto it = d_access_info.find(access);
+    if (it == d_access_info.end())
+    {
+      continue;
+    }
+    ++d_stats.num_accesses_invalidated;
+    AccessInfo& info = it->second;
+    for (const Node& array : info.arrays)
+    {
+      auto& array_model = d_array_models.at(array);
+      auto ita          = array_model.find(info.access);
+      assert(ita != array_model.end());
+      assert(ita->get() == access);
+      array_model.erase(ita);
+    }
+    invalid.insert(invalid.end(), info.dups.begin(), info.dups.end());
+    d_access_info.erase(it);
+  }
+}
+
+bool
+ArraySolver::is_valid(const AccessInfo& info)
+{
+  if (!info.complete)
+  {
+    return false;
+  }
+  const Access& acc = info.access;
+  if (d_solver_state.value(acc.index()) != acc.index_value()
+      || d_solver_state.value(acc.element()) != acc.element_value())
+  {
+    return false;
+  }
+  for (const auto& [term, value] : info.deps)
+  {
+    if (d_solver_state.value(term) != value)
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+void
+ArraySolver::reset_models()
+{
+  d_array_models.clear();
+  d_access_info.clear();
+}
+
+Node
+ArraySolver::dependency_value(const Node& term, AccessInfo& info)
+{
+  Node value = d_solver_state.value(term);
+  info.deps.emplace_back(term, value);
+  return value;
+}
+
 void
 ArraySolver::check_equality(const Node& eq)
 {
@@ -877,6 +995,10 @@ ArraySolver::Statistics::Statistics(util::Statistics& stats,
       num_propagations_up(stats.new_stat<uint64_t>(prefix + "propagations_up")),
       num_propagations_down(
           stats.new_stat<uint64_t>(prefix + "propagations_down")),
+      num_accesses_checked(
+          stats.new_stat<uint64_t>(prefix + "num_accesses_checked")),
+      num_accesses_invalidated(
+          stats.new_stat<uint64_t>(prefix + "num_accesses_invalidated")),
       num_lemma_size(
           stats.new_stat<util::HistogramStatistic>(prefix + "lemma_size")),
       time_check(stats.new_stat<util::TimerStatistic>(prefix + "time_check"))
@@ -14,6 +14,7 @@
 #include <map>
 #include <unordered_map>
 
+#include "backtrack/backtrackable.h"
 #include "backtrack/unordered_set.h"
 #include "backtrack/vector.h"
 #include "solver/solver.h"
@@ -100,9 +101,76 @@ class ArraySolver : public Solver
     size_t operator()(const Access& access) const { return access.hash(); }
   };
 
+  /**
+   * The state of an access checked via check_access(), kept across check()
+   * calls. The entries of an access in the array models stay valid as long
+   * as the values of its index, its element and all terms its propagation
+   * depended on do not change.
+   */
+  struct AccessInfo
+  {
+    AccessInfo(const Access& acc) : access(acc) {}
+    /** The access with the values it was checked with. */
+    Access access;
+    /**
+     * The terms the propagation of the access depended on (store indices,
+     * ite conditions, ...), and their values.
+     */
+    std::vector<std::pair<Node, Node>> deps;
+    /** The arrays to whose model the access was added. */
+    std::vector<Node> arrays;
+    /**
+     * The accesses that were found equal to this access in an array model
+     * and were thus not added to the model.
+     */
+    std::vector<Node> dups;
+    /**
+     * False if the propagation was stopped by a lemma or depends on values
+     * that are not recorded in `deps`.
+     */
+    bool complete = true;
+  };
+
+  /** Resets the array models on pop(). */
+  class ScopeTracker : public backtrack::Backtrackable
+  {
+   public:
+    ScopeTracker(backtrack::BacktrackManager* mgr, ArraySolver& solver)
+        : Backtrackable(mgr), d_solver(solver)
+    {
+    }
+    void push() override {}
+    void pop() override { d_solver.reset_models(); }
+
+   private:
+    ArraySolver& d_solver;
+  };
+
   /** Check theory consistency of access. */
   void check_access(const Node& access);
 
+  /**
+   * Remove the accesses that are not valid w.r.t. the current assignment
+   * from the array models, together with all accesses that were found equal
+   * to them. These accesses are checked again by check_access().
+   */
+  void invalidate_accesses();
+
+  /**
+   * Determine if the entries of an access in the array models are valid
+   * w.r.t. the current assignment.
+   */
+  bool is_valid(const AccessInfo& info);
+
+  /** Clear the array models and the state of all checked accesses. */
+  void reset_models();
+
+  /**
+   * Get the value of given term and record it as a dependency of the access
+   * of given info.
+   */
+  Node dependency_value(const Node& term, AccessInfo& info);
+
   /** Check theory consistency of array equality. */
   void check_equality(const Node& eq);
 
@@ -181,12 +249,18 @@ class ArraySolver : public Solver
   backtrack::vector<Node> d_equalities;
 
   /**
-   * Array models constructed during check().
-   * @note This cache is reset each check() call.
+   * Array models constructed during check(). The models are kept across
+   * check() calls, see invalidate_accesses().
    */
   std::unordered_map<Node, std::unordered_set<Access, HashAccess>>
       d_array_models;
 
+  /** Maps accesses in the array models to their state. */
+  std::unordered_map<Node, AccessInfo> d_access_info;
+
+  /** Resets the array models on pop(). */
+  ScopeTracker d_scope_tracker;
+
   /**
    * Caches access nodes already checked in check_access().
    * @note This cache is reset each check() call.
@@ -241,6 +315,8 @@ class ArraySolver : public Solver
     uint64_t& num_propagations;
     uint64_t& num_propagations_up;
     uint64_t& num_propagations_down;
+    uint64_t& num_accesses_checked;
+    uint64_t& num_accesses_invalidated;
     util::HistogramStatistic& num_lemma_size;
     util::TimerStatistic& time_check;
   } d_stats;
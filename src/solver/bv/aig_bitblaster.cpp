@@ -10,11 +10,22 @@
 
 #include "solver/bv/aig_bitblaster.h"
 
+#include <algorithm>
+
 #include "node/node_ref_vector.h"
 #include "solver/bv/bv_solver.h"
 
 namespace bzla::bv {
 
+AigBitblaster::AigBitblaster(backtrack::BacktrackManager* mgr,
+                             bitblast::MulEncoding mul_encoding,
+                             bitblast::DivEncoding div_encoding)
+    : d_bitblaster_cache(mgr), d_divider_cache(mgr)
+{
+  d_bitblaster.set_mul_encoding(mul_encoding);
+  d_bitblaster.set_div_encoding(div_encoding);
+}
+
 void
 AigBitblaster::bitblast(const Node& t)
 {
@@ -73,6 +84,11 @@ AigBitblaster::bitblast(const Node& t)
           it->second = type.is_bool()
                            ? d_bitblaster.bv_constant(1)
                            : d_bitblaster.bv_constant(type.bv_size());
+          if (d_record_leaf_bits)
+          {
+            d_leaf_bits.insert(
+                d_leaf_bits.end(), it->second.begin(), it->second.end());
+          }
           break;
 
         case Kind::NOT:
@@ -114,6 +130,10 @@ AigBitblaster::bitblast(const Node& t)
           {
             // For all other cases we abstract equality as a Boolean constant.
             it->second = d_bitblaster.bv_constant(1);
+            if (d_record_leaf_bits)
+            {
+              d_leaf_bits.push_back(it->second[0]);
+            }
           }
         }
         break;
@@ -130,15 +150,7 @@ AigBitblaster::bitblast(const Node& t)
 
         case Kind::BV_MUL:
           assert(type.is_bv());
-          // Use more succinct encoding for squares
-          if (cur[0] == cur[1])
-          {
-            it->second = d_bitblaster.bv_mul_square(bits(cur[0]));
-          }
-          else
-          {
-            it->second = d_bitblaster.bv_mul(bits(cur[0]), bits(cur[1]));
-          }
+          it->second = bitblast_mul(cur);
           break;
 
         case Kind::BV_ULT:
@@ -167,13 +179,9 @@ AigBitblaster::bitblast(const Node& t)
           break;
 
         case Kind::BV_UDIV:
-          assert(type.is_bv());
-          it->second = d_bitblaster.bv_udiv(bits(cur[0]), bits(cur[1]));
-          break;
-
         case Kind::BV_UREM:
           assert(type.is_bv());
-          it->second = d_bitblaster.bv_urem(bits(cur[0]), bits(cur[1]));
+          it->second = bitblast_udiv_urem(cur);
           break;
 
         case Kind::BV_CONCAT:
@@ -198,17 +206,72 @@ AigBitblaster::bitblast(const Node& t)
 const bitblast::AigBitblaster::Bits&
 AigBitblaster::bits(const Node& term) const
 {
-  if (d_bitblaster_cache.find(term) == d_bitblaster_cache.end())
+  auto it = d_bitblaster_cache.find(term);
+  if (it == d_bitblaster_cache.end())
   {
     return d_empty;
   }
-  return d_bitblaster_cache.at(term);
+  return it->second;
+}
+
+bitblast::AigBitblaster::Bits
+AigBitblaster::bitblast_mul(const Node& term)
+{
+  assert(term.kind() == node::Kind::BV_MUL);
+  const auto& a = bits(term[0]);
+  const auto& b = bits(term[1]);
+
+  uint64_t num_ands = d_bitblaster.num_aig_ands();
+  bitblast::AigBitblaster::Bits res;
+  // Use more succinct encoding for squares
+  if (term[0] == term[1])
+  {
+    res = d_bitblaster.bv_mul_square(a);
+  }
+  else
+  {
+    res = d_bitblaster.bv_mul(a, b);
+  }
+
+  uint32_t level_in = 0, level_out = 0;
+  for (size_t i = 0, size = a.size(); i < size; ++i)
+  {
+    level_in  = std::max({level_in, a[i].level(), b[i].level()});
+    level_out = std::max(level_out, res[i].level());
+  }
+  if (d_bitblaster.num_aig_ands() > num_ands)
+  {
+    d_statistics.num_mul_ands += d_bitblaster.num_aig_ands() - num_ands;
+  }
+  if (level_out > level_in)
+  {
+    d_statistics.max_mul_depth =
+        std::max<uint64_t>(d_statistics.max_mul_depth, level_out - level_in);
+  }
+  return res;
+}
+
+const bitblast::AigBitblaster::Bits&
+AigBitblaster::bitblast_udiv_urem(const Node& term)
+{
+  assert(term.kind() == node::Kind::BV_UDIV
+         || term.kind() == node::Kind::BV_UREM);
+  auto [it, inserted] =
+      d_divider_cache.emplace(std::make_pair(term[0].id(), term[1].id()),
+                              std::make_pair(bitblast::AigBitblaster::Bits(),
+                                             bitblast::AigBitblaster::Bits()));
+  if (inserted)
+  {
+    it->second = d_bitblaster.bv_udiv_urem(bits(term[0]), bits(term[1]));
+  }
+  return term.kind() == node::Kind::BV_UDIV ? it->second.first
+                                            : it->second.second;
 }
 
 uint64_t
-AigBitblaster::count_aig_ands(const Node& term, AigNodeRefSet& cache)
+AigBitblaster::count_aig_ands(const Node& term, AigNodeIdSet& cache)
 {
-  std::vector<std::reference_wrapper<const bitblast::AigNode>> visit;
+  std::vector<bitblast::AigNode> visit;
   bitblast(term);
   const auto& b = bits(term);
   visit.insert(visit.end(), b.begin(), b.end());
@@ -217,10 +280,10 @@ AigBitblaster::count_aig_ands(const Node& term, AigNodeRefSet& cache)
   uint64_t res = 0;
   do
   {
-    const bitblast::AigNode& cur = visit.back();
+    bitblast::AigNode cur = std::move(visit.back());
     visit.pop_back();
 
-    if (cache.insert(cur).second)
+    if (cache.insert(cur.get_id()).second)
     {
       if (cur.is_and())
       {
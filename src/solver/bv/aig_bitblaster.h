@@ -14,17 +14,41 @@
 #include <unordered_set>
 #include <unordered_map>
 
+#include "backtrack/unordered_map.h"
 #include "bitblast/aig_bitblaster.h"
 #include "node/node.h"
+#include "util/hash_pair.h"
 
 namespace bzla::bv {
 
 class AigBitblaster
 {
  public:
-  using AigNodeRefSet =
-      std::unordered_set<std::reference_wrapper<const bitblast::AigNode>,
-                         std::hash<bitblast::AigNode>>;
+  /** Set of (signed) AIG node ids. */
+  using AigNodeIdSet = std::unordered_set<int64_t>;
+
+  struct Statistics
+  {
+    /** Number of AND gates created for multiplications. */
+    uint64_t num_mul_ands = 0;
+    /** Maximum AIG depth of a multiplier circuit. */
+    uint64_t max_mul_depth = 0;
+  };
+
+  /**
+   * Constructor.
+   * @param mgr The associated backtrack manager. If given, bit-blasted terms
+   *            are scoped, i.e., the bits of terms that were bit-blasted in a
+   *            popped scope are released. Unreferenced AIG nodes are garbage
+   *            collected by the AIG manager.
+   * @param mul_encoding The encoding used for bit-vector multiplications.
+   * @param div_encoding The encoding used for bit-vector division and
+   *                     remainder.
+   */
+  AigBitblaster(
+      backtrack::BacktrackManager* mgr   = nullptr,
+      bitblast::MulEncoding mul_encoding = bitblast::MulEncoding::ARRAY,
+      bitblast::DivEncoding div_encoding = bitblast::DivEncoding::RESTORING);
 
   /** Recursively bit-blast `term`. */
   void bitblast(const Node& term);
@@ -33,19 +57,93 @@ class AigBitblaster
   const bitblast::AigBitblaster::Bits& bits(const Node& term) const;
 
   /** Count number of AIG nodes in term. */
-  uint64_t count_aig_ands(const Node& term, AigNodeRefSet& cache);
+  uint64_t count_aig_ands(const Node& term, AigNodeIdSet& cache);
 
   uint64_t num_aig_ands() const { return d_bitblaster.num_aig_ands(); }
   uint64_t num_aig_consts() const { return d_bitblaster.num_aig_consts(); }
   uint64_t num_aig_shared() const { return d_bitblaster.num_aig_shared(); }
 
+  /** @return Bit-blaster statistics. */
+  const Statistics& statistics() const { return d_statistics; }
+
+  /**
+   * Get and clear the side constraints created while bit-blasting since the
+   * last call. Side constraints only constrain fresh AIG constants and can
+   * thus be asserted globally.
+   */
+  bitblast::AigBitblaster::Bits take_side_constraints()
+  {
+    return d_bitblaster.take_side_constraints();
+  }
+
+  /**
+   * Enable recording the bits of bit-blasted leaves (see BvSolver::is_leaf()),
+   * which are retrieved via take_leaf_bits().
+   */
+  void record_leaf_bits() { d_record_leaf_bits = true; }
+
+  /**
+   * Get and clear the bits of the leaves bit-blasted since the last call.
+   * Only recorded if enabled via record_leaf_bits().
+   */
+  bitblast::AigBitblaster::Bits take_leaf_bits()
+  {
+    bitblast::AigBitblaster::Bits res;
+    res.swap(d_leaf_bits);
+    return res;
+  }
+
+  /** Create a fresh AIG constant that is not associated with any term. */
+  bitblast::AigNode mk_aig_const() { return d_bitblaster.bv_constant(1)[0]; }
+  /** Create AIG node representing true. */
+  bitblast::AigNode mk_aig_true() { return d_bitblaster.mk_true(); }
+  /** Create negation of AIG node `a`. */
+  bitblast::AigNode mk_aig_not(const bitblast::AigNode& a)
+  {
+    return d_bitblaster.mk_not(a);
+  }
+  /** Create AND gate of AIG nodes `a` and `b`. */
+  bitblast::AigNode mk_aig_and(const bitblast::AigNode& a,
+                               const bitblast::AigNode& b)
+  {
+    return d_bitblaster.mk_and(a, b);
+  }
+
  private:
+  /**
+   * Bit-blast multiplication `term` and record the size and depth of the
+   * created multiplier circuit.
+   */
+  bitblast::AigBitblaster::Bits bitblast_mul(const Node& term);
+
+  /**
+   * Bit-blast division or remainder `term`. Quotient and remainder share the
+   * divider circuit, which is constructed once per pair of operands.
+   */
+  const bitblast::AigBitblaster::Bits& bitblast_udiv_urem(const Node& term);
+
   bitblast::AigBitblaster::Bits d_empty;
 
   /** AIG bit-blaster. */
   bitblast::AigBitblaster d_bitblaster;
   /** Cached to store bit-blasted terms and their encoded bits. */
-  std::unordered_map<Node, bitblast::AigBitblaster::Bits> d_bitblaster_cache;
+  backtrack::unordered_map<Node, bitblast::AigBitblaster::Bits>
+      d_bitblaster_cache;
+  /**
+   * Cache that maps pairs of operand node ids of bit-vector division and
+   * remainder to the bits of the quotient and remainder.
+   */
+  backtrack::unordered_map<std::pair<uint64_t, uint64_t>,
+                           std::pair<bitblast::AigBitblaster::Bits,
+                                     bitblast::AigBitblaster::Bits>>
+      d_divider_cache;
+
+  Statistics d_statistics;
+
+  /** True if the bits of bit-blasted leaves are recorded. */
+  bool d_record_leaf_bits = false;
+  /** Leaf bits not yet retrieved via take_leaf_bits(). */
+  bitblast::AigBitblaster::Bits d_leaf_bits;
 };
 
 }  // namespace bzla::bv
@@ -0,0 +1,334 @@
+/***
+ * Bitwuzla: Satisfiability Modulo Theories (SMT) solver.
+ *
+ * Copyright (C) 2023 by the authors listed in the AUTHORS file at
+ * https://github.com/bitwuzla/bitwuzla/blob/main/AUTHORS
+ *
+ * This file is part of Bitwuzla under the MIT license. See COPYING for more
+ * information at https://github.com/bitwuzla/bitwuzla/blob/main/COPYING
+ */
+
+#include "solver/bv/aig_sweeper.h"
+
+#include <cassert>
+
+#include "bitblast/aig/aig_simulator.h"
+#include "sat/sat_solver_factory.h"
+
+namespace bzla::bv {
+
+using namespace bitblast;
+
+/** Sat solver wrapper for the CNF encoder of the sweeper. */
+class AigSweeper::SweepSatSolver : public SatInterface
+{
+ public:
+  SweepSatSolver(sat::SatSolver& solver) : d_solver(solver) {}
+
+  void add(int64_t lit) override { d_solver.add(static_cast<int32_t>(lit)); }
+
+  void add_clause(const std::initializer_list<int64_t>& literals) override
+  {
+    for (int64_t lit : literals)
+    {
+      add(lit);
+    }
+    add(0);
+  }
+
+  bool value(int64_t lit) override
+  {
+    return d_solver.value(static_cast<int32_t>(lit)) == 1;
+  }
+
+ private:
+  sat::SatSolver& d_solver;
+};
+
+/**
+ * Terminator that bounds SAT calls by the number of terminator polls, or if
+ * the wrapped terminator terminates.
+ */
+class AigSweeper::LimitTerminator : public Terminator
+{
+ public:
+  LimitTerminator(uint64_t limit) : d_limit(limit) {}
+  ~LimitTerminator() override {}
+
+  bool terminate() override
+  {
+    return ++d_polls > d_limit
+           || (d_terminator != nullptr && d_terminator->terminate());
+  }
+
+  /** Reset poll counter and set the wrapped terminator. */
+  void reset(Terminator* terminator)
+  {
+    d_polls      = 0;
+    d_terminator = terminator;
+  }
+
+ private:
+  uint64_t d_limit;
+  uint64_t d_polls         = 0;
+  Terminator* d_terminator = nullptr;
+};
+
+AigSweeper::AigSweeper(AigBitblaster& bitblaster, uint32_t seed)
+    : d_bitblaster(bitblaster),
+      d_sat_solver(sat::new_sat_solver(option::SatSolver::CADICAL)),
+      d_sat_interface(new SweepSatSolver(*d_sat_solver)),
+      d_cnf_encoder(new AigCnfEncoder(*d_sat_interface)),
+      d_terminator(new LimitTerminator(s_sat_limit)),
+      d_rng(seed)
+{
+  // We always use CaDiCaL since we need support for assumptions.
+  d_sat_solver->configure_terminator(d_terminator.get());
+}
+
+AigSweeper::~AigSweeper() {}
+
+void
+AigSweeper::push()
+{
+  d_merged_scopes.emplace_back();
+}
+
+void
+AigSweeper::pop()
+{
+  assert(!d_merged_scopes.empty());
+  for (int64_t id : d_merged_scopes.back())
+  {
+    d_merged.erase(id);
+  }
+  d_merged_scopes.pop_back();
+}
+
+std::vector<AigNode>
+AigSweeper::sweep(const std::vector<AigNode>& roots, Terminator* terminator)
+{
+  // The true node represents the class of constant nodes.
+  std::vector<AigNode> cone_roots{d_bitblaster.mk_aig_true()};
+  cone_roots.insert(cone_roots.end(), roots.begin(), roots.end());
+  AigSimulator simulator(cone_roots);
+  size_t size = simulator.size();
+
+  // The non-negated nodes, indexed as in the simulator.
+  std::vector<AigNode> nodes;
+  nodes.reserve(size);
+  for (size_t i = 0; i < size; ++i)
+  {
+    const AigNode& node = simulator.node(i);
+    nodes.push_back(node.is_negated() ? d_bitblaster.mk_aig_not(node) : node);
+  }
+
+  // Simulation words of each input, initialized with random patterns.
+  const std::vector<size_t>& inputs = simulator.inputs();
+  std::vector<std::vector<uint64_t>> input_words(inputs.size());
+  for (auto& words : input_words)
+  {
+    for (size_t w = 0; w < s_num_sim_words; ++w)
+    {
+      words.push_back(d_rng.pick<uint64_t>());
+    }
+  }
+  auto simulate = [&]() {
+    size_t num_words = input_words[0].size();
+    std::vector<uint64_t> patterns;
+    patterns.reserve(inputs.size() * num_words);
+    for (const auto& words : input_words)
+    {
+      patterns.insert(patterns.end(), words.begin(), words.end());
+    }
+    simulator.simulate(patterns, num_words);
+  };
+  if (!inputs.empty())
+  {
+    simulate();
+  }
+  else
+  {
+    simulator.simulate({}, 1);
+  }
+
+  // Signature of node i, normalized such that the first pattern bit is 0.
+  auto hash = [&simulator](size_t i) {
+    const uint64_t* values = simulator.values(i);
+    uint64_t phase         = values[0] & 1 ? ~uint64_t(0) : 0;
+    uint64_t res           = 14695981039346656037u;
+    for (size_t w = 0, n = simulator.num_words(); w < n; ++w)
+    {
+      res = (res ^ (values[w] ^ phase)) * 1099511628211u;
+    }
+    return res;
+  };
+  // True if the signatures of nodes i and j are equal (complementary if
+  // negated is true).
+  auto equal = [&simulator](size_t i, size_t j, bool negated) {
+    const uint64_t* vi = simulator.values(i);
+    const uint64_t* vj = simulator.values(j);
+    uint64_t phase     = negated ? ~uint64_t(0) : 0;
+    for (size_t w = 0, n = simulator.num_words(); w < n; ++w)
+    {
+      if ((vi[w] ^ vj[w]) != phase)
+      {
+        return false;
+      }
+    }
+    return true;
+  };
+
+  // Candidate classes, maps signatures to the representative nodes.
+  std::unordered_map<uint64_t, std::vector<size_t>> classes;
+  // All representative nodes processed so far.
+  std::vector<size_t> reps;
+  // The swept node of each node.
+  std::vector<AigNode> swept;
+  swept.reserve(size);
+  auto lit = [&swept, this](size_t fanin) {
+    const AigNode& node = swept[fanin >> 1];
+    return fanin & 1 ? d_bitblaster.mk_aig_not(node) : node;
+  };
+
+  // Counterexample patterns of refuted candidates, one word per input.
+  std::vector<uint64_t> cex(inputs.size());
+  size_t num_cex = 0;
+
+  for (size_t i = 0; i < size; ++i)
+  {
+    const AigNode& node = nodes[i];
+    bool merged         = false;
+
+    auto it = d_merged.find(node.get_id());
+    if (it != d_merged.end())
+    {
+      swept.push_back(it->second);
+    }
+    else if (node.is_and())
+    {
+      auto cit = classes.find(hash(i));
+      if (cit != classes.end())
+      {
+        size_t num_checked = 0;
+        for (size_t j : cit->second)
+        {
+          bool negated = (simulator.values(i)[0] ^ simulator.values(j)[0]) & 1;
+          if (!equal(i, j, negated))
+          {
+            continue;
+          }
+          ++d_statistics.num_candidates;
+          d_terminator->reset(terminator);
+          Result res = prove(node, nodes[j], negated);
+          if (res == Result::UNSAT)
+          {
+            ++d_statistics.num_merged;
+            swept.push_back(negated ? d_bitblaster.mk_aig_not(swept[j])
+                                    : swept[j]);
+            d_merged.emplace(node.get_id(), swept.back());
+            if (!d_merged_scopes.empty())
+            {
+              d_merged_scopes.back().push_back(node.get_id());
+            }
+            merged = true;
+            break;
+          }
+          if (res == Result::SAT)
+          {
+            ++d_statistics.num_refuted;
+            for (size_t k = 0, n = inputs.size(); k < n; ++k)
+            {
+              const AigNode& input = nodes[inputs[k]];
+              bool val             = d_cnf_encoder->is_encoded(input)
+                                         ? d_cnf_encoder->value(input) == 1
+                                         : d_rng.flip_coin();
+              if (val)
+              {
+                cex[k] |= uint64_t(1) << num_cex;
+              }
+            }
+            ++num_cex;
+          }
+          else
+          {
+            ++d_statistics.num_unknown;
+          }
+          if (++num_checked == s_max_candidates || num_cex == 64)
+          {
+            break;
+          }
+        }
+      }
+      if (!merged)
+      {
+        swept.push_back(d_bitblaster.mk_aig_and(
+            lit(simulator.fanin(i, 0)), lit(simulator.fanin(i, 1))));
+      }
+    }
+    else
+    {
+      swept.push_back(node);
+    }
+
+    if (!merged)
+    {
+      reps.push_back(i);
+      classes[hash(i)].push_back(i);
+    }
+
+    // Refine candidate classes with the collected counterexamples.
+    if (num_cex == 64)
+    {
+      for (size_t k = 0, n = inputs.size(); k < n; ++k)
+      {
+        input_words[k].push_back(cex[k]);
+      }
+      simulate();
+      std::fill(cex.begin(), cex.end(), 0);
+      num_cex = 0;
+      classes.clear();
+      for (size_t j : reps)
+      {
+        classes[hash(j)].push_back(j);
+      }
+    }
+  }
+
+  std::vector<AigNode> res;
+  for (const AigNode& root : roots)
+  {
+    const AigNode& node = swept[simulator.index(root)];
+    res.push_back(root.is_negated() ? d_bitblaster.mk_aig_not(node) : node);
+  }
+  return res;
+}
+
+Result
+AigSweeper::prove(const AigNode& a, const AigNode& b, bool negated)
+{
+  d_cnf_encoder->encode(a);
+  d_cnf_encoder->encode(b);
+
+  int32_t la = static_cast<int32_t>(a.get_id());
+  int32_t lb = static_cast<int32_t>(negated ? -b.get_id() : b.get_id());
+
+  // Check a /\ ~b and ~a /\ b.
+  for (int32_t sign : {1, -1})
+  {
+    d_sat_solver->assume(sign * la);
+    d_sat_solver->assume(-sign * lb);
+    Result res = d_sat_solver->solve();
+    if (res != Result::UNSAT)
+    {
+      return res;
+    }
+  }
+
+  // Add proven equivalence to speed up subsequent checks.
+  d_sat_interface->add_clause({-la, lb});
+  d_sat_interface->add_clause({la, -lb});
+  return Result::UNSAT;
+}
+
+}  // namespace bzla::bv
@@ -0,0 +1,130 @@
+/***
+ * Bitwuzla: Satisfiability Modulo Theories (SMT) solver.
+ *
+ * Copyright (C) 2023 by the authors listed in the AUTHORS file at
+ * https://github.com/bitwuzla/bitwuzla/blob/main/AUTHORS
+ *
+ * This file is part of Bitwuzla under the MIT license. See COPYING for more
+ * information at https://github.com/bitwuzla/bitwuzla/blob/main/COPYING
+ */
+
+#ifndef BZLA_SOLVER_BV_AIG_SWEEPER_H_INCLUDED
+#define BZLA_SOLVER_BV_AIG_SWEEPER_H_INCLUDED
+
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include "bitblast/aig/aig_cnf.h"
+#include "rng/rng.h"
+#include "sat/sat_solver.h"
+#include "solver/bv/aig_bitblaster.h"
+#include "terminator.h"
+
+namespace bzla::bv {
+
+/**
+ * SAT sweeping of AIGs (functionally reduced AIGs, FRAIGs).
+ *
+ * Nodes in the cones of given roots are simulated with random input
+ * patterns to determine candidate equivalences, i.e., nodes with equal (or
+ * complementary) simulation signatures. Candidates are proved equivalent
+ * with bounded SAT calls on a dedicated SAT solver, and proven equivalent
+ * nodes are merged by rebuilding the cones with a representative node.
+ * Counterexamples of refuted candidates are collected as additional
+ * simulation patterns to refine the candidate classes.
+ *
+ * Since only unconditional equivalences are merged, the result is valid
+ * independently of the assertions the roots belong to.
+ */
+class AigSweeper
+{
+ public:
+  struct Statistics
+  {
+    /** Number of candidate equivalences checked via SAT. */
+    uint64_t num_candidates = 0;
+    /** Number of merged nodes. */
+    uint64_t num_merged = 0;
+    /** Number of candidate equivalences refuted via SAT. */
+    uint64_t num_refuted = 0;
+    /** Number of candidate equivalences not decided within the limit. */
+    uint64_t num_unknown = 0;
+  };
+
+  /**
+   * Constructor.
+   * @param bitblaster The bit-blaster the swept AIG nodes belong to.
+   * @param seed The seed for the random simulation patterns.
+   */
+  AigSweeper(AigBitblaster& bitblaster, uint32_t seed);
+  ~AigSweeper();
+
+  /**
+   * Sweep the cones of given roots.
+   * @param roots The roots to sweep.
+   * @param terminator The terminator of the SAT calls, may be null.
+   * @return The roots with functionally equivalent nodes merged, in the same
+   *         order as `roots`.
+   */
+  std::vector<bitblast::AigNode> sweep(
+      const std::vector<bitblast::AigNode>& roots, Terminator* terminator);
+
+  /** Open a new scope for the merged nodes recorded by sweep(). */
+  void push();
+  /**
+   * Close the current scope and forget the nodes merged in it, which
+   * releases their swept cones.
+   */
+  void pop();
+
+  /** @return Sweeping statistics. */
+  const Statistics& statistics() const { return d_statistics; }
+
+ private:
+  /** Number of initial random simulation patterns, as multiple of 64. */
+  static constexpr size_t s_num_sim_words = 4;
+  /** Maximum number of candidates a node is checked against. */
+  static constexpr size_t s_max_candidates = 4;
+  /** Limit for the number of terminator polls per SAT call. */
+  static constexpr uint64_t s_sat_limit = 1000;
+
+  class SweepSatSolver;
+  class LimitTerminator;
+
+  /**
+   * Prove that `a` is equivalent to `b` (or to the negation of `b` if
+   * `negated` is true) via SAT.
+   * @return Result::UNSAT if equivalent, Result::SAT if refuted and
+   *         Result::UNKNOWN if the limit was exhausted.
+   */
+  Result prove(const bitblast::AigNode& a,
+               const bitblast::AigNode& b,
+               bool negated);
+
+  /** The associated bit-blaster. */
+  AigBitblaster& d_bitblaster;
+  /** The SAT solver used for proving equivalences. */
+  std::unique_ptr<sat::SatSolver> d_sat_solver;
+  /** SAT interface for the CNF encoder, wraps `d_sat_solver`. */
+  std::unique_ptr<SweepSatSolver> d_sat_interface;
+  /** The CNF encoder for `d_sat_solver`. */
+  std::unique_ptr<bitblast::AigCnfEncoder> d_cnf_encoder;
+  /** The terminator used to limit SAT calls. */
+  std::unique_ptr<LimitTerminator> d_terminator;
+  /**
+   * Maps ids of merged nodes to the node they were merged with in previous
+   * calls to sweep().
+   */
+  std::unordered_map<int64_t, bitblast::AigNode> d_merged;
+  /** The ids of the nodes merged in each open scope, erased on pop(). */
+  std::vector<std::vector<int64_t>> d_merged_scopes;
+  /** Random number generator for simulation patterns. */
+  RNG d_rng;
+
+  Statistics d_statistics;
+};
+
+}  // namespace bzla::bv
+
+#endif
@@ -10,6 +10,11 @@
 
 #include "solver/bv/bv_bitblast_solver.h"
 
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+
+#include "bitblast/aig/aig_simulator.h"
 #include "bv/bitvector.h"
 #include "node/node_manager.h"
 #include "node/node_ref_vector.h"
@@ -18,6 +23,7 @@
 #include "sat/sat_solver_factory.h"
 #include "solver/bv/bv_solver.h"
 #include "solving_context.h"
+#include "worker_terminator.h"
 
 namespace bzla::bv {
 
@@ -27,40 +33,183 @@ using namespace bzla::node;
 class BvBitblastSolver::BitblastSatSolver : public bitblast::SatInterface
 {
  public:
-  BitblastSatSolver(sat::SatSolver& solver) : d_solver(solver) {}
+  BitblastSatSolver(sat::SatSolver& solver, bool log_clauses)
+      : d_solver(solver), d_value_solver(&solver), d_log_clauses(log_clauses)
+  {
+  }
 
-  void add(int64_t lit) override { d_solver.add(lit); }
+  void add(int64_t lit) override
+  {
+    d_solver.add(lit);
+    if (d_log_clauses)
+    {
+      d_clauses.push_back(lit);
+    }
+  }
 
   void add_clause(const std::initializer_list<int64_t>& literals) override
   {
     for (int64_t lit : literals)
     {
-      d_solver.add(lit);
+      add(lit);
     }
-    d_solver.add(0);
+    add(0);
   }
 
   bool value(int64_t lit) override
   {
-    return d_solver.value(lit) == 1 ? true : false;
+    return d_value_solver->value(lit) == 1 ? true : false;
+  }
+
+  /** Set the SAT solver that holds the current model. */
+  void set_value_solver(sat::SatSolver& solver) { d_value_solver = &solver; }
+
+  /**
+   * @return All clauses added since the last call to clear_clauses(), each
+   *         terminated with 0.
+   */
+  const std::vector<int32_t>& clauses() const { return d_clauses; }
+
+  /** Clear the clause log, called after the log was replayed. */
+  void clear_clauses() { std::vector<int32_t>().swap(d_clauses); }
+
+  /**
+   * Remove all logged clauses guarded by given activation literal, which is
+   * about to be permanently disabled.
+   */
+  void retire_clauses(int64_t activation)
+  {
+    size_t j = 0;
+    for (size_t i = 0, size = d_clauses.size(); i < size;)
+    {
+      size_t end = i;
+      while (d_clauses[end] != 0)
+      {
+        ++end;
+      }
+      if (d_clauses[i] != -activation)
+      {
+        j = std::copy(d_clauses.begin() + i, d_clauses.begin() + end + 1,
+                      d_clauses.begin() + j)
+            - d_clauses.begin();
+      }
+      i = end + 1;
+    }
+    d_clauses.resize(j);
   }
 
  private:
   sat::SatSolver& d_solver;
+  /** The SAT solver used for value queries. */
+  sat::SatSolver* d_value_solver;
+  /** True if added clauses are recorded in `d_clauses`. */
+  bool d_log_clauses;
+  /** The clause log, only recorded if `d_log_clauses` is true. */
+  std::vector<int32_t> d_clauses;
+};
+
+/** Syncs the encoding scopes of the CNF encoder with the solver scopes. */
+class BvBitblastSolver::ScopeTracker : public backtrack::Backtrackable
+{
+ public:
+  ScopeTracker(backtrack::BacktrackManager* mgr, BvBitblastSolver& solver)
+      : Backtrackable(mgr), d_solver(solver)
+  {
+  }
+
+  void push() override { d_solver.push_scope(); }
+
+  void pop() override { d_solver.pop_scope(); }
+
+ private:
+  BvBitblastSolver& d_solver;
 };
 
+/** External propagator that checks theory consistency during SAT search. */
+class BvBitblastSolver::TheoryPropagator : public sat::Propagator
+{
+ public:
+  TheoryPropagator(BvBitblastSolver& solver) : d_solver(solver) {}
+
+  bool check_model() override { return d_solver.check_model(); }
+
+ private:
+  BvBitblastSolver& d_solver;
+};
+
+namespace {
+
+bitblast::MulEncoding
+mul_encoding(option::BvMulEncoding encoding)
+{
+  switch (encoding)
+  {
+    case option::BvMulEncoding::BOOTH: return bitblast::MulEncoding::BOOTH;
+    case option::BvMulEncoding::WALLACE: return bitblast::MulEncoding::WALLACE;
+    case option::BvMulEncoding::KARATSUBA:
+      return bitblast::MulEncoding::KARATSUBA;
+    default: assert(encoding == option::BvMulEncoding::ARRAY);
+  }
+  return bitblast::MulEncoding::ARRAY;
+}
+
+bitblast::DivEncoding
+div_encoding(option::BvDivEncoding encoding)
+{
+  switch (encoding)
+  {
+    case option::BvDivEncoding::NON_RESTORING:
+      return bitblast::DivEncoding::NON_RESTORING;
+    case option::BvDivEncoding::MULTIPLIER:
+      return bitblast::DivEncoding::MULTIPLIER;
+    default: assert(encoding == option::BvDivEncoding::RESTORING);
+  }
+  return bitblast::DivEncoding::RESTORING;
+}
+
+}  // namespace
+
 /* --- BvBitblastSolver public ---------------------------------------------- */
 
 BvBitblastSolver::BvBitblastSolver(Env& env, SolverState& state)
     : Solver(env, state),
       d_assertions(state.backtrack_mgr()),
+      d_lemmas(state.backtrack_mgr()),
       d_assumptions(state.backtrack_mgr()),
+      d_bitblaster(state.backtrack_mgr(),
+                   mul_encoding(env.options().bv_mul_encoding()),
+                   div_encoding(env.options().bv_div_encoding())),
       d_last_result(Result::UNKNOWN),
+      d_lemma_roots(state.backtrack_mgr()),
+      d_sim_rounds(env.options().bv_sim_rounds()),
+      d_rng(env.options().seed()),
       d_stats(env.statistics(), "solver::bv::bitblast::")
 {
+  if (env.options().bv_cube_threads() > 1)
+  {
+    d_cube_threads = env.options().bv_cube_threads();
+  }
   d_sat_solver.reset(sat::new_sat_solver(env.options().sat_solver()));
-  d_bitblast_sat_solver.reset(new BitblastSatSolver(*d_sat_solver));
-  d_cnf_encoder.reset(new bitblast::AigCnfEncoder(*d_bitblast_sat_solver));
+  d_bitblast_sat_solver.reset(
+      new BitblastSatSolver(*d_sat_solver, d_cube_threads > 0));
+  // Values are only queried for inputs, we can thus use a polarity-aware
+  // encoding.
+  d_cnf_encoder.reset(
+      new bitblast::AigCnfEncoder(*d_bitblast_sat_solver, true));
+  d_scope_tracker.reset(new ScopeTracker(state.backtrack_mgr(), *this));
+  if (env.options().bv_sweep())
+  {
+    d_sweeper.reset(new AigSweeper(d_bitblaster, env.options().seed()));
+  }
+  // Cube-and-conquer solves with worker SAT solvers, which are not
+  // connected to the propagator.
+  if (env.options().bv_sat_propagator() && d_cube_threads == 0
+      && d_sat_solver->supports_propagator())
+  {
+    d_bitblaster.record_leaf_bits();
+    d_propagator.reset(new TheoryPropagator(*this));
+    d_sat_solver->connect_propagator(d_propagator.get());
+  }
 }
 
 BvBitblastSolver::~BvBitblastSolver() {}
@@ -69,33 +218,127 @@ Result
 BvBitblastSolver::solve()
 {
   d_sat_solver->configure_terminator(d_env.terminator());
+  d_bitblast_sat_solver->set_value_solver(*d_sat_solver);
+  d_cube_used = false;
+  d_sim_used  = false;
 
-  if (!d_assertions.empty())
   {
     util::Timer timer(d_stats.time_encode);
-    for (const Node& assertion : d_assertions)
+    // Side constraints only constrain fresh bits introduced by the
+    // bit-blaster, encode in global scope.
+    for (const auto& constraint : d_bitblaster.take_side_constraints())
     {
-      const auto& bits = d_bitblaster.bits(assertion);
-      assert(!bits.empty());
-      d_cnf_encoder->encode(bits[0], true);
+      d_cnf_encoder->encode(constraint, true, true);
+      if (d_cube_threads || d_sim_rounds)
+      {
+        d_assertion_roots.push_back(constraint);
+      }
     }
-    d_assertions.clear();
   }
 
+  // Collect roots of top-level assertions, lemmas and assumptions.
+  std::vector<bitblast::AigNode> roots;
+  for (const Node& assertion : d_assertions)
+  {
+    const auto& bits = d_bitblaster.bits(assertion);
+    assert(!bits.empty());
+    roots.push_back(bits[0]);
+  }
+  size_t num_assertions = roots.size();
+  for (const Node& lemma : d_lemmas)
+  {
+    const auto& bits = d_bitblaster.bits(lemma);
+    assert(!bits.empty());
+    roots.push_back(bits[0]);
+  }
+  size_t num_lemmas = roots.size() - num_assertions;
   for (const Node& assumption : d_assumptions)
   {
     const auto& bits = d_bitblaster.bits(assumption);
     assert(!bits.empty());
+    roots.push_back(bits[0]);
+  }
+  d_assertions.clear();
+  d_lemmas.clear();
+
+  if (d_sweeper && !roots.empty())
+  {
+    util::Timer timer(d_stats.time_sweep);
+    roots = d_sweeper->sweep(roots, d_env.terminator());
+  }
+
+  {
     util::Timer timer(d_stats.time_encode);
-    d_cnf_encoder->encode(bits[0], false);
-    d_sat_solver->assume(bits[0].get_id());
+    auto it = roots.begin();
+    for (auto end = it + num_assertions; it != end; ++it)
+    {
+      // Top-level assertions are never popped, encode in global scope.
+      d_cnf_encoder->encode(*it, true, true);
+      if (d_cube_threads || d_sim_rounds)
+      {
+        d_assertion_roots.push_back(*it);
+      }
+    }
+    for (auto end = it + num_lemmas; it != end; ++it)
+    {
+      d_cnf_encoder->encode(*it, true);
+      if (d_cube_threads || d_sim_rounds)
+      {
+        d_lemma_roots.push_back(*it);
+      }
+    }
+    d_assumption_roots.assign(it, roots.end());
+    for (const auto& assumption : d_assumption_roots)
+    {
+      d_cnf_encoder->encode(assumption, false);
+    }
   }
+  const auto& assumptions = d_assumption_roots;
 
   // Update CNF statistics
   update_statistics();
 
+  if (d_propagator)
+  {
+    observe_leaves();
+  }
+
+  if (d_sim_rounds && simulate(assumptions))
+  {
+    d_sim_used    = true;
+    d_last_result = Result::SAT;
+    return d_last_result;
+  }
+
   util::Timer timer(d_stats.time_sat);
-  d_last_result = d_sat_solver->solve();
+  if (d_cube_threads)
+  {
+    d_last_result = solve_cubes(assumptions);
+  }
+  else
+  {
+    for (int64_t lit : d_cnf_encoder->activation_lits())
+    {
+      d_sat_solver->assume(lit);
+    }
+    for (const auto& assumption : assumptions)
+    {
+      d_sat_solver->assume(assumption.get_id());
+    }
+    d_last_result = d_sat_solver->solve();
+  }
+
+  if (d_sim_rounds && d_last_result == Result::SAT)
+  {
+    // Guide simulation in the next call with the current assignment.
+    d_sim_model.clear();
+    for (const auto& input : d_sim_inputs)
+    {
+      int32_t val = d_cnf_encoder->value(input);
+      d_sim_model.emplace(std::abs(input.get_id()),
+                          (val == 1) != input.is_negated());
+    }
+  }
 
   return d_last_result;
 }
@@ -115,6 +358,10 @@ BvBitblastSolver::register_assertion(const Node& assertion,
   {
     d_assumptions.push_back(assertion);
   }
+  else if (is_lemma)
+  {
+    d_lemmas.push_back(assertion);
+  }
   else
   {
     d_assertions.push_back(assertion);
@@ -147,13 +394,13 @@ BvBitblastSolver::value(const Node& term)
 
   if (type.is_bool())
   {
-    return nm.mk_value(d_cnf_encoder->value(bits[0]) == 1);
+    return nm.mk_value(bit_value(bits[0]) == 1);
   }
 
   BitVector val(type.bv_size());
   for (size_t i = 0, size = bits.size(); i < size; ++i)
   {
-    val.set_bit(size - 1 - i, d_cnf_encoder->value(bits[i]) == 1);
+    val.set_bit(size - 1 - i, bit_value(bits[i]) == 1);
   }
   return nm.mk_value(val);
 }
@@ -164,13 +411,20 @@ BvBitblastSolver::unsat_core(std::vector<Node>& core) const
   assert(d_last_result == Result::UNSAT);
   assert(d_env.options().produce_unsat_cores());
 
-  for (const Node& assumption : d_assumptions)
+  assert(d_assumption_roots.size() == d_assumptions.size());
+  for (size_t i = 0, size = d_assumptions.size(); i < size; ++i)
   {
-    const auto& bits = d_bitblaster.bits(assumption);
-    assert(bits.size() == 1);
-    if (d_sat_solver->failed(bits[0].get_id()))
+    int64_t id = d_assumption_roots[i].get_id();
+    if (d_cube_used)
+    {
+      if (d_cube_failed.find(id) != d_cube_failed.end())
+      {
+        core.push_back(d_assumptions[i]);
+      }
+    }
+    else if (d_sat_solver->failed(id))
     {
-      core.push_back(assumption);
+      core.push_back(d_assumptions[i]);
     }
   }
 }
@@ -180,13 +434,397 @@ BvBitblastSolver::unsat_core(std::vector<Node>& core) const
 void
 BvBitblastSolver::update_statistics()
 {
-  d_stats.num_aig_ands     = d_bitblaster.num_aig_ands();
-  d_stats.num_aig_consts   = d_bitblaster.num_aig_consts();
-  d_stats.num_aig_shared   = d_bitblaster.num_aig_shared();
-  auto& cnf_stats          = d_cnf_encoder->statistics();
-  d_stats.num_cnf_vars     = cnf_stats.num_vars;
-  d_stats.num_cnf_clauses  = cnf_stats.num_clauses;
-  d_stats.num_cnf_literals = cnf_stats.num_literals;
+  d_stats.num_aig_ands      = d_bitblaster.num_aig_ands();
+  d_stats.num_aig_consts    = d_bitblaster.num_aig_consts();
+  d_stats.num_aig_shared    = d_bitblaster.num_aig_shared();
+  d_stats.num_aig_mul_ands  = d_bitblaster.statistics().num_mul_ands;
+  d_stats.max_aig_mul_depth = d_bitblaster.statistics().max_mul_depth;
+  auto& cnf_stats           = d_cnf_encoder->statistics();
+  d_stats.num_cnf_vars      = cnf_stats.num_vars;
+  d_stats.num_cnf_clauses   = cnf_stats.num_clauses;
+  d_stats.num_cnf_literals  = cnf_stats.num_literals;
+  d_stats.num_cnf_retired   = cnf_stats.num_retired;
+  if (d_sweeper)
+  {
+    auto& sweep_stats         = d_sweeper->statistics();
+    d_stats.num_sweep_checks  = sweep_stats.num_candidates;
+    d_stats.num_sweep_merged  = sweep_stats.num_merged;
+    d_stats.num_sweep_refuted = sweep_stats.num_refuted;
+    d_stats.num_sweep_unknown = sweep_stats.num_unknown;
+  }
+}
+
+void
+BvBitblastSolver::push_scope()
+{
+  d_activation.push_back(d_bitblaster.mk_aig_const());
+  d_cnf_encoder->push(d_activation.back().get_id());
+  if (d_sweeper)
+  {
+    d_sweeper->push();
+  }
+}
+
+void
+BvBitblastSolver::pop_scope()
+{
+  if (d_cube_threads)
+  {
+    d_bitblast_sat_solver->retire_clauses(d_activation.back().get_id());
+  }
+  d_cnf_encoder->pop();
+  if (d_sweeper)
+  {
+    d_sweeper->pop();
+  }
+  // AIG ids are never reused, the activation literal thus stays disabled.
+  d_activation.pop_back();
+  update_statistics();
+}
+
+bool
+BvBitblastSolver::check_model()
+{
+  util::Timer timer(d_stats.time_propagator);
+  ++d_stats.num_propagator_checks;
+  if (d_solver_state.check_theories())
+  {
+    return true;
+  }
+  ++d_stats.num_propagator_conflicts;
+
+  // The lemmas were registered via register_assertion(). Encode them in the
+  // current scope as in solve(), the resulting clauses are added to the SAT
+  // solver via the propagator. They may refer to Tseitin variables of any
+  // bit-blasted term, the SAT solver is responsible for keeping these
+  // variables intact and for observing them.
+  util::Timer timer_encode(d_stats.time_encode);
+  for (const auto& constraint : d_bitblaster.take_side_constraints())
+  {
+    d_cnf_encoder->encode(constraint, true, true);
+    if (d_sim_rounds)
+    {
+      d_assertion_roots.push_back(constraint);
+    }
+  }
+  for (const Node& lemma : d_lemmas)
+  {
+    const auto& bits = d_bitblaster.bits(lemma);
+    assert(!bits.empty());
+    d_cnf_encoder->encode(bits[0], true);
+    if (d_sim_rounds)
+    {
+      d_lemma_roots.push_back(bits[0]);
+    }
+  }
+  d_lemmas.clear();
+  observe_leaves();
+  update_statistics();
+  return false;
+}
+
+void
+BvBitblastSolver::observe_leaves()
+{
+  for (const auto& bit : d_bitblaster.take_leaf_bits())
+  {
+    d_sat_solver->observe(std::abs(bit.get_id()));
+  }
+}
+
+Result
+BvBitblastSolver::solve_cubes(const std::vector<bitblast::AigNode>& assumptions)
+{
+  std::vector<int32_t> vars = select_cube_vars(assumptions);
+  const std::vector<int64_t>& activation = d_cnf_encoder->activation_lits();
+  if (vars.empty())
+  {
+    for (int64_t lit : activation)
+    {
+      d_sat_solver->assume(lit);
+    }
+    for (const auto& assumption : assumptions)
+    {
+      d_sat_solver->assume(assumption.get_id());
+    }
+    return d_sat_solver->solve();
+  }
+
+  util::Timer timer(d_stats.time_cubes);
+
+  // Worker solvers need to support assumptions, hence we always use CaDiCaL.
+  while (d_cube_solvers.size() < d_cube_threads)
+  {
+    d_cube_solvers.emplace_back(
+        sat::new_sat_solver(option::SatSolver::CADICAL));
+  }
+
+  const std::vector<int32_t>& clauses = d_bitblast_sat_solver->clauses();
+  size_t num_cubes                    = size_t(1) << vars.size();
+  std::atomic<bool> done              = false;
+  std::atomic<size_t> next_cube       = 0;
+  // Terminates all workers once the result is determined by one of the
+  // cubes, or if the terminator of the solving context terminates.
+  WorkerTerminator terminator(d_env.terminator());
+
+  // The following are guarded by `mutex`.
+  std::mutex mutex;
+  Result res                   = Result::UNSAT;
+  sat::SatSolver* model_solver = nullptr;
+  uint64_t num_pruned          = 0;
+  // Refuted partial cubes, stored as pair of a mask of the cube variables
+  // and the signs of the masked variables.
+  std::vector<std::pair<size_t, size_t>> refuted;
+  d_cube_failed.clear();
+
+  Log(1) << "solve " << num_cubes << " cubes with " << d_cube_threads
+         << " threads";
+
+  auto conquer = [&](sat::SatSolver& solver) {
+    for (int32_t lit : clauses)
+    {
+      solver.add(lit);
+    }
+    solver.configure_terminator(&terminator);
+
+    std::vector<int32_t> cube_lits(vars.size());
+    while (!done)
+    {
+      size_t cube = next_cube.fetch_add(1);
+      if (cube >= num_cubes)
+      {
+        break;
+      }
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (std::any_of(refuted.begin(), refuted.end(), [cube](const auto& r) {
+              return (cube & r.first) == r.second;
+            }))
+        {
+          ++num_pruned;
+          continue;
+        }
+      }
+
+      for (int64_t lit : activation)
+      {
+        solver.assume(lit);
+      }
+      for (const auto& assumption : assumptions)
+      {
+        solver.assume(assumption.get_id());
+      }
+      for (size_t i = 0, size = vars.size(); i < size; ++i)
+      {
+        cube_lits[i] = (cube >> i) & 1 ? vars[i] : -vars[i];
+        solver.assume(cube_lits[i]);
+      }
+      Result r = solver.solve();
+
+      std::lock_guard<std::mutex> lock(mutex);
+      if (r == Result::SAT)
+      {
+        if (!done)
+        {
+          res          = Result::SAT;
+          model_solver = &solver;
+          done         = true;
+          terminator.set_terminate();
+        }
+      }
+      else if (r == Result::UNSAT)
+      {
+        size_t mask = 0;
+        for (size_t i = 0, size = cube_lits.size(); i < size; ++i)
+        {
+          if (solver.failed(cube_lits[i]))
+          {
+            mask |= size_t(1) << i;
+          }
+        }
+        for (const auto& assumption : assumptions)
+        {
+          if (solver.failed(assumption.get_id()))
+          {
+            d_cube_failed.insert(assumption.get_id());
+          }
+        }
+        if (mask == 0)
+        {
+          // Unsat independent of the cube.
+          done = true;
+          terminator.set_terminate();
+        }
+        else
+        {
+          refuted.emplace_back(mask, cube & mask);
+        }
+      }
+      else if (!done)
+      {
+        res  = Result::UNKNOWN;
+        done = true;
+        terminator.set_terminate();
+      }
+    }
+    solver.configure_terminator(nullptr);
+  };
+
+  terminator.run(d_cube_solvers.size(),
+                 [&](size_t i) { conquer(*d_cube_solvers[i]); });
+  // All workers are in sync with the main SAT solver now.
+  d_bitblast_sat_solver->clear_clauses();
+
+  d_stats.num_cubes += num_cubes;
+  d_stats.num_cubes_pruned += num_pruned;
+  if (res == Result::SAT)
+  {
+    assert(model_solver);
+    d_bitblast_sat_solver->set_value_solver(*model_solver);
+  }
+  d_cube_used = res == Result::UNSAT;
+  return res;
+}
+
+bool
+BvBitblastSolver::simulate(const std::vector<bitblast::AigNode>& assumptions)
+{
+  util::Timer timer(d_stats.time_sim);
+
+  std::vector<bitblast::AigNode> roots(d_assertion_roots.begin(),
+                                       d_assertion_roots.end());
+  roots.insert(roots.end(), d_lemma_roots.begin(), d_lemma_roots.end());
+  roots.insert(roots.end(), assumptions.begin(), assumptions.end());
+
+  bitblast::AigSimulator simulator(roots);
+  const std::vector<size_t>& inputs = simulator.inputs();
+  d_sim_inputs.clear();
+  for (size_t i : inputs)
+  {
+    d_sim_inputs.push_back(simulator.node(i));
+  }
+
+  // Simulate 512 patterns per round.
+  constexpr size_t num_words = 8;
+  std::vector<uint64_t> patterns(inputs.size() * num_words);
+  Terminator* terminator = d_env.terminator();
+  for (uint64_t round = 0; round < d_sim_rounds; ++round)
+  {
+    if (terminator && terminator->terminate())
+    {
+      break;
+    }
+    ++d_stats.num_sim_rounds;
+    for (size_t k = 0, size = inputs.size(); k < size; ++k)
+    {
+      uint64_t* words = patterns.data() + k * num_words;
+      for (size_t w = 0; w < num_words; ++w)
+      {
+        words[w] = d_rng.pick<uint64_t>();
+      }
+      // Guide the first word of each round by the last satisfying
+      // assignment, where each bit is flipped with probability 1/16.
+      auto it = d_sim_model.find(std::abs(d_sim_inputs[k].get_id()));
+      if (it != d_sim_model.end())
+      {
+        uint64_t flip = words[0] & d_rng.pick<uint64_t>()
+                        & d_rng.pick<uint64_t>() & d_rng.pick<uint64_t>();
+        words[0] = (it->second ? ~uint64_t(0) : 0) ^ flip;
+      }
+    }
+    simulator.simulate(patterns, num_words);
+
+    size_t pattern;
+    if (simulator.find_pattern(roots, pattern))
+    {
+      ++d_stats.num_sim_sat;
+      d_sim_model.clear();
+      for (size_t i : inputs)
+      {
+        uint64_t word = simulator.values(i)[pattern / 64];
+        d_sim_model.emplace(std::abs(simulator.node(i).get_id()),
+                            (word >> (pattern % 64)) & 1);
+      }
+      return true;
+    }
+  }
+  return false;
+}
+
+int32_t
+BvBitblastSolver::bit_value(const bitblast::AigNode& bit) const
+{
+  if (!d_sim_used)
+  {
+    return d_cnf_encoder->value(bit);
+  }
+  if (bit.is_true() || bit.is_false())
+  {
+    return bit.is_true() ? 1 : -1;
+  }
+  // Inputs that do not occur in the simulated formula are unconstrained.
+  auto it  = d_sim_model.find(std::abs(bit.get_id()));
+  bool val = it != d_sim_model.end() && it->second;
+  return val != bit.is_negated() ? 1 : -1;
+}
+
+std::vector<int32_t>
+BvBitblastSolver::select_cube_vars(
+    const std::vector<bitblast::AigNode>& assumptions) const
+{
+  std::unordered_set<int64_t> cache;
+  std::vector<bitblast::AigNode> visit(d_assertion_roots.begin(),
+                                       d_assertion_roots.end());
+  visit.insert(visit.end(), d_lemma_roots.begin(), d_lemma_roots.end());
+  for (const auto& assumption : assumptions)
+  {
+    // Do not split on assumptions.
+    cache.insert(std::abs(assumption.get_id()));
+    if (assumption.is_and())
+    {
+      visit.push_back(assumption[0]);
+      visit.push_back(assumption[1]);
+    }
+  }
+
+  // Collect encoded AIG nodes with their number of parents.
+  std::vector<std::pair<uint32_t, int32_t>> candidates;
+  while (!visit.empty())
+  {
+    bitblast::AigNode cur = std::move(visit.back());
+    visit.pop_back();
+    int64_t id = std::abs(cur.get_id());
+    if (!cache.insert(id).second || cur.is_true() || cur.is_false())
+    {
+      continue;
+    }
+    if (d_cnf_encoder->is_encoded(cur))
+    {
+      candidates.emplace_back(cur.parents(), static_cast<int32_t>(id));
+    }
+    if (cur.is_and())
+    {
+      visit.push_back(cur[0]);
+      visit.push_back(cur[1]);
+    }
+  }
+
+  size_t n = std::min<size_t>(candidates.size(),
+                              d_env.options().bv_cube_depth());
+  std::partial_sort(
+      candidates.begin(),
+      candidates.begin() + n,
+      candidates.end(),
+      [](const auto& a, const auto& b) {
+        return a.first > b.first || (a.first == b.first && a.second < b.second);
+      });
+
+  std::vector<int32_t> res;
+  for (size_t i = 0; i < n; ++i)
+  {
+    res.push_back(candidates[i].second);
+  }
+  return res;
 }
 
 BvBitblastSolver::Statistics::Statistics(util::Statistics& stats,
@@ -200,9 +838,34 @@ BvBitblastSolver::Statistics::Statistics(util::Statistics& stats,
       num_aig_ands(stats.new_stat<uint64_t>(prefix + "aig::num_ands")),
       num_aig_consts(stats.new_stat<uint64_t>(prefix + "aig::num_consts")),
       num_aig_shared(stats.new_stat<uint64_t>(prefix + "aig::num_shared")),
+      num_aig_mul_ands(stats.new_stat<uint64_t>(prefix + "aig::num_mul_ands")),
+      max_aig_mul_depth(
+          stats.new_stat<uint64_t>(prefix + "aig::max_mul_depth")),
       num_cnf_vars(stats.new_stat<uint64_t>(prefix + "cnf::num_vars")),
       num_cnf_clauses(stats.new_stat<uint64_t>(prefix + "cnf::num_clauses")),
-      num_cnf_literals(stats.new_stat<uint64_t>(prefix + "cnf::num_literals"))
+      num_cnf_literals(stats.new_stat<uint64_t>(prefix + "cnf::num_literals")),
+      num_cnf_retired(stats.new_stat<uint64_t>(prefix + "cnf::num_retired")),
+      num_cubes(stats.new_stat<uint64_t>(prefix + "cube::num_cubes")),
+      num_cubes_pruned(stats.new_stat<uint64_t>(prefix + "cube::num_pruned")),
+      time_cubes(
+          stats.new_stat<util::TimerStatistic>(prefix + "cube::time_solve")),
+      num_sweep_checks(stats.new_stat<uint64_t>(prefix + "sweep::num_checks")),
+      num_sweep_merged(stats.new_stat<uint64_t>(prefix + "sweep::num_merged")),
+      num_sweep_refuted(
+          stats.new_stat<uint64_t>(prefix + "sweep::num_refuted")),
+      num_sweep_unknown(
+          stats.new_stat<uint64_t>(prefix + "sweep::num_unknown")),
+      time_sweep(
+          stats.new_stat<util::TimerStatistic>(prefix + "sweep::time_sweep")),
+      num_sim_rounds(stats.new_stat<uint64_t>(prefix + "sim::num_rounds")),
+      num_sim_sat(stats.new_stat<uint64_t>(prefix + "sim::num_sat")),
+      time_sim(stats.new_stat<util::TimerStatistic>(prefix + "sim::time_sim")),
+      num_propagator_checks(
+          stats.new_stat<uint64_t>(prefix + "propagator::num_checks")),
+      num_propagator_conflicts(
+          stats.new_stat<uint64_t>(prefix + "propagator::num_conflicts")),
+      time_propagator(stats.new_stat<util::TimerStatistic>(
+          prefix + "propagator::time_check"))
 {
 }
 
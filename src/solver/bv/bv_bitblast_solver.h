@@ -12,12 +12,16 @@
 #define BZLA_SOLVER_BV_BV_BITBLAST_SOLVER_H_INCLUDED
 
 #include <unordered_map>
+#include <unordered_set>
 
 #include "backtrack/assertion_stack.h"
+#include "backtrack/backtrackable.h"
 #include "backtrack/vector.h"
 #include "bitblast/aig/aig_cnf.h"
+#include "rng/rng.h"
 #include "sat/sat_solver.h"
 #include "solver/bv/aig_bitblaster.h"
+#include "solver/bv/aig_sweeper.h"
 #include "solver/bv/bv_solver_interface.h"
 #include "solver/solver.h"
 #include "util/statistics.h"
@@ -54,17 +58,94 @@ class BvBitblastSolver : public Solver, public BvSolverInterface
   /** Update AIG and CNF statistics. */
   void update_statistics();
 
+  /**
+   * Solve bit-blasted formula with cube-and-conquer (--bv-cube-threads).
+   *
+   * Splits the formula into cubes over the encoded AIG nodes with the
+   * highest number of parents and solves the cubes under the current
+   * assumptions with a pool of SAT solvers on worker threads. Cubes that
+   * contain a partial assignment refuted by a previous cube are skipped.
+   *
+   * @param assumptions The AIG nodes of the current assumptions.
+   * @return The result of the satisfiability check.
+   */
+  Result solve_cubes(const std::vector<bitblast::AigNode>& assumptions);
+
+  /**
+   * Select splitting variables for cube-and-conquer.
+   * @param assumptions The AIG nodes of the current assumptions.
+   * @return The SAT variables to split on.
+   */
+  std::vector<int32_t> select_cube_vars(
+      const std::vector<bitblast::AigNode>& assumptions) const;
+
+  /**
+   * Try to find a satisfying assignment of the bit-blasted formula via
+   * simulation of random input patterns (--bv-sim-rounds). Patterns are
+   * guided by the assignment of the last satisfiable call.
+   *
+   * @param assumptions The AIG nodes of the current assumptions.
+   * @return True if a satisfying assignment was found, which is then stored
+   *         in `d_sim_model`.
+   */
+  bool simulate(const std::vector<bitblast::AigNode>& assumptions);
+
+  /**
+   * Get the value of a bit of a bit-blasted term.
+   * @return 1 if the bit is true, and -1 if it is false.
+   */
+  int32_t bit_value(const bitblast::AigNode& bit) const;
+
+  /**
+   * Open a new encoding scope in the CNF encoder, guarded by a fresh
+   * activation literal.
+   */
+  void push_scope();
+  /** Close the current encoding scope and retire its clauses. */
+  void pop_scope();
+
+  /**
+   * Check theory consistency of a complete assignment found by the SAT
+   * solver during search (--bv-sat-propagator). Lemmas are encoded
+   * immediately and added to the SAT solver as clauses.
+   * @return False if lemmas were added.
+   */
+  bool check_model();
+  /**
+   * Observe the SAT variables of the leaves bit-blasted since the last call,
+   * the values of the leaves are thus available in check_model().
+   */
+  void observe_leaves();
+
   /** Sat interface used for d_cnf_encoder. */
   class BitblastSatSolver;
+  /** Syncs the CNF encoder scopes with the solver scopes. */
+  class ScopeTracker;
+  /** External propagator of the SAT solver, calls check_model(). */
+  class TheoryPropagator;
 
-  /** The current set of assertions. */
+  /** The current set of top-level assertions. */
   backtrack::vector<Node> d_assertions;
+  /**
+   * The current set of lemmas. Lemmas are encoded as top-level assertions
+   * in the current scope, and thus retired on pop().
+   */
+  backtrack::vector<Node> d_lemmas;
   /** The current set of assumptions. */
   backtrack::vector<Node> d_assumptions;
 
   /** AIG bit-blaster. */
   AigBitblaster d_bitblaster;
 
+  /**
+   * The AIG nodes of the assumptions of the last solve() call, in the order
+   * of `d_assumptions`. May differ from the bits of the assumptions if
+   * sweeping is enabled.
+   */
+  std::vector<bitblast::AigNode> d_assumption_roots;
+  /** SAT sweeper for AIGs (--bv-sweep), null if disabled. */
+  std::unique_ptr<AigSweeper> d_sweeper;
+
   /** CNF encoder for AIGs. */
   std::unique_ptr<bitblast::AigCnfEncoder> d_cnf_encoder;
   /** SAT solver used for solving bit-blasted formula. */
@@ -73,6 +154,49 @@ class BvBitblastSolver : public Solver, public BvSolverInterface
   std::unique_ptr<BitblastSatSolver> d_bitblast_sat_solver;
   /** Result of last solve() call. */
   Result d_last_result;
+  /** The AIG constants used as activation literals of the open scopes. */
+  std::vector<bitblast::AigNode> d_activation;
+  /** Syncs the CNF encoder scopes with the solver scopes. */
+  std::unique_ptr<ScopeTracker> d_scope_tracker;
+  /**
+   * External propagator connected to `d_sat_solver`, null if
+   * --bv-sat-propagator is disabled or not supported.
+   */
+  std::unique_ptr<TheoryPropagator> d_propagator;
+
+  /** Number of cube-and-conquer worker threads, 0 if disabled. */
+  uint64_t d_cube_threads = 0;
+  /**
+   * AIG nodes of all top-level assertions, used to select cube variables and
+   * for simulation.
+   */
+  std::vector<bitblast::AigNode> d_assertion_roots;
+  /**
+   * AIG nodes of all current lemmas, used to select cube variables and for
+   * simulation.
+   */
+  backtrack::vector<bitblast::AigNode> d_lemma_roots;
+  /** SAT solvers of cube-and-conquer worker threads. */
+  std::vector<std::unique_ptr<sat::SatSolver>> d_cube_solvers;
+  /** True if the last solve() call was answered by cube-and-conquer. */
+  bool d_cube_used = false;
+  /** Failed assumptions of last solve() call if answered with cubes. */
+  std::unordered_set<int32_t> d_cube_failed;
+
+  /** Number of simulation rounds before SAT solving, 0 if disabled. */
+  uint64_t d_sim_rounds = 0;
+  /** Random number generator for simulation patterns. */
+  RNG d_rng;
+  /** The (possibly negated) inputs simulated in the last solve() call. */
+  std::vector<bitblast::AigNode> d_sim_inputs;
+  /**
+   * Maps ids of inputs to their value in the last satisfying assignment,
+   * used to guide simulation and for value queries if the last solve() call
+   * was answered by simulation.
+   */
+  std::unordered_map<int64_t, bool> d_sim_model;
+  /** True if the last solve() call was answered by simulation. */
+  bool d_sim_used = false;
 
   struct Statistics
   {
@@ -83,9 +207,26 @@ class BvBitblastSolver : public Solver, public BvSolverInterface
     uint64_t& num_aig_ands;
     uint64_t& num_aig_consts;
     uint64_t& num_aig_shared;
+    uint64_t& num_aig_mul_ands;
+    uint64_t& max_aig_mul_depth;
     uint64_t& num_cnf_vars;
     uint64_t& num_cnf_clauses;
     uint64_t& num_cnf_literals;
+    uint64_t& num_cnf_retired;
+    uint64_t& num_cubes;
+    uint64_t& num_cubes_pruned;
+    util::TimerStatistic& time_cubes;
+    uint64_t& num_sweep_checks;
+    uint64_t& num_sweep_merged;
+    uint64_t& num_sweep_refuted;
+    uint64_t& num_sweep_unknown;
+    util::TimerStatistic& time_sweep;
+    uint64_t& num_sim_rounds;
+    uint64_t& num_sim_sat;
+    util::TimerStatistic& time_sim;
+    uint64_t& num_propagator_checks;
+    uint64_t& num_propagator_conflicts;
+    util::TimerStatistic& time_propagator;
   } d_stats;
 };
 
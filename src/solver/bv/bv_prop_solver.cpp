@@ -10,6 +10,7 @@
 
 #include "solver/bv/bv_prop_solver.h"
 
+#include <atomic>
 #include <iostream>
 
 #include "bv/domain/bitvector_domain.h"
@@ -22,6 +23,7 @@
 #include "solver/result.h"
 #include "solving_context.h"
 #include "util/logger.h"
+#include "worker_terminator.h"
 
 namespace bzla::bv {
 
@@ -32,31 +34,36 @@ BvPropSolver::BvPropSolver(Env& env,
                            BvBitblastSolver& bb_solver)
     : Solver(env, state),
       d_bb_solver(bb_solver),
-      d_ls_backtrack(state.backtrack_mgr(), nullptr),
+      d_ls_backtrack(state.backtrack_mgr(), d_ls),
       d_stats(env.statistics(), "solver::bv::prop::")
 {
   const option::Options& options = d_env.options();
 
-  d_ls.reset(new ls::LocalSearchBV(options.prop_nprops(),
-                                   options.prop_nupdates(),
-                                   options.seed(),
-                                   options.log_level(),
-                                   options.verbosity(),
-                                   "solver::bv::prop::",
-                                   &env.statistics()));
-
-  d_ls->d_options.use_ineq_bounds        = options.prop_ineq_bounds();
-  d_ls->d_options.use_opt_lt_concat_sext = options.prop_opt_lt_concat_sext();
-  d_ls->d_options.prob_pick_inv_value    = options.prop_prob_pick_inv_value();
-  d_ls->d_options.use_path_sel_essential =
-      options.prop_path_sel() == option::PropPathSelection::ESSENTIAL;
-
-  d_ls->d_options.prob_pick_ess_input =
-      1000 - options.prop_prob_pick_random_input();
-
-  d_ls->init();
-
-  d_ls_backtrack.d_ls = d_ls.get();
+  for (uint64_t i = 0, n = options.prop_walkers(); i < n; ++i)
+  {
+    // Only the first walker reports statistics.
+    auto& ls = d_ls.emplace_back(
+        new ls::LocalSearchBV(options.prop_nprops(),
+                              options.prop_nupdates(),
+                              options.seed() + i,
+                              options.log_level(),
+                              options.verbosity(),
+                              "solver::bv::prop::",
+                              i == 0 ? &env.statistics() : nullptr));
+
+    ls->d_options.use_ineq_bounds        = options.prop_ineq_bounds();
+    ls->d_options.use_opt_lt_concat_sext = options.prop_opt_lt_concat_sext();
+    ls->d_options.prob_pick_inv_value    = options.prop_prob_pick_inv_value();
+    // Diversify walkers by alternating the path selection mode.
+    ls->d_options.use_path_sel_essential =
+        (options.prop_path_sel() == option::PropPathSelection::ESSENTIAL)
+        != (i % 2 == 1);
+
+    ls->d_options.prob_pick_ess_input =
+        1000 - options.prop_prob_pick_random_input();
+
+    ls->init();
+  }
 
   d_use_sext       = options.prop_sext();
   d_use_const_bits = options.prop_const_bits();
@@ -82,28 +89,43 @@ BvPropSolver::solve()
 
   if (d_env.options().prop_normalize())
   {
-    d_ls->normalize();
+    for (auto& ls : d_ls)
+    {
+      ls->normalize();
+    }
+  }
+
+  if (d_ls.size() > 1)
+  {
+    sat_result = solve_walkers(nprops, nupdates);
+    print_progress();
+    return sat_result;
   }
 
+  ls::LocalSearchBV& ls = *d_ls[0];
+  d_ls_winner           = 0;
+  // Configures path selection for the current thread.
+  ls.init();
+
   // incremental: increase limit by given nprops/nupdates
   if (nprops)
   {
-    nprops += d_ls->num_props();
+    nprops += ls.num_props();
   }
-  d_ls->set_max_nprops(nprops);
+  ls.set_max_nprops(nprops);
   Log(1) << "set propagation limit to " << nprops;
 
   if (nupdates)
   {
-    nupdates += d_ls->num_updates();
+    nupdates += ls.num_updates();
   }
-  d_ls->set_max_nupdates(nupdates);
+  ls.set_max_nupdates(nupdates);
   Log(1) << "set cone update limit to " << nupdates;
 
   for (uint32_t j = 0;; ++j)
   {
-    if (d_env.terminate() || (nprops && d_ls->num_props() >= nprops)
-        || (nupdates && d_ls->num_updates() >= nupdates))
+    if (d_env.terminate() || (nprops && ls.num_props() >= nprops)
+        || (nupdates && ls.num_updates() >= nupdates))
     {
       assert(sat_result == Result::UNKNOWN);
       goto DONE;
@@ -119,7 +141,7 @@ BvPropSolver::solve()
       }
     }
 
-    bzla::ls::Result res = d_ls->move();
+    bzla::ls::Result res = ls.move();
 
     if (res == bzla::ls::Result::UNSAT)
     {
@@ -189,7 +211,10 @@ BvPropSolver::register_assertion(const Node& assertion,
   } while (!visit.empty());
 
   uint64_t id = d_node_map.at(assertion);
-  d_ls->register_root(id, top_level);
+  for (auto& ls : d_ls)
+  {
+    ls->register_root(id, top_level);
+  }
   // Reverse map assertions for unsat cores.
   d_root_id_node_map[id] = assertion;
 }
@@ -204,7 +229,7 @@ BvPropSolver::value(const Node& term)
   {
     return utils::mk_default_value(nm, term.type());
   }
-  const BitVector& value = d_ls->get_assignment(it->second);
+  const BitVector& value = d_ls[d_ls_winner]->get_assignment(it->second);
   if (term.type().is_bool())
   {
     return nm.mk_value(value.is_true());
@@ -217,7 +242,7 @@ BvPropSolver::unsat_core(std::vector<Node>& core) const
 {
   // The LocalSearchBV library can only determine unsat if a single root is
   // false. Hence, the unsat core always consists of one root.
-  auto it = d_root_id_node_map.find(d_ls->get_false_root());
+  auto it = d_root_id_node_map.find(d_ls[d_ls_winner]->get_false_root());
   assert(it != d_root_id_node_map.end());
   core.push_back(it->second);
 }
@@ -229,7 +254,6 @@ BvPropSolver::mk_node(const Node& node)
 
   assert(node.type().is_bv() || node.type().is_bool());
 
-  uint64_t res  = 0;
   uint64_t size = node.type().is_bool() ? 1 : node.type().bv_size();
 
   BitVectorDomain domain(size);
@@ -272,31 +296,48 @@ BvPropSolver::mk_node(const Node& node)
   std::string symbol =
       node.symbol() ? node.symbol()->get() : "@t" + std::to_string(node.id());
 
+  uint64_t res = mk_node(*d_ls[0], node, domain, symbol);
+  for (size_t i = 1, n = d_ls.size(); i < n; ++i)
+  {
+    [[maybe_unused]] uint64_t id = mk_node(*d_ls[i], node, domain, symbol);
+    assert(id == res);
+  }
+  return res;
+}
+
+uint64_t
+BvPropSolver::mk_node(ls::LocalSearchBV& ls,
+                      const Node& node,
+                      const BitVectorDomain& domain,
+                      const std::string& symbol)
+{
+  uint64_t res = 0;
+
   switch (node.kind())
   {
     case Kind::BV_ADD:
       assert(node.num_children() == 2);
-      res = d_ls->mk_node(bzla::ls::NodeKind::BV_ADD,
-                          domain,
-                          {d_node_map.at(node[0]), d_node_map.at(node[1])},
-                          {},
-                          symbol);
+      res = ls.mk_node(bzla::ls::NodeKind::BV_ADD,
+                       domain,
+                       {d_node_map.at(node[0]), d_node_map.at(node[1])},
+                       {},
+                       symbol);
       break;
     case Kind::BV_AND:
       assert(node.num_children() == 2);
-      res = d_ls->mk_node(bzla::ls::NodeKind::BV_AND,
-                          domain,
-                          {d_node_map.at(node[0]), d_node_map.at(node[1])},
-                          {},
-                          symbol);
+      res = ls.mk_node(bzla::ls::NodeKind::BV_AND,
+                       domain,
+                       {d_node_map.at(node[0]), d_node_map.at(node[1])},
+                       {},
+                       symbol);
       break;
     case Kind::BV_ASHR:
       assert(node.num_children() == 2);
-      res = d_ls->mk_node(bzla::ls::NodeKind::BV_ASHR,
-                          domain,
-                          {d_node_map.at(node[0]), d_node_map.at(node[1])},
-                          {},
-                          symbol);
+      res = ls.mk_node(bzla::ls::NodeKind::BV_ASHR,
+                       domain,
+                       {d_node_map.at(node[0]), d_node_map.at(node[1])},
+                       {},
+                       symbol);
       break;
     case Kind::BV_CONCAT:
       assert(node.num_children() == 2);
@@ -304,165 +345,219 @@ BvPropSolver::mk_node(const Node& node)
         Node child;
         if (d_use_sext && node::utils::is_bv_sext(node, child))
         {
-          res = d_ls->mk_node(bzla::ls::NodeKind::BV_SEXT,
-                              domain,
-                              {d_node_map.at(child)},
-                              {node[0].type().bv_size()},
-                              symbol);
+          res = ls.mk_node(bzla::ls::NodeKind::BV_SEXT,
+                           domain,
+                           {d_node_map.at(child)},
+                           {node[0].type().bv_size()},
+                           symbol);
         }
         else
         {
-          res = d_ls->mk_node(bzla::ls::NodeKind::BV_CONCAT,
-                              domain,
-                              {d_node_map.at(node[0]), d_node_map.at(node[1])},
-                              {},
-                              symbol);
+          res = ls.mk_node(bzla::ls::NodeKind::BV_CONCAT,
+                           domain,
+                           {d_node_map.at(node[0]), d_node_map.at(node[1])},
+                           {},
+                           symbol);
         }
       }
       break;
     case Kind::BV_EXTRACT:
       assert(node.num_children() == 1);
-      res = d_ls->mk_node(bzla::ls::NodeKind::BV_EXTRACT,
-                          domain,
-                          {d_node_map.at(node[0])},
-                          {node.index(0), node.index(1)},
-                          symbol);
+      res = ls.mk_node(bzla::ls::NodeKind::BV_EXTRACT,
+                       domain,
+                       {d_node_map.at(node[0])},
+                       {node.index(0), node.index(1)},
+                       symbol);
       break;
     case Kind::BV_MUL:
       assert(node.num_children() == 2);
-      res = d_ls->mk_node(bzla::ls::NodeKind::BV_MUL,
-                          domain,
-                          {d_node_map.at(node[0]), d_node_map.at(node[1])},
-                          {},
-                          symbol);
+      res = ls.mk_node(bzla::ls::NodeKind::BV_MUL,
+                       domain,
+                       {d_node_map.at(node[0]), d_node_map.at(node[1])},
+                       {},
+                       symbol);
       break;
     case Kind::BV_NOT:
       assert(node.num_children() == 1);
-      res = d_ls->mk_node(bzla::ls::NodeKind::BV_NOT,
-                          domain,
-                          {d_node_map.at(node[0])},
-                          {},
-                          symbol);
+      res = ls.mk_node(bzla::ls::NodeKind::BV_NOT,
+                       domain,
+                       {d_node_map.at(node[0])},
+                       {},
+                       symbol);
       break;
     case Kind::BV_ULT:
       assert(node.num_children() == 2);
-      res = d_ls->mk_node(bzla::ls::NodeKind::BV_ULT,
-                          domain,
-                          {d_node_map.at(node[0]), d_node_map.at(node[1])},
-                          {},
-                          symbol);
+      res = ls.mk_node(bzla::ls::NodeKind::BV_ULT,
+                       domain,
+                       {d_node_map.at(node[0]), d_node_map.at(node[1])},
+                       {},
+                       symbol);
       break;
     case Kind::BV_SHL:
       assert(node.num_children() == 2);
-      res = d_ls->mk_node(bzla::ls::NodeKind::BV_SHL,
-                          domain,
-                          {d_node_map.at(node[0]), d_node_map.at(node[1])},
-                          {},
-                          symbol);
+      res = ls.mk_node(bzla::ls::NodeKind::BV_SHL,
+                       domain,
+                       {d_node_map.at(node[0]), d_node_map.at(node[1])},
+                       {},
+                       symbol);
       break;
     case Kind::BV_SLT:
       assert(node.num_children() == 2);
-      res = d_ls->mk_node(bzla::ls::NodeKind::BV_SLT,
-                          domain,
-                          {d_node_map.at(node[0]), d_node_map.at(node[1])},
-                          {},
-                          symbol);
+      res = ls.mk_node(bzla::ls::NodeKind::BV_SLT,
+                       domain,
+                       {d_node_map.at(node[0]), d_node_map.at(node[1])},
+                       {},
+                       symbol);
       break;
     case Kind::BV_SHR:
       assert(node.num_children() == 2);
-      res = d_ls->mk_node(bzla::ls::NodeKind::BV_SHR,
-                          domain,
-                          {d_node_map.at(node[0]), d_node_map.at(node[1])},
-                          {},
-                          symbol);
+      res = ls.mk_node(bzla::ls::NodeKind::BV_SHR,
+                       domain,
+                       {d_node_map.at(node[0]), d_node_map.at(node[1])},
+                       {},
+                       symbol);
       break;
     case Kind::BV_UDIV:
       assert(node.num_children() == 2);
-      res = d_ls->mk_node(bzla::ls::NodeKind::BV_UDIV,
-                          domain,
-                          {d_node_map.at(node[0]), d_node_map.at(node[1])},
-                          {},
-                          symbol);
+      res = ls.mk_node(bzla::ls::NodeKind::BV_UDIV,
+                       domain,
+                       {d_node_map.at(node[0]), d_node_map.at(node[1])},
+                       {},
+                       symbol);
       break;
     case Kind::BV_UREM:
       assert(node.num_children() == 2);
-      res = d_ls->mk_node(bzla::ls::NodeKind::BV_UREM,
-                          domain,
-                          {d_node_map.at(node[0]), d_node_map.at(node[1])},
-                          {},
-                          symbol);
+      res = ls.mk_node(bzla::ls::NodeKind::BV_UREM,
+                       domain,
+                       {d_node_map.at(node[0]), d_node_map.at(node[1])},
+                       {},
+                       symbol);
       break;
     case Kind::BV_XOR:
       assert(node.num_children() == 2);
-      res = d_ls->mk_node(bzla::ls::NodeKind::BV_XOR,
-                          domain,
-                          {d_node_map.at(node[0]), d_node_map.at(node[1])},
-                          {},
-                          symbol);
+      res = ls.mk_node(bzla::ls::NodeKind::BV_XOR,
+                       domain,
+                       {d_node_map.at(node[0]), d_node_map.at(node[1])},
+                       {},
+                       symbol);
       break;
     case Kind::AND:
       assert(node.num_children() == 2);
-      res = d_ls->mk_node(bzla::ls::NodeKind::AND,
-                          domain,
-                          {d_node_map.at(node[0]), d_node_map.at(node[1])},
-                          {},
-                          symbol);
+      res = ls.mk_node(bzla::ls::NodeKind::AND,
+                       domain,
+                       {d_node_map.at(node[0]), d_node_map.at(node[1])},
+                       {},
+                       symbol);
       break;
     case Kind::BV_COMP:
     case Kind::EQUAL:
       assert(node.num_children() == 2);
       if (BvSolver::is_leaf(node))
       {
-        res = d_ls->mk_node(domain.lo(), domain, symbol);
+        res = ls.mk_node(domain.lo(), domain, symbol);
       }
       else
       {
-        res = d_ls->mk_node(bzla::ls::NodeKind::EQ,
-                            domain,
-                            {d_node_map.at(node[0]), d_node_map.at(node[1])},
-                            {},
-                            symbol);
+        res = ls.mk_node(bzla::ls::NodeKind::EQ,
+                         domain,
+                         {d_node_map.at(node[0]), d_node_map.at(node[1])},
+                         {},
+                         symbol);
       }
       break;
     case Kind::ITE:
       assert(node.num_children() == 3);
-      res = d_ls->mk_node(bzla::ls::NodeKind::ITE,
-                          domain,
-                          {d_node_map.at(node[0]),
-                           d_node_map.at(node[1]),
-                           d_node_map.at(node[2])},
-                          {},
-                          symbol);
+      res = ls.mk_node(bzla::ls::NodeKind::ITE,
+                       domain,
+                       {d_node_map.at(node[0]),
+                        d_node_map.at(node[1]),
+                        d_node_map.at(node[2])},
+                       {},
+                       symbol);
       break;
     case Kind::NOT:
       assert(node.num_children() == 1);
-      res = d_ls->mk_node(bzla::ls::NodeKind::NOT,
-                          domain,
-                          {d_node_map.at(node[0])},
-                          {},
-                          symbol);
+      res = ls.mk_node(bzla::ls::NodeKind::NOT,
+                       domain,
+                       {d_node_map.at(node[0])},
+                       {},
+                       symbol);
       break;
     default:
       assert(BvSolver::is_leaf(node));
-      res = d_ls->mk_node(domain.lo(), domain, symbol);
+      res = ls.mk_node(domain.lo(), domain, symbol);
   }
 
   return res;
 }
 
+Result
+BvPropSolver::solve_walkers(uint64_t nprops, uint64_t nupdates)
+{
+  size_t num_walkers = d_ls.size();
+  std::vector<uint64_t> max_nprops(num_walkers), max_nupdates(num_walkers);
+
+  // incremental: increase limit by given nprops/nupdates
+  for (size_t i = 0; i < num_walkers; ++i)
+  {
+    max_nprops[i]   = nprops ? nprops + d_ls[i]->num_props() : 0;
+    max_nupdates[i] = nupdates ? nupdates + d_ls[i]->num_updates() : 0;
+    d_ls[i]->set_max_nprops(max_nprops[i]);
+    d_ls[i]->set_max_nupdates(max_nupdates[i]);
+  }
+  Log(1) << "run " << num_walkers << " local search walkers";
+
+  std::atomic<size_t> winner = num_walkers;
+  std::vector<bzla::ls::Result> results(num_walkers, bzla::ls::Result::UNKNOWN);
+  // Terminates all walkers once one of them determined the result, or if the
+  // terminator of the solving context terminates.
+  WorkerTerminator terminator(d_env.terminator());
+
+  terminator.run(num_walkers, [&](size_t i) {
+    ls::LocalSearchBV& ls = *d_ls[i];
+    // Configures path selection for the current thread.
+    ls.init();
+    while (!terminator.terminate()
+           && (!max_nprops[i] || ls.num_props() < max_nprops[i])
+           && (!max_nupdates[i] || ls.num_updates() < max_nupdates[i]))
+    {
+      bzla::ls::Result res = ls.move();
+      if (res != bzla::ls::Result::UNKNOWN)
+      {
+        size_t expected = num_walkers;
+        if (winner.compare_exchange_strong(expected, i))
+        {
+          results[i] = res;
+        }
+        terminator.set_terminate();
+      }
+    }
+  });
+
+  size_t w = winner.load();
+  if (w == num_walkers)
+  {
+    return Result::UNKNOWN;
+  }
+  Log(1) << "local search walker " << w << " determined result";
+  d_ls_winner = w;
+  return results[w] == bzla::ls::Result::SAT ? Result::SAT : Result::UNSAT;
+}
+
 void
 BvPropSolver::print_progress() const
 {
   if (d_logger.is_msg_enabled(2))
   {
-    size_t nroots_sat   = d_ls->get_num_roots_sat();
-    size_t nroots_total = d_ls->get_num_roots();
+    const ls::LocalSearchBV& ls = *d_ls[d_ls_winner];
+    size_t nroots_sat           = ls.get_num_roots_sat();
+    size_t nroots_total         = ls.get_num_roots();
     double perc_sat     = static_cast<double>(nroots_sat) / nroots_total * 100;
     Msg(1) << nroots_sat << "/" << nroots_total << " roots satisfied ("
            << std::setprecision(3) << perc_sat
-           << "%), moves: " << d_ls->num_moves()
-           << ", propagation steps: " << d_ls->num_props()
-           << ", updates: " << d_ls->num_updates();
+           << "%), moves: " << ls.num_moves()
+           << ", propagation steps: " << ls.num_props()
+           << ", updates: " << ls.num_updates();
   }
 }
 
@@ -43,26 +43,65 @@ class BvPropSolver : public Solver, public BvSolverInterface
   void unsat_core(std::vector<Node>& core) const override;
 
  private:
-  /** Backtrack manager to sync push/pop with local search engine. */
+  using LocalSearchWalkers = std::vector<std::unique_ptr<ls::LocalSearchBV>>;
+
+  /** Backtrack manager to sync push/pop with local search engines. */
   class LsBacktrack : public backtrack::Backtrackable
   {
    public:
-    LsBacktrack(backtrack::BacktrackManager* mgr, bzla::ls::LocalSearchBV* ls)
+    LsBacktrack(backtrack::BacktrackManager* mgr, LocalSearchWalkers& ls)
         : Backtrackable(mgr), d_ls(ls)
     {
     }
-    void push() override { d_ls->push(); }
-    void pop() override { d_ls->pop(); }
-    bzla::ls::LocalSearchBV* d_ls = nullptr;
+    void push() override
+    {
+      for (auto& ls : d_ls)
+      {
+        ls->push();
+      }
+    }
+    void pop() override
+    {
+      for (auto& ls : d_ls)
+      {
+        ls->pop();
+      }
+    }
+    LocalSearchWalkers& d_ls;
   };
 
   /**
    * Helper to create LocalSearchBV bit-vector node representation of given
-   * node. Maps `node` to resulting LS bit-vector node id in `d_node_map`.
+   * node in all local search engines. Maps `node` to resulting LS bit-vector
+   * node id in `d_node_map`.
    * @param node The node to create a LS bit-vector node representation for.
    * @return The id of the created LS bit-vector node.
    */
   uint64_t mk_node(const Node& node);
+  /**
+   * Helper to create LocalSearchBV bit-vector node representation of given
+   * node in given local search engine.
+   * @param ls     The local search engine.
+   * @param node   The node to create a LS bit-vector node representation for.
+   * @param domain The domain of the LS bit-vector node.
+   * @param symbol The symbol of the LS bit-vector node.
+   * @return The id of the created LS bit-vector node.
+   */
+  uint64_t mk_node(ls::LocalSearchBV& ls,
+                   const Node& node,
+                   const BitVectorDomain& domain,
+                   const std::string& symbol);
+
+  /**
+   * Run all local search walkers in parallel until one of them determines
+   * the result, or all of them hit the configured limits.
+   * @param nprops   The number of additional propagations per walker, zero
+   *                 if unlimited.
+   * @param nupdates The number of additional cone updates per walker, zero
+   *                 if unlimited.
+   * @return The result of the walker that determined the result.
+   */
+  Result solve_walkers(uint64_t nprops, uint64_t nupdates);
 
   /**
    * Print current progress of LocalSearchBV.
@@ -75,8 +114,15 @@ class BvPropSolver : public Solver, public BvSolverInterface
    * to avoid redundant bit-blasting work.
    */
   BvBitblastSolver& d_bb_solver;
-  /** The local search engine. */
-  std::unique_ptr<bzla::ls::LocalSearchBV> d_ls;
+  /**
+   * The local search engines, one per walker (see --prop-walkers). All
+   * walkers maintain the same set of nodes and roots, each in its own copy of
+   * the node graph since nodes store their assignment inline. Walkers do not
+   * share partial assignments.
+   */
+  LocalSearchWalkers d_ls;
+  /** The index of the walker that determined the last result. */
+  size_t d_ls_winner = 0;
   /** The backtrack manager for the local search engine. */
   LsBacktrack d_ls_backtrack;
   /** Map Bitwuzla node to LocalSearchBV bit-vector node id. */
@@ -0,0 +1,211 @@
+/***
+ * Bitwuzla: Satisfiability Modulo Theories (SMT) solver.
+ *
+ * Copyright (C) 2023 by the authors listed in the AUTHORS file at
+ * https://github.com/bitwuzla/bitwuzla/blob/main/AUTHORS
+ *
+ * This file is part of Bitwuzla under the MIT license. See COPYING for more
+ * information at https://github.com/bitwuzla/bitwuzla/blob/main/COPYING
+ */
+
+#include "solver/model_tape.h"
+
+#include <limits>
+
+#include "node/node_manager.h"
+#include "node/node_ref_vector.h"
+#include "rewrite/evaluator.h"
+
+namespace bzla {
+
+ModelTape::ModelTape(NodeManager& nm) : d_nm(nm) {}
+
+void
+ModelTape::reset()
+{
+  if (size() > s_max_size)
+  {
+    clear();
+  }
+  ++d_epoch;
+}
+
+void
+ModelTape::clear()
+{
+  d_slots.clear();
+  d_nodes.clear();
+  d_args_begin.resize(1);
+  d_args.clear();
+  d_sizes.clear();
+  d_epochs.clear();
+  d_native.clear();
+  d_bv.clear();
+}
+
+Node
+ModelTape::value(const Node& term, const LeafValue& leaf_value)
+{
+  const Type& type = term.type();
+  if (!type.is_bool() && !type.is_bv())
+  {
+    return leaf_value(term);
+  }
+
+  size_t slot = compile(term);
+  evaluate(slot, leaf_value);
+
+  if (type.is_bool())
+  {
+    return d_nm.mk_value(d_native[slot] != 0);
+  }
+  uint64_t size = d_sizes[slot];
+  if (size <= 64)
+  {
+    return d_nm.mk_value(BitVector::from_ui(size, d_native[slot]));
+  }
+  return d_nm.mk_value(d_bv[slot]);
+}
+
+size_t
+ModelTape::compile(const Node& term)
+{
+  constexpr size_t none = std::numeric_limits<size_t>::max();
+
+  node::node_ref_vector visit{term};
+  do
+  {
+    const Node& cur     = visit.back();
+    auto [it, inserted] = d_slots.emplace(cur, none);
+    if (inserted && Evaluator::is_bool_bv_op(cur))
+    {
+      visit.insert(visit.end(), cur.begin(), cur.end());
+      continue;
+    }
+    if (it->second == none)
+    {
+      it->second = d_nodes.size();
+      if (Evaluator::is_bool_bv_op(cur))
+      {
+        for (const Node& child : cur)
+        {
+          d_args.push_back(d_slots.at(child));
+        }
+      }
+      d_args_begin.push_back(d_args.size());
+      d_nodes.push_back(cur);
+      d_sizes.push_back(cur.type().is_bool() ? 1 : cur.type().bv_size());
+      d_epochs.push_back(0);
+      d_native.push_back(0);
+      d_bv.emplace_back();
+    }
+    visit.pop_back();
+  } while (!visit.empty());
+
+  return d_slots.at(term);
+}
+
+void
+ModelTape::evaluate(size_t slot, const LeafValue& leaf_value)
+{
+  // The leaf callback may query values of other terms and thus re-enter the
+  // tape, hence the visit stack is local and slots are accessed by index.
+  std::vector<size_t> visit{slot};
+  do
+  {
+    size_t i = visit.back();
+    if (d_epochs[i] == d_epoch)
+    {
+      visit.pop_back();
+      continue;
+    }
+
+    size_t begin = d_args_begin[i];
+    size_t end   = d_args_begin[i + 1];
+    if (begin == end)
+    {
+      Node node = d_nodes[i];
+      set(i, node.is_value() ? node : leaf_value(node));
+    }
+    else
+    {
+      // Evaluate operands first.
+      bool ready = true;
+      for (size_t j = begin; j < end; ++j)
+      {
+        if (d_epochs[d_args[j]] != d_epoch)
+        {
+          visit.push_back(d_args[j]);
+          ready = false;
+        }
+      }
+      if (!ready)
+      {
+        continue;
+      }
+
+      const Node& node = d_nodes[i];
+      bool native      = d_sizes[i] <= 64;
+      d_arg_sizes.clear();
+      for (size_t j = begin; j < end; ++j)
+      {
+        d_arg_sizes.push_back(d_sizes[d_args[j]]);
+        native = native && d_arg_sizes.back() <= 64;
+      }
+      if (native)
+      {
+        d_native_args.clear();
+        for (size_t j = begin; j < end; ++j)
+        {
+          d_native_args.push_back(d_native[d_args[j]]);
+        }
+        d_native[i] = Evaluator::evaluate_native(
+            node.kind(), d_native_args, d_arg_sizes, node.indices());
+      }
+      else
+      {
+        d_bv_args.clear();
+        for (size_t j = begin; j < end; ++j)
+        {
+          size_t arg = d_args[j];
+          d_bv_args.push_back(d_sizes[arg] <= 64
+                                  ? BitVector::from_ui(d_sizes[arg],
+                                                       d_native[arg])
+                                  : d_bv[arg]);
+        }
+        BitVector bv =
+            Evaluator::evaluate_bv(node.kind(), d_bv_args, node.indices());
+        if (d_sizes[i] <= 64)
+        {
+          d_native[i] = bv.to_uint64();
+        }
+        else
+        {
+          d_bv[i] = std::move(bv);
+        }
+      }
+    }
+    d_epochs[i] = d_epoch;
+    visit.pop_back();
+  } while (!visit.empty());
+}
+
+void
+ModelTape::set(size_t slot, const Node& value)
+{
+  assert(value.is_value());
+  if (value.type().is_bool())
+  {
+    d_native[slot] = value.value<bool>();
+  }
+  else if (d_sizes[slot] <= 64)
+  {
+    d_native[slot] = value.value<BitVector>().to_uint64();
+  }
+  else
+  {
+    d_bv[slot] = value.value<BitVector>();
+  }
+}
+
+}  // namespace bzla
@@ -0,0 +1,118 @@
+/***
+ * Bitwuzla: Satisfiability Modulo Theories (SMT) solver.
+ *
+ * Copyright (C) 2023 by the authors listed in the AUTHORS file at
+ * https://github.com/bitwuzla/bitwuzla/blob/main/AUTHORS
+ *
+ * This file is part of Bitwuzla under the MIT license. See COPYING for more
+ * information at https://github.com/bitwuzla/bitwuzla/blob/main/COPYING
+ */
+
+#ifndef BZLA_SOLVER_MODEL_TAPE_H_INCLUDED
+#define BZLA_SOLVER_MODEL_TAPE_H_INCLUDED
+
+#include <functional>
+#include <unordered_map>
+#include <vector>
+
+#include "bv/bitvector.h"
+#include "node/node.h"
+
+namespace bzla {
+
+class NodeManager;
+
+/**
+ * Compiled model evaluator for Boolean and bit-vector terms.
+ *
+ * The Boolean and bit-vector operators in the cones of queried terms are
+ * compiled into a flat tape of slots in topological order, where each slot
+ * refers to the slots of its operands by index. Values are stored unboxed
+ * per slot, as machine word if the size is <= 64 and as BitVector otherwise.
+ * All other terms (constants, function applications, floating-point terms,
+ * ...) are leaves of the tape, their values are queried via a callback.
+ *
+ * The tape is kept across models, reset() only invalidates the values of
+ * the slots. Nodes are only created for the values of the queried terms.
+ */
+class ModelTape
+{
+ public:
+  /** Callback to query the model value of a leaf. */
+  using LeafValue = std::function<Node(const Node&)>;
+
+  /**
+   * Constructor.
+   * @param nm The associated node manager.
+   */
+  ModelTape(NodeManager& nm);
+
+  /**
+   * Invalidate the values of all slots, called when the model changes.
+   * Clears the tape if it exceeds the maximum number of slots.
+   */
+  void reset();
+
+  /** Clear the tape. */
+  void clear();
+
+  /**
+   * Get the model value of given term. Compiles the cone of `term` if it was
+   * not compiled yet, and evaluates all slots in the cone that were not
+   * evaluated since the last reset().
+   * @param term       The term.
+   * @param leaf_value The callback to query the values of the leaves.
+   * @return The value of `term`.
+   */
+  Node value(const Node& term, const LeafValue& leaf_value);
+
+  /** @return The number of slots. */
+  size_t size() const { return d_nodes.size(); }
+
+ private:
+  /** The maximum number of slots kept by reset(). */
+  static constexpr size_t s_max_size = 1 << 20;
+
+  /**
+   * Compile the cone of given term.
+   * @return The slot of `term`.
+   */
+  size_t compile(const Node& term);
+  /** Evaluate the slots in the cone of given slot. */
+  void evaluate(size_t slot, const LeafValue& leaf_value);
+  /** Set the value of given slot from a value node. */
+  void set(size_t slot, const Node& value);
+
+  /** The associated node manager. */
+  NodeManager& d_nm;
+  /** Maps compiled terms to their slots. */
+  std::unordered_map<Node, size_t> d_slots;
+  /** The term of each slot. */
+  std::vector<Node> d_nodes;
+  /**
+   * The operand slots of slot i are stored in `d_args` from
+   * `d_args_begin[i]` to `d_args_begin[i + 1]`, leaves have no operands.
+   */
+  std::vector<size_t> d_args_begin{0};
+  /** The operand slots. */
+  std::vector<size_t> d_args;
+  /** The size of each slot, Booleans are of size one. */
+  std::vector<uint64_t> d_sizes;
+  /** The epoch of the last evaluation of each slot. */
+  std::vector<uint64_t> d_epochs;
+  /** The values of slots of size <= 64. */
+  std::vector<uint64_t> d_native;
+  /** The values of slots of size > 64. */
+  std::vector<BitVector> d_bv;
+  /** The current epoch, incremented on reset(). */
+  uint64_t d_epoch = 1;
+
+  /** Scratch vectors for evaluate(). */
+  std::vector<uint64_t> d_native_args;
+  std::vector<uint64_t> d_arg_sizes;
+  std::vector<BitVector> d_bv_args;
+};
+
+}  // namespace bzla
+
+#endif
@@ -10,11 +10,14 @@
 
 #include "solver/quant/quant_solver.h"
 
+#include <thread>
+
 #include "node/node.h"
 #include "node/node_manager.h"
 #include "node/node_ref_vector.h"
 #include "node/node_utils.h"
 #include "node/unordered_node_ref_map.h"
+#include "node/unordered_node_ref_set.h"
 #include "solving_context.h"
 #include "util/logger.h"
 
@@ -340,39 +343,193 @@ QuantSolver::mbqi_check(const std::vector<Node>& to_check)
 {
   util::Timer timer(d_stats.time_mbqi);
 
-  // Initialize MBQI solver
   NodeManager& nm = d_env.nm();
   option::Options options;
   options.abstraction.set(d_env.options().abstraction());
-  d_mbqi_solver.reset(new SolvingContext(d_env.nm(), options, "mbqi", true));
+  // Nested MBQI solvers only live for one check of this solver.
+  options.quant_mbqi_persistent.set(false);
+
+  bool use_persistent = d_env.options().quant_mbqi_persistent();
+  size_t num_solvers =
+      std::max<uint64_t>(d_env.options().quant_mbqi_threads(), 1);
+
+  std::vector<MbqiCheck> checks(to_check.size());
+  // The indices of the checks of each persistent MBQI solver.
+  std::vector<std::vector<size_t>> solver_checks(num_solvers);
+  // The guarded counterexample bodies to assert to each persistent MBQI
+  // solver before checking.
+  std::vector<std::vector<Node>> solver_bodies(num_solvers);
+  std::vector<size_t> other;
+  for (size_t i = 0, size = to_check.size(); i < size; ++i)
+  {
+    const Node& q = to_check[i];
+    MbqiCheck& check = checks[i];
+    Node cur         = q;
+    while (cur.kind() == Kind::FORALL)
+    {
+      check.d_inst_consts.push_back(inst_const(cur));
+      cur = cur[1];
+    }
+
+    if (use_persistent && is_mbqi_persistent(q))
+    {
+      // Quantifiers are assigned to persistent MBQI solvers in round-robin
+      // order and stay with their solver across checks.
+      auto [it, inserted] =
+          d_mbqi_solver_index.emplace(q, d_mbqi_solver_index.size());
+      size_t index = it->second % num_solvers;
+      if (index >= d_mbqi_solvers.size())
+      {
+        d_mbqi_solvers.resize(index + 1);
+      }
+      MbqiSolver& mbqi = d_mbqi_solvers[index];
+      if (!mbqi.d_solver)
+      {
+        mbqi.d_solver.reset(new SolvingContext(
+            nm, options, "mbqi" + std::to_string(index), true));
+      }
+      // Counterexample bodies are asserted only once, guarded by the
+      // counterexample literal of their quantifier. They are enabled per
+      // check via their guard and stay preprocessed and bit-blasted across
+      // checks.
+      if (mbqi.d_ce_asserted.insert(q).second)
+      {
+        solver_bodies[index].push_back(
+            nm.mk_node(Kind::IMPLIES, {ce_const(q), mbqi_inst(q)}));
+      }
+      check.d_assumption = ce_const(q);
+      solver_checks[index].push_back(i);
+    }
+    else
+    {
+      check.d_assumption = mbqi_inst(q);
+      other.push_back(i);
+    }
+  }
 
-  // Assert formula
+  // Model values of constants, assumed by the persistent MBQI solvers.
+  // Function constants do not occur in persistent counterexample bodies.
+  std::vector<Node> values;
   for (const Node& c : d_consts)
   {
-    Node value = d_solver_state.value(c);
-    d_mbqi_solver->assert_formula(nm.mk_node(Kind::EQUAL, {c, value}));
+    if (!c.type().is_fun())
+    {
+      Node value = d_solver_state.value(c);
+      values.push_back(nm.mk_node(Kind::EQUAL, {c, value}));
+    }
   }
 
+  auto check_persistent = [&](size_t index) {
+    SolvingContext& solver = *d_mbqi_solvers[index].d_solver;
+    for (const Node& body : solver_bodies[index])
+    {
+      solver.assert_formula(body);
+    }
+    solver.push();
+    for (const Node& value : values)
+    {
+      solver.assert_formula(value);
+    }
+    for (size_t i : solver_checks[index])
+    {
+      mbqi_solve(solver, checks[i]);
+    }
+    solver.pop();
+  };
+
+  std::vector<size_t> active;
+  for (size_t i = 0; i < num_solvers; ++i)
+  {
+    if (!solver_checks[i].empty())
+    {
+      active.push_back(i);
+    }
+  }
+  if (active.size() == 1)
+  {
+    check_persistent(active[0]);
+  }
+  else if (active.size() > 1)
+  {
+    // Concurrent mode is only enabled for the duration of the parallel
+    // checks, unless it was already enabled, e.g., by portfolio solving.
+    bool concurrent = nm.is_concurrent();
+    if (!concurrent)
+    {
+      nm.enable_concurrency();
+    }
+    Log(1) << "mbqi: check " << to_check.size() - other.size()
+           << " quantifiers with " << active.size() << " threads";
+    std::vector<std::exception_ptr> errors(active.size());
+    std::vector<std::thread> threads;
+    for (size_t i = 0, size = active.size(); i < size; ++i)
+    {
+      threads.emplace_back([&, i]() {
+        NodeManager::EpochGuard guard(nm);
+        try
+        {
+          check_persistent(active[i]);
+        }
+        catch (...)
+        {
+          errors[i] = std::current_exception();
+        }
+      });
+    }
+    for (auto& t : threads)
+    {
+      t.join();
+    }
+    if (!concurrent)
+    {
+      nm.disable_concurrency();
+    }
+    for (auto& e : errors)
+    {
+      if (e)
+      {
+        std::rethrow_exception(e);
+      }
+    }
+  }
+
+  if (!other.empty())
+  {
+    // Counterexample bodies with nested quantifiers or function constants
+    // are checked with a new solver, where the model values of function
+    // constants can be eliminated by preprocessing.
+    SolvingContext mbqi_solver(nm, options, "mbqi", true);
+    for (const Node& c : d_consts)
+    {
+      Node value = d_solver_state.value(c);
+      mbqi_solver.assert_formula(nm.mk_node(Kind::EQUAL, {c, value}));
+    }
+    for (size_t i : other)
+    {
+      mbqi_solve(mbqi_solver, checks[i]);
+    }
+  }
+
+  // Add the instantiation lemmas of all checks in one batch.
   size_t num_inactive = 0;
-  for (const Node& q : to_check)
+  for (size_t i = 0, size = to_check.size(); i < size; ++i)
   {
+    const Node& q          = to_check[i];
+    const MbqiCheck& check = checks[i];
     ++d_stats.mbqi_checks;
-    d_mbqi_solver->push();
-    d_mbqi_solver->assert_formula(mbqi_inst(q));
     Log(2) << "mbqi check: " << mbqi_inst(q);
-    auto res = d_mbqi_solver->solve();
-    Log(2) << res;
+    Log(2) << check.d_result;
     // Counterexample
-    if (res == Result::SAT)
+    if (check.d_result == Result::SAT)
     {
-      lemma(mbqi_lemma(q), LemmaKind::MBQI_INST);
+      lemma(mbqi_lemma(q, check.d_values), LemmaKind::MBQI_INST);
     }
-    else if (res == Result::UNSAT)
+    else if (check.d_result == Result::UNSAT)
     {
       ++num_inactive;
     }
-    d_mbqi_solver->pop();
   }
+
   bool done = num_inactive == to_check.size();
   if (done)
   {
@@ -381,6 +538,51 @@ QuantSolver::mbqi_check(const std::vector<Node>& to_check)
   return done;
 }
 
+void
+QuantSolver::mbqi_solve(SolvingContext& mbqi_solver, MbqiCheck& check)
+{
+  mbqi_solver.push();
+  mbqi_solver.assert_formula(check.d_assumption);
+  check.d_result = mbqi_solver.solve();
+  if (check.d_result == Result::SAT)
+  {
+    check.d_values = mbqi_solver.get_values(check.d_inst_consts);
+  }
+  mbqi_solver.pop();
+}
+
+bool
+QuantSolver::is_mbqi_persistent(const Node& q)
+{
+  auto it = d_mbqi_persistent.find(q);
+  if (it != d_mbqi_persistent.end())
+  {
+    return it->second;
+  }
+
+  bool res = true;
+  unordered_node_ref_set cache;
+  node::node_ref_vector visit{mbqi_inst(q)};
+  do
+  {
+    const Node& cur = visit.back();
+    visit.pop_back();
+    if (cache.insert(cur).second)
+    {
+      if (cur.kind() == Kind::FORALL
+          || (cur.kind() == Kind::CONSTANT && cur.type().is_fun()))
+      {
+        res = false;
+        break;
+      }
+      visit.insert(visit.end(), cur.begin(), cur.end());
+    }
+  } while (!visit.empty());
+
+  d_mbqi_persistent.emplace(q, res);
+  return res;
+}
+
 const Node&
 QuantSolver::mbqi_inst(const Node& q)
 {
@@ -409,16 +611,18 @@ QuantSolver::mbqi_inst(const Node& q)
 }
 
 Node
-QuantSolver::mbqi_lemma(const Node& q)
+QuantSolver::mbqi_lemma(const Node& q, const std::vector<Node>& values)
 {
   assert(q.kind() == Kind::FORALL);
 
   std::unordered_map<Node, Node> map;
   Node cur = q;
-  while (cur.kind() == Kind::FORALL)
+  for (size_t i = 0; cur.kind() == Kind::FORALL; ++i)
   {
     const Node& ic = inst_const(cur);
-    Node value     = d_mbqi_solver->get_value(ic);
+    assert(!ic.is_null());
+    assert(i < values.size());
+    Node value = values[i];
     assert(!value.is_null());
     for (const Node& t : d_ground_terms)
     {
@@ -433,7 +637,6 @@ QuantSolver::mbqi_lemma(const Node& q)
       }
     }
     map.emplace(cur[0], value);
-    assert(!ic.is_null());
     cur = cur[1];
   }
 
@@ -69,9 +69,53 @@ class QuantSolver : public Solver
 
   void process(const Node& q);
 
+  /** A counterexample check of a quantifier with an MBQI solver. */
+  struct MbqiCheck
+  {
+    /**
+     * The formula assumed for the check, either the counterexample body or,
+     * in persistent MBQI solvers, the counterexample literal.
+     */
+    Node d_assumption;
+    /** The instantiation constants of the quantifier. */
+    std::vector<Node> d_inst_consts;
+    /** The result of the check. */
+    Result d_result = Result::UNKNOWN;
+    /** The values of the instantiation constants if the result is SAT. */
+    std::vector<Node> d_values;
+  };
+
+  /** A persistent MBQI solver. */
+  struct MbqiSolver
+  {
+    /** The solver. */
+    std::unique_ptr<SolvingContext> d_solver;
+    /**
+     * The quantifiers whose guarded counterexample body was asserted. Not
+     * backtrackable since bodies are asserted at the top level of the
+     * solver.
+     */
+    std::unordered_set<Node> d_ce_asserted;
+  };
+
   bool mbqi_check(const std::vector<Node>& to_check);
+  /**
+   * Check for a counterexample with given MBQI solver. Does not access the
+   * state of the quantifier solver and can be called concurrently for
+   * different MBQI solvers.
+   * @param mbqi_solver The MBQI solver.
+   * @param check       The check, its result and the counterexample values
+   *                    are set by this function.
+   */
+  static void mbqi_solve(SolvingContext& mbqi_solver, MbqiCheck& check);
+  /**
+   * @return True if the counterexample body of given quantifier can be kept
+   *         in a persistent MBQI solver, i.e., it does not contain nested
+   *         quantifiers or function constants.
+   */
+  bool is_mbqi_persistent(const Node& q);
   const Node& mbqi_inst(const Node& q);
-  Node mbqi_lemma(const Node& q);
+  Node mbqi_lemma(const Node& q, const std::vector<Node>& values);
 
   backtrack::vector<Node> d_quantifiers;
   backtrack::vector<Node> d_assertions;
@@ -85,8 +129,13 @@ class QuantSolver : public Solver
 
   backtrack::unordered_map<Node, Node> d_skolemization_lemmas;
 
-  std::unique_ptr<SolvingContext> d_mbqi_solver;
+  /** The persistent MBQI solvers, one per thread. */
+  std::vector<MbqiSolver> d_mbqi_solvers;
+  /** Maps quantifiers to the persistent MBQI solver that checks them. */
+  std::unordered_map<Node, size_t> d_mbqi_solver_index;
   std::unordered_map<Node, Node> d_mbqi_inst;
+  /** Cache for is_mbqi_persistent(). */
+  std::unordered_map<Node, bool> d_mbqi_persistent;
   backtrack::unordered_set<Node> d_lemma_cache;
 
   bool d_added_lemma;
@@ -24,7 +24,8 @@ using namespace node;
 /* --- SolverEngine public -------------------------------------------------- */
 
 SolverEngine::SolverEngine(SolvingContext& context)
-    : d_context(context),
+    : d_model_tape(context.env().nm()),
+      d_context(context),
       d_pop_callback(context.backtrack_mgr(), &d_backtrack_mgr),
       d_assertions(context.assertions()),
       d_register_assertion_cache(&d_backtrack_mgr),
@@ -65,6 +66,9 @@ SolverEngine::solve()
   // Process unprocessed assertions.
   process_assertions();
 
+  // Invalidate values of compiled model evaluator
+  d_model_tape.reset();
+
   d_in_solving_mode = true;
   do
   {
@@ -152,9 +156,13 @@ SolverEngine::value(const Node& term)
   if (d_in_solving_mode)
   {
     process_term(term, true);
+    return _value(term);
   }
 
-  return _value(term);
+  // After solving, Boolean and bit-vector operators are evaluated via the
+  // compiled model evaluator and only leaves are computed via _value().
+  return d_model_tape.value(term,
+                            [this](const Node& leaf) { return _value(leaf); });
 }
 
 void
@@ -196,6 +204,44 @@ SolverEngine::lemma(const Node& lemma)
   return false;
 }
 
+bool
+SolverEngine::check_theories()
+{
+  assert(d_in_solving_mode);
+  assert(d_lemmas.empty());
+  Log(1) << "*** check theories during search";
+
+  // Values of previous assignments are invalid.
+  d_value_cache.clear();
+
+  if (d_opt_relevant_terms)
+  {
+    find_relevant();
+  }
+
+  if (d_am != nullptr)
+  {
+    d_am->check();
+    d_stats.num_lemmas_abstr += d_lemmas.size();
+  }
+  if (d_lemmas.empty())
+  {
+    d_array_solver.check();
+    d_stats.num_lemmas_array += d_lemmas.size();
+  }
+  if (d_lemmas.empty())
+  {
+    d_fun_solver.check();
+    d_stats.num_lemmas_fun += d_lemmas.size();
+  }
+  if (d_lemmas.empty())
+  {
+    return true;
+  }
+  process_lemmas();
+  return false;
+}
+
 void
 SolverEngine::ensure_model(const std::vector<Node>& terms)
 {
@@ -545,108 +591,35 @@ SolverEngine::_value(const Node& term)
                                                      : cached_value(cur[2]);
           break;
 
-        // Boolean kinds
+        // Boolean and bit-vector kinds
         case Kind::NOT:
-          value = nm.mk_value(!cached_value(cur[0]).value<bool>());
-          break;
-
         case Kind::AND:
-          value = nm.mk_value(cached_value(cur[0]).value<bool>()
-                              && cached_value(cur[1]).value<bool>());
-          break;
-
         case Kind::OR:
-          value = nm.mk_value(cached_value(cur[0]).value<bool>()
-                              || cached_value(cur[1]).value<bool>());
-          break;
-
-        // Bit-vector kinds
         case Kind::BV_NOT:
-          value = nm.mk_value(cached_value(cur[0]).value<BitVector>().bvnot());
-          break;
-
         case Kind::BV_DEC:
-          value = nm.mk_value(cached_value(cur[0]).value<BitVector>().bvdec());
-          break;
-
         case Kind::BV_INC:
-          value = nm.mk_value(cached_value(cur[0]).value<BitVector>().bvinc());
-          break;
-
         case Kind::BV_AND:
-          value = nm.mk_value(cached_value(cur[0]).value<BitVector>().bvand(
-              cached_value(cur[1]).value<BitVector>()));
-          break;
-
         case Kind::BV_XOR:
-          value = nm.mk_value(cached_value(cur[0]).value<BitVector>().bvxor(
-              cached_value(cur[1]).value<BitVector>()));
-          break;
-
         case Kind::BV_EXTRACT:
-          value = nm.mk_value(cached_value(cur[0]).value<BitVector>().bvextract(
-              cur.index(0), cur.index(1)));
-          break;
-
-        case Kind::BV_COMP: {
-          bool equal = cached_value(cur[0]).value<BitVector>()
-                       == cached_value(cur[1]).value<BitVector>();
-          value = nm.mk_value(BitVector::from_ui(1, equal ? 1 : 0));
-        }
-        break;
-
+        case Kind::BV_COMP:
         case Kind::BV_ADD:
-          value = nm.mk_value(cached_value(cur[0]).value<BitVector>().bvadd(
-              cached_value(cur[1]).value<BitVector>()));
-          break;
-
         case Kind::BV_MUL:
-          value = nm.mk_value(cached_value(cur[0]).value<BitVector>().bvmul(
-              cached_value(cur[1]).value<BitVector>()));
-          break;
-
         case Kind::BV_ULT:
-          value = nm.mk_value(cached_value(cur[0]).value<BitVector>().compare(
-                                  cached_value(cur[1]).value<BitVector>())
-                              < 0);
-          break;
-
         case Kind::BV_SHL:
-          value = nm.mk_value(cached_value(cur[0]).value<BitVector>().bvshl(
-              cached_value(cur[1]).value<BitVector>()));
-          break;
-
         case Kind::BV_SLT:
-          value = nm.mk_value(
-              cached_value(cur[0]).value<BitVector>().signed_compare(
-                  cached_value(cur[1]).value<BitVector>())
-              < 0);
-          break;
-
         case Kind::BV_SHR:
-          value = nm.mk_value(cached_value(cur[0]).value<BitVector>().bvshr(
-              cached_value(cur[1]).value<BitVector>()));
-          break;
-
         case Kind::BV_ASHR:
-          value = nm.mk_value(cached_value(cur[0]).value<BitVector>().bvashr(
-              cached_value(cur[1]).value<BitVector>()));
-          break;
-
         case Kind::BV_UDIV:
-          value = nm.mk_value(cached_value(cur[0]).value<BitVector>().bvudiv(
-              cached_value(cur[1]).value<BitVector>()));
-          break;
-
         case Kind::BV_UREM:
-          value = nm.mk_value(cached_value(cur[0]).value<BitVector>().bvurem(
-              cached_value(cur[1]).value<BitVector>()));
-          break;
-
-        case Kind::BV_CONCAT:
-          value = nm.mk_value(cached_value(cur[0]).value<BitVector>().bvconcat(
-              cached_value(cur[1]).value<BitVector>()));
-          break;
+        case Kind::BV_CONCAT: {
+          std::vector<Node> values;
+          for (const Node& arg : cur)
+          {
+            values.push_back(cached_value(arg));
+          }
+          value = Evaluator::evaluate(nm, k, values, cur.indices());
+        }
+        break;
 
         // Floating-point kinds
 
@@ -21,6 +21,7 @@
 #include "solver/bv/bv_solver.h"
 #include "solver/fp/fp_solver.h"
 #include "solver/fun/fun_solver.h"
+#include "solver/model_tape.h"
 #include "solver/quant/quant_solver.h"
 #include "solver/result.h"
 #include "solver/solver_state.h"
@@ -84,6 +85,18 @@ class SolverEngine
    */
   bool lemma(const Node& lemma);
 
+  /**
+   * Check the abstraction module, array and function solver on the current
+   * bit-vector assignment while the bit-vector solver is searching, called
+   * via an external propagator of the SAT solver (--bv-sat-propagator).
+   * Lemmas are processed immediately, i.e., registered to the bit-vector
+   * solver. Floating-point and quantifier checks are only performed in
+   * solve().
+   *
+   * @return False if lemmas were added.
+   */
+  bool check_theories();
+
   /** @return Solver engine backtrack manager. */
   backtrack::BacktrackManager* backtrack_mgr();
 
@@ -145,6 +158,8 @@ class SolverEngine
 
   /** Model value cache for _value(). */
   std::unordered_map<Node, Node> d_value_cache;
+  /** Compiled model evaluator for value() queries after solving. */
+  ModelTape d_model_tape;
 
   /** Associated solving context. */
   SolvingContext& d_context;
@@ -31,6 +31,12 @@ SolverState::lemma(const Node& lemma)
   return d_solver_engine.lemma(lemma);
 }
 
+bool
+SolverState::check_theories()
+{
+  return d_solver_engine.check_theories();
+}
+
 backtrack::BacktrackManager*
 SolverState::backtrack_mgr()
 {
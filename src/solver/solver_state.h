@@ -32,6 +32,14 @@ class SolverState
   /** Add a lemma. */
   bool lemma(const Node& lemma);
 
+  /**
+   * Check theory consistency of the current bit-vector assignment during
+   * SAT search.
+   * @return False if lemmas were added, which are registered to the
+   *         bit-vector solver.
+   */
+  bool check_theories();
+
   /** @return Solver engine backtrack manager. */
   backtrack::BacktrackManager* backtrack_mgr();
 
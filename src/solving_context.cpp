@@ -10,7 +10,10 @@
 
 #include "solving_context.h"
 
+#include <array>
+#include <atomic>
 #include <cassert>
+#include <exception>
 
 #include "check/check_model.h"
 #include "check/check_unsat_core.h"
@@ -18,12 +21,60 @@
 #include "node/unordered_node_ref_set.h"
 #include "resource_terminator.h"
 #include "solver/fp/symfpu_nm.h"  // Temporary for setting SymFpuNM
+#include "terminator.h"
 #include "util/resources.h"
+#include "worker_terminator.h"
 
 namespace bzla {
 
 using namespace node;
 
+namespace {
+
+/**
+ * Get options for portfolio subsolver with given index.
+ *
+ * Subsolver 0 uses the configuration of the parent solving context, all
+ * others alternate between the bv solver engines and SAT solvers and use
+ * different seeds.
+ */
+option::Options
+portfolio_options(const option::Options& options, size_t index)
+{
+  option::Options opts(options);
+  // Assertions are already preprocessed and the parent solving context
+  // enforces resource limits and performs model and unsat core checks.
+  opts.preprocess.set(false);
+  opts.portfolio.set(0);
+  opts.time_limit_per.set(0);
+  opts.memory_limit.set(0);
+  opts.produce_models.set(options.produce_models()
+                          || options.dbg_check_model());
+  opts.dbg_check_model.set(false);
+  opts.dbg_check_unsat_core.set(false);
+
+  if (index > 0)
+  {
+    static const std::array<option::BvSolver, 3> bv_solvers = {
+        option::BvSolver::BITBLAST,
+        option::BvSolver::PREPROP,
+        option::BvSolver::PROP};
+    opts.bv_solver.set(bv_solvers[index % bv_solvers.size()]);
+#ifdef BZLA_USE_KISSAT
+    if ((index / bv_solvers.size()) % 2 == 1)
+    {
+      opts.sat_solver.set(options.sat_solver() == option::SatSolver::KISSAT
+                              ? option::SatSolver::CADICAL
+                              : option::SatSolver::KISSAT);
+    }
+#endif
+    opts.seed.set(options.seed() + index);
+  }
+  return opts;
+}
+
+}  // namespace
+
 /* --- SolvingContext public ----------------------------------------------- */
 
 SolvingContext::SolvingContext(NodeManager& nm,
@@ -54,11 +105,19 @@ SolvingContext::solve()
 #endif
   d_sat_state = preprocess();
 
+  d_portfolio_winner = nullptr;
   if (d_sat_state == Result::UNKNOWN)
   {
     try
     {
-      d_sat_state = d_solver_engine.solve();
+      if (options().portfolio() > 1)
+      {
+        d_sat_state = solve_portfolio();
+      }
+      else
+      {
+        d_sat_state = d_solver_engine.solve();
+      }
     }
     catch (const UnsupportedException& e)
     {
@@ -67,7 +126,8 @@ SolvingContext::solve()
     }
   }
 
-  if (d_sat_state == Result::SAT
+  // Portfolio subsolvers already ensure their model.
+  if (d_sat_state == Result::SAT && d_portfolio_winner == nullptr
       && (options().produce_models() || options().dbg_check_model()))
   {
     ensure_model();
@@ -123,6 +183,10 @@ SolvingContext::get_value(const Node& term)
 {
   assert(d_sat_state == Result::SAT);
   fp::SymFpuNM snm(d_env.nm());
+  if (d_portfolio_winner)
+  {
+    return d_portfolio_winner->get_value(d_preprocessor.process(term));
+  }
   try
   {
     return d_solver_engine.value(d_preprocessor.process(term));
@@ -138,6 +202,37 @@ SolvingContext::get_value(const Node& term)
   }
 }
 
+std::vector<Node>
+SolvingContext::get_values(const std::vector<Node>& terms)
+{
+  assert(d_sat_state == Result::SAT);
+  fp::SymFpuNM snm(d_env.nm());
+  std::vector<Node> processed = d_preprocessor.process(terms);
+  if (d_portfolio_winner)
+  {
+    return d_portfolio_winner->get_values(processed);
+  }
+  // Values of shared subterms are only computed once since the solver engine
+  // keeps them until the next solve() call.
+  std::vector<Node> res;
+  res.reserve(terms.size());
+  for (size_t i = 0, size = terms.size(); i < size; ++i)
+  {
+    try
+    {
+      res.push_back(d_solver_engine.value(processed[i]));
+    }
+    catch (const ComputeValueException& e)
+    {
+      // See get_value().
+      Log(2) << "encountered unregistered term while computing value: "
+             << e.node();
+      res.push_back(terms[i]);
+    }
+  }
+  return res;
+}
+
 std::vector<Node>
 SolvingContext::get_unsat_core()
 {
@@ -147,6 +242,12 @@ SolvingContext::get_unsat_core()
   {
     core.push_back(d_env.nm().mk_value(false));
   }
+  else if (d_portfolio_winner)
+  {
+    // Unsat core of portfolio subsolver is in terms of the preprocessed
+    // assertions of this solving context.
+    core = d_portfolio_winner->get_unsat_core();
+  }
   else
   {
     d_solver_engine.unsat_core(core);
@@ -170,6 +271,15 @@ void
 SolvingContext::pop()
 {
   d_backtrack_mgr.pop();
+  // Portfolio subsolvers are synced lazily on solve() and may thus still be
+  // at a lower level.
+  for (auto& solver : d_portfolio)
+  {
+    if (solver->backtrack_mgr()->num_levels() > d_backtrack_mgr.num_levels())
+    {
+      solver->pop();
+    }
+  }
 }
 
 const option::Options&
@@ -362,6 +472,116 @@ SolvingContext::set_resource_limits()
   }
 }
 
+Result
+SolvingContext::solve_portfolio()
+{
+  NodeManager& nm = d_env.nm();
+  if (!nm.is_concurrent())
+  {
+    nm.enable_concurrency();
+  }
+
+  size_t num_solvers = options().portfolio();
+  if (d_portfolio.empty())
+  {
+    for (size_t i = 0; i < num_solvers; ++i)
+    {
+      d_portfolio.emplace_back(
+          new SolvingContext(nm,
+                             portfolio_options(options(), i),
+                             "portfolio" + std::to_string(i),
+                             true));
+    }
+    d_stats.portfolio_num_contexts += num_solvers;
+    d_portfolio_assertions = &d_assertions.view();
+  }
+  assert(d_portfolio.size() == num_solvers);
+
+  // Only assert preprocessed assertions that were added since the last call.
+  backtrack::AssertionView& assertions = *d_portfolio_assertions;
+  while (!assertions.empty())
+  {
+    size_t level = assertions.level(assertions.begin());
+    sync_portfolio_scope(level);
+    size_t end = assertions.end(level);
+    for (size_t i = assertions.begin(); i < end; ++i)
+    {
+      for (auto& solver : d_portfolio)
+      {
+        solver->assert_formula(assertions[i]);
+      }
+    }
+    assertions.set_index(end);
+  }
+  sync_portfolio_scope(d_backtrack_mgr.num_levels());
+  Log(1) << "solve with portfolio of " << num_solvers << " solvers";
+
+  std::atomic<size_t> winner = num_solvers;
+  // Terminates all subsolvers as soon as one of them determined
+  // satisfiability, or if the terminator of this solving context terminates.
+  WorkerTerminator terminator(d_env.terminator());
+  std::vector<Result> results(num_solvers, Result::UNKNOWN);
+  std::vector<std::exception_ptr> errors(num_solvers);
+
+  for (size_t i = 0; i < num_solvers; ++i)
+  {
+    d_portfolio[i]->env().configure_terminator(&terminator);
+  }
+  terminator.run(num_solvers, [&](size_t i) {
+    NodeManager::EpochGuard guard(nm);
+    try
+    {
+      results[i] = d_portfolio[i]->solve();
+    }
+    catch (...)
+    {
+      errors[i] = std::current_exception();
+    }
+    if (results[i] != Result::UNKNOWN)
+    {
+      size_t expected = num_solvers;
+      if (winner.compare_exchange_strong(expected, i))
+      {
+        terminator.set_terminate();
+      }
+    }
+  });
+  // Terminator goes out of scope.
+  for (auto& solver : d_portfolio)
+  {
+    solver->env().configure_terminator(nullptr);
+  }
+
+  size_t w = winner.load();
+  if (w == num_solvers)
+  {
+    for (auto& e : errors)
+    {
+      if (e)
+      {
+        std::rethrow_exception(e);
+      }
+    }
+    return Result::UNKNOWN;
+  }
+  d_stats.portfolio_winner << w;
+  Log(1) << "portfolio solver " << w << " determined result " << results[w];
+  d_portfolio_winner = d_portfolio[w].get();
+  return results[w];
+}
+
+void
+SolvingContext::sync_portfolio_scope(size_t level)
+{
+  for (auto& solver : d_portfolio)
+  {
+    while (solver->backtrack_mgr()->num_levels() < level)
+    {
+      solver->push();
+    }
+  }
+}
+
 SolvingContext::Statistics::Statistics(util::Statistics& stats)
     : time_solve(
         stats.new_stat<util::TimerStatistic>("solving_context::time_solve")),
@@ -369,7 +589,11 @@ SolvingContext::Statistics::Statistics(util::Statistics& stats)
       formula_kinds_pre(
           stats.new_stat<util::HistogramStatistic>("formula::pre::node")),
       formula_kinds_post(
-          stats.new_stat<util::HistogramStatistic>("formula::post::node"))
+          stats.new_stat<util::HistogramStatistic>("formula::post::node")),
+      portfolio_winner(stats.new_stat<util::HistogramStatistic>(
+          "solving_context::portfolio::winner")),
+      portfolio_num_contexts(stats.new_stat<uint64_t>(
+          "solving_context::portfolio::num_contexts"))
 {
 }
 
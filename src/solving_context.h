@@ -11,6 +11,7 @@
 #ifndef BZLA_SOLVING_CONTEXT_H_INCLUDED
 #define BZLA_SOLVING_CONTEXT_H_INCLUDED
 
+#include <memory>
 #include <unordered_set>
 #include <vector>
 
@@ -54,6 +55,16 @@ class SolvingContext
    */
   Node get_value(const Node& term);
 
+  /**
+   * Get the values of `terms`.
+   *
+   * @note: Only valid if last solve() call returned Result::SAT.
+   *
+   * @param terms The terms to compute the values for.
+   * @return The values of `terms` in the current model.
+   */
+  std::vector<Node> get_values(const std::vector<Node>& terms);
+
   /** @return Unsat core of previous check_sat() call. */
   std::vector<Node> get_unsat_core();
   // bool is_in_unsat_core(const Node& term) const;
@@ -92,6 +103,24 @@ class SolvingContext
   /** Set resource terminator. */
   void set_resource_limits();
 
+  /**
+   * Solve the current (preprocessed) set of assertions with a parallel
+   * portfolio of differently configured subsolvers (--portfolio).
+   *
+   * Each subsolver runs in its own thread. The first subsolver that
+   * determines satisfiability terminates all others and is used to answer
+   * subsequent get_value() and get_unsat_core() queries. The subsolvers are
+   * kept across calls and only receive the assertions added since the
+   * previous call.
+   */
+  Result solve_portfolio();
+
+  /**
+   * Push scopes in the portfolio subsolvers until they are at given level.
+   * This is required if there are levels that do not contain any assertions.
+   */
+  void sync_portfolio_scope(size_t level);
+
   /** Solving context environment. */
   Env d_env;
   /** Logger instance. */
@@ -121,6 +150,13 @@ class SolvingContext
   /** Indicates whether solving context is used as subsolver (e.g. MBQI). */
   bool d_subsolver;
 
+  /** The portfolio subsolvers, created on the first solve() call. */
+  std::vector<std::unique_ptr<SolvingContext>> d_portfolio;
+  /** The assertions not yet asserted to the portfolio subsolvers. */
+  backtrack::AssertionView* d_portfolio_assertions = nullptr;
+  /** The portfolio subsolver that determined the result of last solve(). */
+  SolvingContext* d_portfolio_winner = nullptr;
+
   struct Statistics
   {
     Statistics(util::Statistics& stats);
@@ -128,6 +164,8 @@ class SolvingContext
     uint64_t& max_memory;
     util::HistogramStatistic& formula_kinds_pre;
     util::HistogramStatistic& formula_kinds_post;
+    util::HistogramStatistic& portfolio_winner;
+    uint64_t& portfolio_num_contexts;
   } d_stats;
 };
 
@@ -162,12 +162,27 @@ TypeData::get_fp_sig_size() const
 void
 TypeData::inc_ref()
 {
-  ++d_refs;
+  if (d_mgr->d_concurrent)
+  {
+    __atomic_add_fetch(&d_refs, 1, __ATOMIC_RELAXED);
+  }
+  else
+  {
+    ++d_refs;
+  }
 }
 
 void
 TypeData::dec_ref()
 {
+  // Type data is not garbage collected in concurrent mode.
+  if (d_mgr->d_concurrent)
+  {
+    [[maybe_unused]] uint32_t refs =
+        __atomic_sub_fetch(&d_refs, 1, __ATOMIC_RELAXED);
+    assert(refs != UINT32_MAX);
+    return;
+  }
   assert(d_refs > 0);
   --d_refs;
   if (d_refs == 0)
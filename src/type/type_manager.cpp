@@ -89,6 +89,11 @@ Type
 TypeManager::mk_uninterpreted_type(const std::optional<std::string>& symbol)
 {
   TypeData* data = new TypeData(this, symbol);
+  std::unique_lock<std::mutex> lock(d_mutex, std::defer_lock);
+  if (d_concurrent)
+  {
+    lock.lock();
+  }
   init_id(data);
   return data;
 }
@@ -109,6 +114,11 @@ TypeManager::init_id(TypeData* data)
 TypeData*
 TypeManager::find_or_create(TypeData* data)
 {
+  std::unique_lock<std::mutex> lock(d_mutex, std::defer_lock);
+  if (d_concurrent)
+  {
+    lock.lock();
+  }
   auto [it, inserted] = d_unique_types.insert(data);
 
   if (!inserted)  // Type already exists
@@ -12,6 +12,7 @@
 #define BZLA_TYPE_TYPE_MANAGER_H_INCLUDED
 
 #include <memory>
+#include <mutex>
 #include <optional>
 #include <unordered_set>
 #include <vector>
@@ -84,6 +85,30 @@ class TypeManager
   Type mk_uninterpreted_type(
       const std::optional<std::string>& symbol = std::nullopt);
 
+  /**
+   * Enable concurrent mode.
+   *
+   * In concurrent mode, types can be created and copied from multiple threads
+   * concurrently. Reference counting is done atomically and type data is not
+   * garbage collected anymore until the type manager is destructed.
+   *
+   * @note Must be called while no other thread accesses the type manager.
+   */
+  void enable_concurrency() { d_concurrent = true; }
+
+  /**
+   * Disable concurrent mode.
+   *
+   * Type data that became unreferenced in concurrent mode is kept until it
+   * is reused or the type manager is destructed.
+   *
+   * @note Must be called while no other thread accesses the type manager.
+   */
+  void disable_concurrency() { d_concurrent = false; }
+
+  /** @return True if concurrent mode is enabled. */
+  bool is_concurrent() const { return d_concurrent; }
+
  private:
   /** Initialize type data. */
   void init_id(TypeData* d);
@@ -117,6 +142,11 @@ class TypeManager
   /** Indicates whether type manager is in garbage collection mode. */
   bool d_in_gc_mode = false;
 
+  /** Indicates whether concurrent mode is enabled. */
+  bool d_concurrent = false;
+  /** Mutex guarding type creation in concurrent mode. */
+  std::mutex d_mutex;
+
   /** Maps type id-1 to type data and stores all created type data. */
   std::vector<std::unique_ptr<TypeData>> d_node_data;
 
@@ -11,7 +11,11 @@
 #ifndef BZLA_UTIL_RESOURCES_H_INCLUDED
 #define BZLA_UTIL_RESOURCES_H_INCLUDED
 
+#include <chrono>
 #include <cstdint>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
 
 namespace bzla::util {
 
@@ -20,6 +24,24 @@ uint64_t maximum_memory_usage();
 
 /** Get current memory usage in bytes. */
 uint64_t current_memory_usage();
+
+/**
+ * Get the current value of a cycle counter for low-overhead measurements of
+ * short code sections. Uses the time-stamp counter on x86 and nanoseconds of
+ * a steady clock on other architectures.
+ */
+inline uint64_t
+cycle_count()
+{
+#if defined(__x86_64__) || defined(__i386__)
+  return __rdtsc();
+#else
+  return static_cast<uint64_t>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(
+          std::chrono::steady_clock::now().time_since_epoch())
+          .count());
+#endif
+}
 }
 
 #endif
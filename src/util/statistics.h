@@ -31,6 +31,13 @@ class HistogramStatistic
   /** Increment counter for val. */
   template <typename T>
   void operator<<(const T& val)
+  {
+    add(val, 1);
+  }
+
+  /** Add n to counter for val. */
+  template <typename T>
+  void add(const T& val, uint64_t n)
   {
     size_t index = static_cast<size_t>(val);
     if (index >= d_values.size())
@@ -44,7 +51,7 @@ class HistogramStatistic
       ss << val;
       d_names[index] = ss.str();
     }
-    ++d_values[index];
+    d_values[index] += n;
   }
 
   template <typename K, typename V>
@@ -0,0 +1,76 @@
+/***
+ * Bitwuzla: Satisfiability Modulo Theories (SMT) solver.
+ *
+ * Copyright (C) 2023 by the authors listed in the AUTHORS file at
+ * https://github.com/bitwuzla/bitwuzla/blob/main/AUTHORS
+ *
+ * This file is part of Bitwuzla under the MIT license. See COPYING for more
+ * information at https://github.com/bitwuzla/bitwuzla/blob/main/COPYING
+ */
+
+#include "worker_terminator.h"
+
+#include <chrono>
+#include <thread>
+#include <vector>
+
+namespace bzla {
+
+using namespace std::chrono_literals;
+
+bool
+WorkerTerminator::terminate()
+{
+  return d_terminate.load(std::memory_order_relaxed);
+}
+
+void
+WorkerTerminator::set_terminate()
+{
+  d_terminate.store(true, std::memory_order_relaxed);
+}
+
+void
+WorkerTerminator::run(size_t num_workers,
+                      const std::function<void(size_t)>& worker)
+{
+  if (d_terminator != nullptr && d_terminator->terminate())
+  {
+    set_terminate();
+  }
+
+  d_num_running = num_workers;
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < num_workers; ++i)
+  {
+    threads.emplace_back([this, &worker, i]() {
+      worker(i);
+      std::lock_guard<std::mutex> lock(d_mutex);
+      --d_num_running;
+      d_done.notify_one();
+    });
+  }
+
+  std::unique_lock<std::mutex> lock(d_mutex);
+  while (!d_done.wait_for(lock, 10ms, [this]() { return d_num_running == 0; }))
+  {
+    if (d_terminator != nullptr && !terminate())
+    {
+      // Do not block workers that are done while polling.
+      lock.unlock();
+      if (d_terminator->terminate())
+      {
+        set_terminate();
+      }
+      lock.lock();
+    }
+  }
+  lock.unlock();
+
+  for (auto& t : threads)
+  {
+    t.join();
+  }
+}
+
+}  // namespace bzla
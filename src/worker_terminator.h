@@ -0,0 +1,79 @@
+/***
+ * Bitwuzla: Satisfiability Modulo Theories (SMT) solver.
+ *
+ * Copyright (C) 2023 by the authors listed in the AUTHORS file at
+ * https://github.com/bitwuzla/bitwuzla/blob/main/AUTHORS
+ *
+ * This file is part of Bitwuzla under the MIT license. See COPYING for more
+ * information at https://github.com/bitwuzla/bitwuzla/blob/main/COPYING
+ */
+
+#ifndef BZLA_WORKER_TERMINATOR_H_INCLUDED
+#define BZLA_WORKER_TERMINATOR_H_INCLUDED
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+
+#include "terminator.h"
+
+namespace bzla {
+
+/**
+ * Terminator for worker threads, e.g., of portfolio solving.
+ *
+ * Terminators configured via the API are not required to be thread-safe.
+ * The wrapped terminator is thus only polled on the thread that runs the
+ * workers via run(), and its result is forwarded to the workers via an
+ * atomic flag, which is the only state terminate() reads.
+ */
+class WorkerTerminator : public Terminator
+{
+ public:
+  /**
+   * Constructor.
+   * @param terminator The terminator to wrap, may be null.
+   */
+  WorkerTerminator(Terminator* terminator) : d_terminator(terminator) {}
+  ~WorkerTerminator() override{};
+
+  /**
+   * Thread-safe.
+   * @return True if the workers were terminated via set_terminate() or the
+   *         wrapped terminator.
+   */
+  bool terminate() override;
+
+  /**
+   * Terminate all workers, e.g., if one of them already determined the
+   * result. Thread-safe.
+   */
+  void set_terminate();
+
+  /**
+   * Run given number of workers in parallel, each in its own thread, and
+   * wait until all of them are done. The wrapped terminator is polled on the
+   * calling thread while waiting.
+   * @param num_workers The number of workers.
+   * @param worker The worker function, called with the index of the worker.
+   */
+  void run(size_t num_workers, const std::function<void(size_t)>& worker);
+
+ private:
+  /** The wrapped terminator, only called on the thread that calls run(). */
+  Terminator* d_terminator;
+  /** True if the workers are to be terminated. */
+  std::atomic<bool> d_terminate = false;
+  /** Guards `d_num_running`. */
+  std::mutex d_mutex;
+  /** Notified when a worker is done. */
+  std::condition_variable d_done;
+  /** The number of workers that are still running. */
+  size_t d_num_running = 0;
+};
+
+}  // namespace bzla
+
+#endif
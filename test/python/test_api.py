@@ -639,6 +639,24 @@ def test_get_value(tm):
     assert bitwuzla.get_value(b).value() == False
 
 
+def test_get_values(tm):
+    bv8 = tm.mk_bv_sort(8)
+    x = tm.mk_const(bv8)
+    options = Options()
+    options.set(Option.PRODUCE_MODELS, True)
+    bitwuzla = Bitwuzla(tm, options)
+    with pytest.raises(BitwuzlaException):
+        bitwuzla.get_values([x])
+    add = tm.mk_term(Kind.BV_ADD, [x, x])
+    bitwuzla.assert_formula(tm.mk_term(Kind.BV_ULT, [tm.mk_bv_zero(bv8), x]))
+    assert bitwuzla.check_sat() == Result.SAT
+    assert bitwuzla.get_values([]) == []
+    values = bitwuzla.get_values([add, x])
+    assert len(values) == 2
+    assert values[0] == bitwuzla.get_value(add)
+    assert values[1] == bitwuzla.get_value(x)
+
+
 def test_get_bool_value(tm):
     assert tm.mk_true().value() == True
     assert tm.mk_false().value() == False
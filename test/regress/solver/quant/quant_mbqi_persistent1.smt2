@@ -0,0 +1,20 @@
+(set-logic BV)
+(declare-const x (_ BitVec 8))
+(declare-const y (_ BitVec 8))
+(assert (forall ((z (_ BitVec 8))) (or (bvule z x) (bvult y z))))
+(set-info :status sat)
+(check-sat)
+(push 1)
+(assert (bvult x #xf0))
+(set-info :status sat)
+(check-sat)
+(assert (bvult x y))
+(set-info :status unsat)
+(check-sat)
+(pop 1)
+(assert (= y #xff))
+(set-info :status sat)
+(check-sat)
+(assert (bvult x #xff))
+(set-info :status unsat)
+(check-sat)
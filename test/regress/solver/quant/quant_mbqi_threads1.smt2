@@ -0,0 +1,18 @@
+(set-logic BV)
+(declare-const x (_ BitVec 8))
+(declare-const y (_ BitVec 8))
+(declare-const z (_ BitVec 8))
+(assert (forall ((u (_ BitVec 8))) (or (bvule u x) (bvult y u))))
+(assert (forall ((u (_ BitVec 8))) (=> (= (bvand u #x0f) u) (bvuge z u))))
+(assert (forall ((u (_ BitVec 8)) (v (_ BitVec 8))) (or (distinct (bvadd u v) x) (bvuge (bvadd u v) x))))
+(assert (forall ((u (_ BitVec 8))) (distinct (bvmul u #x02) (bvor z #x01))))
+(set-info :status sat)
+(check-sat)
+(push 1)
+(assert (bvult z #x0f))
+(set-info :status unsat)
+(check-sat)
+(pop 1)
+(assert (bvult x y))
+(set-info :status unsat)
+(check-sat)
@@ -1649,6 +1649,34 @@ TEST_F(TestApi, get_value)
   }
 }
 
+TEST_F(TestApi, get_values)
+{
+  {
+    bitwuzla::Bitwuzla bitwuzla(d_tm);
+    ASSERT_THROW(bitwuzla.get_values({d_bv_const8}), bitwuzla::Exception);
+  }
+  {
+    bitwuzla::Options options;
+    options.set(bitwuzla::Option::PRODUCE_MODELS, true);
+    bitwuzla::Bitwuzla bitwuzla(d_tm, options);
+    bitwuzla::Term add =
+        d_tm.mk_term(bitwuzla::Kind::BV_ADD, {d_bv_const8, d_bv_const8});
+    bitwuzla.assert_formula(
+        d_tm.mk_term(bitwuzla::Kind::BV_ULT, {d_bv_zero8, d_bv_const8}));
+    ASSERT_THROW(bitwuzla.get_values({d_bv_const8}), bitwuzla::Exception);
+    ASSERT_EQ(bitwuzla.check_sat(), bitwuzla::Result::SAT);
+    ASSERT_THROW(bitwuzla.get_values({d_bv_const8, bitwuzla::Term()}),
+                 bitwuzla::Exception);
+    ASSERT_TRUE(bitwuzla.get_values({}).empty());
+    std::vector<bitwuzla::Term> values =
+        bitwuzla.get_values({add, d_bv_const8, d_bv_one1});
+    ASSERT_EQ(values.size(), 3);
+    ASSERT_EQ(values[0], bitwuzla.get_value(add));
+    ASSERT_EQ(values[1], bitwuzla.get_value(d_bv_const8));
+    ASSERT_EQ(values[2], d_bv_one1);
+  }
+}
+
 TEST_F(TestApi, get_bool_value)
 {
   ASSERT_EQ(true, d_true.value<bool>());
@@ -2067,6 +2095,59 @@ TEST_F(TestApi, print_formula4)
   }
 }
 
+TEST_F(TestApi, load_formula)
+{
+  bitwuzla::Options options;
+  bitwuzla::Sort bv8 = d_tm.mk_bv_sort(8);
+  bitwuzla::Term x   = d_tm.mk_const(bv8, "x");
+  bitwuzla::Term a   = d_tm.mk_const(d_tm.mk_bool_sort(), "a");
+  bitwuzla::Term gt  = d_tm.mk_term(
+      bitwuzla::Kind::BV_UGT, {x, d_tm.mk_bv_value_uint64(bv8, 200)});
+  bitwuzla::Term lt = d_tm.mk_term(
+      bitwuzla::Kind::BV_ULT, {x, d_tm.mk_bv_value_uint64(bv8, 100)});
+
+  std::stringstream ss;
+  {
+    bitwuzla::Bitwuzla bitwuzla(d_tm, options);
+    std::stringstream empty;
+    ASSERT_THROW(bitwuzla.load_formula(empty), bitwuzla::Exception);
+    bitwuzla.assert_formula(gt);
+    bitwuzla.push(1);
+    bitwuzla.assert_formula(a);
+    bitwuzla.push(2);
+    bitwuzla.assert_formula(lt);
+    bitwuzla.print_formula(ss, "binary");
+  }
+
+  bitwuzla::TermManager tm;
+  bitwuzla::Bitwuzla bitwuzla(tm, options);
+  bitwuzla.load_formula(ss);
+  std::vector<bitwuzla::Term> assertions = bitwuzla.get_assertions();
+  ASSERT_EQ(assertions.size(), 3);
+  ASSERT_EQ(assertions[0].str(), gt.str());
+  ASSERT_EQ(assertions[1].str(), a.str());
+  ASSERT_EQ(assertions[2].str(), lt.str());
+  ASSERT_EQ(bitwuzla.check_sat(), bitwuzla::Result::UNSAT);
+  // Context levels without assertions are not restored.
+  bitwuzla.pop(1);
+  ASSERT_EQ(bitwuzla.get_assertions().size(), 2);
+  ASSERT_EQ(bitwuzla.check_sat(), bitwuzla::Result::SAT);
+  bitwuzla.pop(1);
+  ASSERT_EQ(bitwuzla.get_assertions().size(), 1);
+  ASSERT_THROW(bitwuzla.pop(1), bitwuzla::Exception);
+
+  {
+    std::stringstream invalid("BZLB");
+    ASSERT_THROW(bitwuzla.load_formula(invalid), bitwuzla::Exception);
+  }
+  {
+    std::stringstream terms;
+    tm.dump_terms(terms, {tm.mk_bv_zero(tm.mk_bv_sort(8))});
+    ASSERT_THROW(bitwuzla.load_formula(terms), bitwuzla::Exception);
+  }
+  ASSERT_EQ(bitwuzla.get_assertions().size(), 1);
+}
+
 /* -------------------------------------------------------------------------- */
 /* Stastics                                                                   */
 /* -------------------------------------------------------------------------- */
@@ -2083,6 +2164,22 @@ TEST_F(TestApi, statistics)
   }
 }
 
+TEST_F(TestApi, statistics_rewrite_profile)
+{
+  bitwuzla::Options options;
+  options.set(bitwuzla::Option::REWRITE_PROFILE, true);
+  bitwuzla::Bitwuzla bitwuzla(d_tm, options);
+  bitwuzla.assert_formula(
+      d_tm.mk_term(bitwuzla::Kind::AND, {d_bool_const, d_true}));
+  bitwuzla.check_sat();
+  auto stats = bitwuzla.statistics();
+  ASSERT_EQ(stats.at("rewriter::profile::attempts::AND_EVAL"), "1");
+  ASSERT_EQ(stats.find("rewriter::profile::successes::AND_EVAL"), stats.end());
+  ASSERT_EQ(stats.at("rewriter::profile::successes::AND_SPECIAL_CONST"), "1");
+  ASSERT_NE(stats.find("rewriter::profile::cycles::AND_SPECIAL_CONST"),
+            stats.end());
+}
+
 /* -------------------------------------------------------------------------- */
 /* Sort                                                                       */
 /* -------------------------------------------------------------------------- */
@@ -3108,6 +3205,72 @@ TEST_F(TestApi, substitute2)
   ASSERT_EQ(terms, expected);
 }
 
+TEST_F(TestApi, dump_load_terms)
+{
+  bitwuzla::Sort bv8  = d_tm.mk_bv_sort(8);
+  bitwuzla::Sort bv80 = d_tm.mk_bv_sort(80);
+  bitwuzla::Term x    = d_tm.mk_const(bv8, "x");
+  bitwuzla::Term y    = d_tm.mk_const(bv80, "y");
+  bitwuzla::Term a    = d_tm.mk_const(d_arr_sort_bv, "a");
+  bitwuzla::Term i    = d_tm.mk_const(d_bv_sort32, "i");
+  bitwuzla::Term big  = d_tm.mk_bv_value(bv80, "f0000000000000000001", 16);
+  std::vector<bitwuzla::Term> terms = {
+      d_tm.mk_term(bitwuzla::Kind::ARRAY_SELECT,
+                   {d_tm.mk_term(bitwuzla::Kind::ARRAY_STORE, {a, i, x}), i}),
+      d_tm.mk_term(bitwuzla::Kind::BV_ADD, {y, big}),
+      d_lambda,
+      big,
+      x};
+
+  std::stringstream ss;
+  ASSERT_THROW(d_tm.dump_terms(ss, {bitwuzla::Term()}), bitwuzla::Exception);
+  {
+    bitwuzla::TermManager tm;
+    ASSERT_THROW(d_tm.dump_terms(ss, {tm.mk_true()}), bitwuzla::Exception);
+  }
+  ASSERT_TRUE(ss.str().empty());
+
+  d_tm.dump_terms(ss, terms);
+  std::string bytes = ss.str();
+  {
+    // Constants are created fresh, all other terms are shared.
+    std::stringstream in(bytes);
+    std::vector<bitwuzla::Term> res = d_tm.load_terms(in);
+    ASSERT_EQ(res.size(), terms.size());
+    for (size_t j = 0; j < terms.size(); ++j)
+    {
+      ASSERT_EQ(res[j].sort(), terms[j].sort());
+      ASSERT_EQ(res[j].str(), terms[j].str());
+    }
+    ASSERT_EQ(res[3], big);
+    ASSERT_NE(res[4], x);
+    ASSERT_EQ(res[4].symbol()->get(), "x");
+    ASSERT_EQ(res[0][0][2], res[4]);
+  }
+  {
+    bitwuzla::TermManager tm;
+    std::stringstream in(bytes);
+    std::vector<bitwuzla::Term> res = tm.load_terms(in);
+    ASSERT_EQ(res.size(), terms.size());
+    for (size_t j = 0; j < terms.size(); ++j)
+    {
+      ASSERT_EQ(res[j].str(), terms[j].str());
+    }
+    std::stringstream out;
+    tm.dump_terms(out, res);
+    ASSERT_EQ(out.str(), bytes);
+  }
+  {
+    std::stringstream empty;
+    d_tm.dump_terms(empty, {});
+    ASSERT_TRUE(d_tm.load_terms(empty).empty());
+  }
+  {
+    std::stringstream truncated(bytes.substr(0, bytes.size() - 1));
+    ASSERT_THROW(d_tm.load_terms(truncated), bitwuzla::Exception);
+  }
+}
+
 TEST_F(TestApi, term_print1)
 {
   bitwuzla::Term a = d_tm.mk_const(d_bv_sort1, "a");
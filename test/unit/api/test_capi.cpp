@@ -2705,6 +2705,30 @@ TEST_F(TestCApi, get_value)
     bitwuzla_delete(bitwuzla);
     bitwuzla_options_delete(options);
   }
+  {
+    BitwuzlaOptions *options = bitwuzla_options_new();
+    bitwuzla_set_option(options, BITWUZLA_OPT_PRODUCE_MODELS, 1);
+    Bitwuzla *bitwuzla = bitwuzla_new(d_tm, options);
+    std::vector<BitwuzlaTerm> terms{d_bv_const1, d_bv_const1_false};
+    ASSERT_DEATH(bitwuzla_get_values(nullptr, terms.size(), terms.data()),
+                 d_error_not_null);
+    ASSERT_DEATH(bitwuzla_get_values(bitwuzla, terms.size(), nullptr),
+                 d_error_not_null);
+    ASSERT_DEATH(bitwuzla_get_values(bitwuzla, terms.size(), terms.data()),
+                 d_error_sat);
+    bitwuzla_assert(bitwuzla, d_bv_const1_true);
+    bitwuzla_check_sat(bitwuzla);
+    const BitwuzlaTerm *values =
+        bitwuzla_get_values(bitwuzla, terms.size(), terms.data());
+    ASSERT_EQ(d_bv_one1, values[0]);
+    ASSERT_EQ(bitwuzla_mk_false(d_tm), values[1]);
+    std::vector<BitwuzlaTerm> inv_terms{d_bv_const1, 0};
+    ASSERT_DEATH(
+        bitwuzla_get_values(bitwuzla, inv_terms.size(), inv_terms.data()),
+        d_error_inv_term);
+    bitwuzla_delete(bitwuzla);
+    bitwuzla_options_delete(options);
+  }
   {
     BitwuzlaOptions *options = bitwuzla_options_new();
     bitwuzla_set_option(options, BITWUZLA_OPT_PRODUCE_MODELS, 1);
@@ -2830,7 +2854,7 @@ TEST_F(TestCApi, print_formula)
   ASSERT_DEATH(bitwuzla_print_formula(bitwuzla, "smt2", nullptr, 2),
                d_error_not_null);
   ASSERT_DEATH(bitwuzla_print_formula(bitwuzla, "asdf", stdout, 2),
-               "invalid format, expected 'smt2'");
+               "invalid format, expected 'smt2' or 'binary'");
   ASSERT_DEATH(bitwuzla_print_formula(bitwuzla, "smt2", stdout, 23),
                "invalid bit-vector output number format");
 
@@ -3203,6 +3227,63 @@ TEST_F(TestCApi, print_formula3)
   bitwuzla_options_delete(options);
 }
 
+TEST_F(TestCApi, load_formula)
+{
+  ASSERT_DEATH(bitwuzla_load_formula(nullptr, stdin), d_error_not_null);
+
+  BitwuzlaOptions *options = bitwuzla_options_new();
+  Bitwuzla *bitwuzla       = bitwuzla_new(d_tm, options);
+
+  ASSERT_DEATH(bitwuzla_load_formula(bitwuzla, nullptr), d_error_not_null);
+
+  std::string filename = "load_formula.out";
+  BitwuzlaSort bv8     = bitwuzla_mk_bv_sort(d_tm, 8);
+  BitwuzlaTerm x       = bitwuzla_mk_const(d_tm, bv8, "x");
+  BitwuzlaTerm v200    = bitwuzla_mk_bv_value_uint64(d_tm, bv8, 200);
+  BitwuzlaTerm v100    = bitwuzla_mk_bv_value_uint64(d_tm, bv8, 100);
+  BitwuzlaTerm gt      = bitwuzla_mk_term2(d_tm, BITWUZLA_KIND_BV_UGT, x, v200);
+  BitwuzlaTerm lt      = bitwuzla_mk_term2(d_tm, BITWUZLA_KIND_BV_ULT, x, v100);
+  bitwuzla_assert(bitwuzla, gt);
+  bitwuzla_push(bitwuzla, 1);
+  bitwuzla_assert(bitwuzla, lt);
+
+  FILE *file = fopen(filename.c_str(), "wb");
+  bitwuzla_print_formula(bitwuzla, "binary", file, 2);
+  fclose(file);
+  bitwuzla_delete(bitwuzla);
+
+  BitwuzlaTermManager *tm = bitwuzla_term_manager_new();
+  bitwuzla                = bitwuzla_new(tm, options);
+  file                    = fopen(filename.c_str(), "rb");
+  bitwuzla_load_formula(bitwuzla, file);
+  fclose(file);
+  unlink(filename.c_str());
+
+  size_t size;
+  const BitwuzlaTerm *assertions = bitwuzla_get_assertions(bitwuzla, &size);
+  ASSERT_EQ(size, 2);
+  ASSERT_EQ(std::string(bitwuzla_term_to_string(assertions[0])),
+            std::string(bitwuzla_term_to_string(gt)));
+  ASSERT_EQ(std::string(bitwuzla_term_to_string(assertions[1])),
+            std::string(bitwuzla_term_to_string(lt)));
+  ASSERT_EQ(bitwuzla_check_sat(bitwuzla), BITWUZLA_UNSAT);
+  bitwuzla_pop(bitwuzla, 1);
+  ASSERT_EQ(bitwuzla_check_sat(bitwuzla), BITWUZLA_SAT);
+
+  file = fopen(filename.c_str(), "wb");
+  fputs("BZLB", file);
+  fclose(file);
+  file = fopen(filename.c_str(), "rb");
+  ASSERT_DEATH(bitwuzla_load_formula(bitwuzla, file),
+               "failed to load formula: byte 4: unexpected end of input");
+  fclose(file);
+  unlink(filename.c_str());
+
+  bitwuzla_delete(bitwuzla);
+  bitwuzla_term_manager_delete(tm);
+  bitwuzla_options_delete(options);
+}
+
 /* -------------------------------------------------------------------------- */
 /* Statistics                                                                 */
 /* -------------------------------------------------------------------------- */
@@ -5149,6 +5230,63 @@ TEST_F(TestCApi, substitute2)
   }
 }
 
+TEST_F(TestCApi, dump_load_terms)
+{
+  std::string filename = "dump_load_terms.out";
+  BitwuzlaSort bv8     = bitwuzla_mk_bv_sort(d_tm, 8);
+  BitwuzlaTerm x       = bitwuzla_mk_const(d_tm, bv8, "x");
+  BitwuzlaTerm one     = bitwuzla_mk_bv_one(d_tm, bv8);
+  BitwuzlaTerm add     = bitwuzla_mk_term2(d_tm, BITWUZLA_KIND_BV_ADD, x, one);
+  std::vector<BitwuzlaTerm> terms = {add, one, d_lambda};
+
+  ASSERT_DEATH(bitwuzla_dump_terms(nullptr, terms.size(), terms.data(), stdout),
+               d_error_not_null);
+  ASSERT_DEATH(bitwuzla_dump_terms(d_tm, terms.size(), nullptr, stdout),
+               d_error_not_null);
+  ASSERT_DEATH(bitwuzla_dump_terms(d_tm, terms.size(), terms.data(), nullptr),
+               d_error_not_null);
+  std::vector<BitwuzlaTerm> invalid = {add, nullptr};
+  ASSERT_DEATH(
+      bitwuzla_dump_terms(d_tm, invalid.size(), invalid.data(), stdout),
+      d_error_inv_term);
+
+  size_t size;
+  ASSERT_DEATH(bitwuzla_load_terms(nullptr, stdin, &size), d_error_not_null);
+  ASSERT_DEATH(bitwuzla_load_terms(d_tm, nullptr, &size), d_error_not_null);
+  ASSERT_DEATH(bitwuzla_load_terms(d_tm, stdin, nullptr), d_error_not_null);
+
+  FILE *file = fopen(filename.c_str(), "wb");
+  bitwuzla_dump_terms(d_tm, terms.size(), terms.data(), file);
+  fclose(file);
+
+  BitwuzlaTermManager *tm = bitwuzla_term_manager_new();
+  file                    = fopen(filename.c_str(), "rb");
+  const BitwuzlaTerm *res = bitwuzla_load_terms(tm, file, &size);
+  fclose(file);
+  unlink(filename.c_str());
+  ASSERT_EQ(size, terms.size());
+  for (size_t i = 0; i < size; ++i)
+  {
+    ASSERT_EQ(std::string(bitwuzla_term_to_string(res[i])),
+              std::string(bitwuzla_term_to_string(terms[i])));
+  }
+  size_t num_children;
+  BitwuzlaTerm *children = bitwuzla_term_get_children(res[0], &num_children);
+  ASSERT_EQ(num_children, 2);
+  ASSERT_EQ(std::string(bitwuzla_term_get_symbol(children[0])), "x");
+  bitwuzla_term_manager_delete(tm);
+
+  file = fopen(filename.c_str(), "wb");
+  bitwuzla_dump_terms(d_tm, 0, nullptr, file);
+  fclose(file);
+  file = fopen(filename.c_str(), "rb");
+  res  = bitwuzla_load_terms(d_tm, file, &size);
+  fclose(file);
+  unlink(filename.c_str());
+  ASSERT_EQ(size, 0);
+  ASSERT_EQ(res, nullptr);
+}
+
 TEST_F(TestCApi, term_copy_release)
 {
   BitwuzlaTermManager *tm = bitwuzla_term_manager_new();
@@ -5478,6 +5616,54 @@ TEST_F(TestCApi, abort_callback)
   }
 }
 
+namespace {
+std::string s_abort_msg;
+
+void
+record_abort(const char *msg)
+{
+  s_abort_msg = msg;
+}
+}  // namespace
+
+TEST_F(TestCApi, abort_callback_load)
+{
+  std::string filename = "abort_callback_load.out";
+  FILE *file           = fopen(filename.c_str(), "wb");
+  fputs("BZLB", file);
+  fclose(file);
+
+  BitwuzlaOptions *options = bitwuzla_options_new();
+  Bitwuzla *bitwuzla       = bitwuzla_new(d_tm, options);
+  file                     = fopen(filename.c_str(), "rb");
+
+  bitwuzla_set_abort_callback(record_abort);
+  size_t size                = 1;
+  const BitwuzlaTerm *res    = bitwuzla_load_terms(d_tm, file, &size);
+  std::string load_terms_msg = s_abort_msg;
+  rewind(file);
+  bitwuzla_load_formula(bitwuzla, file);
+  std::string load_formula_msg = s_abort_msg;
+  bitwuzla_set_abort_callback(nullptr);
+
+  fclose(file);
+  unlink(filename.c_str());
+
+  ASSERT_EQ(res, nullptr);
+  ASSERT_EQ(size, 0);
+  ASSERT_NE(load_terms_msg.find(
+                "failed to load terms: byte 4: unexpected end of input"),
+            std::string::npos);
+  ASSERT_NE(load_formula_msg.find(
+                "failed to load formula: byte 4: unexpected end of input"),
+            std::string::npos);
+  bitwuzla_get_assertions(bitwuzla, &size);
+  ASSERT_EQ(size, 0);
+
+  bitwuzla_delete(bitwuzla);
+  bitwuzla_options_delete(options);
+}
+
 /* -------------------------------------------------------------------------- */
 
 }  // namespace bzla::test
@@ -135,6 +135,28 @@ class TestAigBitblaster : public TestCommon
     test_binary(op, res, a, b);      \
   }
 
+#define TEST_MUL_ENC(size, enc)                      \
+  {                                                  \
+    bitblast::AigBitblaster bb;                      \
+    bb.set_mul_encoding(bitblast::MulEncoding::enc); \
+    auto a   = bb.bv_constant(size);                 \
+    auto b   = bb.bv_constant(size);                 \
+    auto res = bb.bv_mul(a, b);                      \
+    test_binary("bvmul", res, a, b);                 \
+  }
+
+#define TEST_DIV_ENC(size, enc)                      \
+  {                                                  \
+    bitblast::AigBitblaster bb;                      \
+    bb.set_div_encoding(bitblast::DivEncoding::enc); \
+    auto a           = bb.bv_constant(size);         \
+    auto b           = bb.bv_constant(size);         \
+    auto [quot, rem] = bb.bv_udiv_urem(a, b);        \
+    ASSERT_TRUE(bb.take_side_constraints().empty()); \
+    test_binary("bvudiv", quot, a, b);               \
+    test_binary("bvurem", rem, a, b);                \
+  }
+
 TEST_F(TestAigBitblaster, ctor_dtor) { bitblast::AigBitblaster bb; }
 
 TEST_F(TestAigBitblaster, bv_value)
@@ -341,6 +363,22 @@ TEST_F(TestAigBitblaster, bv_mul4) { TEST_BIN_OP(4, "bvmul", bv_mul); }
 
 TEST_F(TestAigBitblaster, bv_mul8) { TEST_BIN_OP(8, "bvmul", bv_mul); }
 
+TEST_F(TestAigBitblaster, bv_mul_booth1) { TEST_MUL_ENC(1, BOOTH); }
+
+TEST_F(TestAigBitblaster, bv_mul_booth3) { TEST_MUL_ENC(3, BOOTH); }
+
+TEST_F(TestAigBitblaster, bv_mul_booth8) { TEST_MUL_ENC(8, BOOTH); }
+
+TEST_F(TestAigBitblaster, bv_mul_wallace1) { TEST_MUL_ENC(1, WALLACE); }
+
+TEST_F(TestAigBitblaster, bv_mul_wallace3) { TEST_MUL_ENC(3, WALLACE); }
+
+TEST_F(TestAigBitblaster, bv_mul_wallace8) { TEST_MUL_ENC(8, WALLACE); }
+
+TEST_F(TestAigBitblaster, bv_mul_karatsuba8) { TEST_MUL_ENC(8, KARATSUBA); }
+
+TEST_F(TestAigBitblaster, bv_mul_karatsuba32) { TEST_MUL_ENC(32, KARATSUBA); }
+
 TEST_F(TestAigBitblaster, bv_mul_square)
 {
   for (size_t i = 1; i < 17; ++i)
@@ -374,6 +412,34 @@ TEST_F(TestAigBitblaster, bv_udiv9) { TEST_BIN_OP(9, "bvudiv", bv_udiv); }
 
 TEST_F(TestAigBitblaster, bv_udiv10) { TEST_BIN_OP(10, "bvudiv", bv_udiv); }
 
+TEST_F(TestAigBitblaster, bv_udiv_urem_non_restoring1)
+{
+  TEST_DIV_ENC(1, NON_RESTORING);
+}
+
+TEST_F(TestAigBitblaster, bv_udiv_urem_non_restoring3)
+{
+  TEST_DIV_ENC(3, NON_RESTORING);
+}
+
+TEST_F(TestAigBitblaster, bv_udiv_urem_non_restoring8)
+{
+  TEST_DIV_ENC(8, NON_RESTORING);
+}
+
+TEST_F(TestAigBitblaster, bv_udiv_urem_multiplier)
+{
+  bitblast::AigBitblaster bb;
+  bb.set_div_encoding(bitblast::DivEncoding::MULTIPLIER);
+  auto a           = bb.bv_constant(8);
+  auto b           = bb.bv_constant(8);
+  auto [quot, rem] = bb.bv_udiv_urem(a, b);
+  ASSERT_EQ(quot.size(), 8u);
+  ASSERT_EQ(rem.size(), 8u);
+  ASSERT_EQ(bb.take_side_constraints().size(), 1u);
+  ASSERT_TRUE(bb.take_side_constraints().empty());
+}
+
 TEST_F(TestAigBitblaster, bv_urem)
 {
   bitblast::AigBitblaster bb;
@@ -307,6 +307,142 @@ TEST_F(TestAigCnf, enc_or)
                         {or_id, a.get_id(), b.get_id()}}));
 }
 
+TEST_F(TestAigCnf, enc_scope)
+{
+  bitblast::BitInterface<bitblast::AigNode> aigmgr;
+  DummySatSolver solver;
+  bitblast::AigCnfEncoder enc(solver);
+
+  bitblast::AigNode act     = aigmgr.mk_bit();
+  bitblast::AigNode a       = aigmgr.mk_bit();
+  bitblast::AigNode b       = aigmgr.mk_bit();
+  bitblast::AigNode and_aig = aigmgr.mk_and(a, b);
+  auto x                    = and_aig.get_id();
+  enc.push(act.get_id());
+  enc.encode(and_aig);
+  ASSERT_TRUE(enc.is_encoded(and_aig));
+  ASSERT_EQ(solver.get_clauses(),
+            ClauseList({{-act.get_id(), -x, a.get_id()},
+                        {-act.get_id(), -x, b.get_id()},
+                        {-act.get_id(), x, -a.get_id(), -b.get_id()}}));
+  enc.pop();
+  ASSERT_FALSE(enc.is_encoded(and_aig));
+  ASSERT_EQ(solver.get_clauses().back(), std::vector<int64_t>{-act.get_id()});
+  ASSERT_EQ(enc.statistics().num_retired, 3u);
+
+  // Re-encoding after pop adds the clauses globally.
+  solver.get_clauses().clear();
+  enc.encode(and_aig);
+  ASSERT_EQ(solver.get_clauses(),
+            ClauseList({{-x, a.get_id()},
+                        {-x, b.get_id()},
+                        {x, -a.get_id(), -b.get_id()}}));
+}
+
+TEST_F(TestAigCnf, enc_and_multi)
+{
+  bitblast::BitInterface<bitblast::AigNode> aigmgr;
+  DummySatSolver solver;
+  bitblast::AigCnfEncoder enc(solver);
+
+  bitblast::AigNode a        = aigmgr.mk_bit();
+  bitblast::AigNode b        = aigmgr.mk_bit();
+  bitblast::AigNode c        = aigmgr.mk_bit();
+  bitblast::AigNode and_aig1 = aigmgr.mk_and(a, b);
+  bitblast::AigNode and_aig2 = aigmgr.mk_and(and_aig1, c);
+  auto x                     = and_aig2.get_id();
+  enc.encode(and_aig2);
+  // The single-parent gate and_aig1 is merged into and_aig2.
+  ASSERT_FALSE(enc.is_encoded(and_aig1));
+  ASSERT_EQ(solver.get_clauses(),
+            ClauseList({{-x, c.get_id()},
+                        {-x, a.get_id()},
+                        {-x, b.get_id()},
+                        {x, -c.get_id(), -a.get_id(), -b.get_id()}}));
+  ASSERT_EQ(enc.statistics().num_clauses, 4u);
+  ASSERT_EQ(enc.statistics().num_literals, 10u);
+}
+
+TEST_F(TestAigCnf, enc_xor)
+{
+  bitblast::BitInterface<bitblast::AigNode> aigmgr;
+  DummySatSolver solver;
+  bitblast::AigCnfEncoder enc(solver);
+
+  bitblast::AigNode a       = aigmgr.mk_bit();
+  bitblast::AigNode b       = aigmgr.mk_bit();
+  bitblast::AigNode xor_aig = aigmgr.mk_and(
+      aigmgr.mk_not(aigmgr.mk_and(a, b)),
+      aigmgr.mk_not(aigmgr.mk_and(aigmgr.mk_not(a), aigmgr.mk_not(b))));
+  auto x = xor_aig.get_id();
+  enc.encode(xor_aig);
+  ASSERT_EQ(enc.statistics().num_vars, 3u);
+  ASSERT_EQ(enc.statistics().num_clauses, 4u);
+  ASSERT_EQ(enc.statistics().num_literals, 12u);
+  for (const auto& clause : solver.get_clauses())
+  {
+    ASSERT_EQ(clause.size(), 3u);
+    ASSERT_TRUE(std::abs(clause[0]) == x);
+    // x <-> a xor b: exactly one of a, b is true if x is true
+    int64_t sign = (clause[1] > 0) == (clause[2] > 0) ? -1 : 1;
+    ASSERT_EQ(clause[0], sign * x);
+  }
+}
+
+TEST_F(TestAigCnf, enc_polarity)
+{
+  bitblast::BitInterface<bitblast::AigNode> aigmgr;
+  DummySatSolver solver;
+  bitblast::AigCnfEncoder enc(solver, true);
+
+  bitblast::AigNode a       = aigmgr.mk_bit();
+  bitblast::AigNode b       = aigmgr.mk_bit();
+  bitblast::AigNode and_aig = aigmgr.mk_and(a, b);
+  auto x                    = and_aig.get_id();
+  // Positive occurrence: x -> a /\ b
+  enc.encode(and_aig);
+  ASSERT_EQ(solver.get_clauses(),
+            ClauseList({{-x, a.get_id()}, {-x, b.get_id()}}));
+  enc.encode(and_aig);
+  ASSERT_EQ(solver.get_clauses().size(), 2u);
+  // Negative occurrence: a /\ b -> x
+  bitblast::AigNode nand_aig = aigmgr.mk_not(and_aig);
+  enc.encode(nand_aig);
+  ASSERT_EQ(solver.get_clauses(),
+            ClauseList({{-x, a.get_id()},
+                        {-x, b.get_id()},
+                        {x, -a.get_id(), -b.get_id()}}));
+}
+
+TEST_F(TestAigCnf, enc_polarity_scope)
+{
+  bitblast::BitInterface<bitblast::AigNode> aigmgr;
+  DummySatSolver solver;
+  bitblast::AigCnfEncoder enc(solver, true);
+
+  bitblast::AigNode act     = aigmgr.mk_bit();
+  bitblast::AigNode a       = aigmgr.mk_bit();
+  bitblast::AigNode b       = aigmgr.mk_bit();
+  bitblast::AigNode and_aig = aigmgr.mk_and(a, b);
+  auto x                    = and_aig.get_id();
+  enc.encode(and_aig);
+  enc.push(act.get_id());
+  enc.encode(aigmgr.mk_not(and_aig));
+  ASSERT_EQ(solver.get_clauses().back(),
+            std::vector<int64_t>({-act.get_id(), x, -a.get_id(), -b.get_id()}));
+  enc.pop();
+  ASSERT_TRUE(enc.is_encoded(and_aig));
+  ASSERT_EQ(enc.statistics().num_retired, 1u);
+
+  // Only the negative phase was retired.
+  solver.get_clauses().clear();
+  enc.encode(and_aig);
+  ASSERT_TRUE(solver.get_clauses().empty());
+  enc.encode(aigmgr.mk_not(and_aig));
+  ASSERT_EQ(solver.get_clauses(),
+            ClauseList({{x, -a.get_id(), -b.get_id()}}));
+}
+
 #if 0
 TEST_F(TestAigCnf, enc_or_top)
 {
@@ -483,4 +483,43 @@ TEST_F(TestAigMgr, idempotence4_3)
   }
 }
 
+TEST_F(TestAigMgr, garbage_collect)
+{
+  bitblast::AigManager mgr;
+
+  std::vector<bitblast::AigNode> consts;
+  for (size_t i = 0; i < 100; ++i)
+  {
+    consts.push_back(mgr.mk_const());
+  }
+  {
+    std::vector<bitblast::AigNode> ands;
+    for (size_t i = 0; i + 1 < consts.size(); i += 2)
+    {
+      ands.push_back(mgr.mk_and(consts[i], mgr.mk_not(consts[i + 1])));
+    }
+    for (size_t i = 0, size = ands.size(); i + 1 < size; ++i)
+    {
+      ands.push_back(mgr.mk_and(ands[i], ands[i + 1]));
+    }
+    ASSERT_EQ(ands.size(), 99u);
+    ASSERT_EQ(mgr.statistics().num_ands, ands.size());
+    ASSERT_EQ(mgr.d_unique_table.size(), ands.size());
+    ASSERT_EQ(consts[0].parents(), 1u);
+    ASSERT_EQ(ands[0].parents(), 1u);
+    ASSERT_EQ(ands[1].parents(), 2u);
+  }
+  ASSERT_EQ(mgr.statistics().num_ands, 0u);
+  ASSERT_EQ(mgr.d_unique_table.size(), 0u);
+  ASSERT_EQ(consts[0].parents(), 0u);
+  ASSERT_EQ(consts[0].get_refs(), 1u);
+
+  // Gates are created again after garbage collection.
+  auto a = mgr.mk_and(consts[0], consts[1]);
+  ASSERT_EQ(mgr.statistics().num_ands, 1u);
+  ASSERT_EQ(a, mgr.mk_and(consts[1], consts[0]));
+  ASSERT_EQ(a[0], consts[0]);
+  ASSERT_EQ(a[1], consts[1]);
+}
+
 }  // namespace bzla::test
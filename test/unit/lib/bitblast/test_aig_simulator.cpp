@@ -0,0 +1,118 @@
+/***
+ * Bitwuzla: Satisfiability Modulo Theories (SMT) solver.
+ *
+ * Copyright (C) 2023 by the authors listed in the AUTHORS file at
+ * https://github.com/bitwuzla/bitwuzla/blob/main/AUTHORS
+ *
+ * This file is part of Bitwuzla under the MIT license. See COPYING for more
+ * information at https://github.com/bitwuzla/bitwuzla/blob/main/COPYING
+ */
+
+#include <random>
+
+#include "bitblast/aig/aig_simulator.h"
+#include "bitblast/aig_bitblaster.h"
+#include "test_lib.h"
+
+namespace bzla::test {
+
+using namespace bitblast;
+
+class TestAigSimulator : public TestCommon
+{
+ protected:
+  /** Simulate `num_words` words of random patterns. */
+  void simulate(AigSimulator& sim, size_t num_words)
+  {
+    std::vector<uint64_t> patterns(sim.inputs().size() * num_words);
+    for (auto& word : patterns)
+    {
+      word = d_rng();
+    }
+    sim.simulate(patterns, num_words);
+  }
+
+  /** Get the value of `bits` for given pattern as unsigned integer. */
+  uint64_t value(const AigSimulator& sim,
+                 const AigBitblaster::Bits& bits,
+                 size_t pattern)
+  {
+    uint64_t res = 0;
+    for (const auto& bit : bits)
+    {
+      res = (res << 1) | ((sim.value(bit, pattern / 64) >> (pattern % 64)) & 1);
+    }
+    return res;
+  }
+
+  std::mt19937_64 d_rng{42};
+};
+
+TEST_F(TestAigSimulator, constants)
+{
+  AigBitblaster bb;
+  AigNode t = bb.mk_true();
+  AigNode f = bb.mk_not(t);
+  AigNode x = bb.bv_constant(1)[0];
+
+  AigSimulator sim({f, x, t});
+  ASSERT_EQ(sim.size(), 2u);
+  ASSERT_EQ(sim.inputs().size(), 1u);
+  ASSERT_EQ(sim.index(t), sim.index(f));
+  simulate(sim, 3);
+  ASSERT_EQ(sim.num_words(), 3u);
+  for (size_t w = 0; w < 3; ++w)
+  {
+    ASSERT_EQ(sim.value(t, w), ~uint64_t(0));
+    ASSERT_EQ(sim.value(f, w), 0u);
+    ASSERT_EQ(sim.value(bb.mk_not(x), w), ~sim.value(x, w));
+  }
+}
+
+TEST_F(TestAigSimulator, add_mul)
+{
+  AigBitblaster bb;
+  size_t size = 16;
+  auto a      = bb.bv_constant(size);
+  auto b      = bb.bv_constant(size);
+  auto add    = bb.bv_add(a, b);
+  auto mul    = bb.bv_mul(a, b);
+
+  std::vector<AigNode> roots(add.begin(), add.end());
+  roots.insert(roots.end(), mul.begin(), mul.end());
+  AigSimulator sim(roots);
+  ASSERT_EQ(sim.inputs().size(), 2 * size);
+
+  for (size_t num_words : {1, 4, 8})
+  {
+    simulate(sim, num_words);
+    for (size_t p = 0; p < num_words * 64; ++p)
+    {
+      uint64_t va = value(sim, a, p);
+      uint64_t vb = value(sim, b, p);
+      ASSERT_EQ(value(sim, add, p), (va + vb) & 0xffff);
+      ASSERT_EQ(value(sim, mul, p), (va * vb) & 0xffff);
+    }
+  }
+}
+
+TEST_F(TestAigSimulator, find_pattern)
+{
+  AigBitblaster bb;
+  auto a = bb.bv_constant(4);
+  auto b = bb.bv_constant(4);
+
+  AigNode ult = bb.bv_ult(a, b)[0];
+  AigNode eq  = bb.bv_eq(a, b)[0];
+  AigSimulator sim({ult, eq});
+  simulate(sim, 8);
+
+  size_t pattern;
+  ASSERT_TRUE(sim.find_pattern({ult}, pattern));
+  ASSERT_LT(value(sim, a, pattern), value(sim, b, pattern));
+  ASSERT_TRUE(sim.find_pattern({bb.mk_not(ult), bb.mk_not(eq)}, pattern));
+  ASSERT_GT(value(sim, a, pattern), value(sim, b, pattern));
+  ASSERT_FALSE(sim.find_pattern({ult, eq}, pattern));
+}
+
+}  // namespace bzla::test
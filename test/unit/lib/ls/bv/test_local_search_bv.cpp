@@ -9,6 +9,8 @@
  */
 
 #include <map>
+#include <unordered_map>
+#include <unordered_set>
 
 #include "ls/ls_bv.h"
 #include "test_bvnode.h"
@@ -18,6 +20,9 @@ namespace bzla::ls::test {
 class TestLsBv : public TestBvNodeCommon
 {
  protected:
+  using ParentsMap =
+      std::unordered_map<uint64_t, std::unordered_set<uint64_t>>;
+
   /**
    * True to enable slow tests (of larger bit-width TEST_BW = 4), else use
    * TEST_BW_FAST = 3. This distinction is only used for tests that are slow
@@ -106,13 +111,14 @@ class TestLsBv : public TestBvNodeCommon
    * Create a mapping from nodes to their parents to compare against the
    * mapping created internally on node creation.
    */
-  LocalSearchBV::ParentsMap get_expected_parents();
+  ParentsMap get_expected_parents();
   /**
-   * Get a reference of the parents map of the LocalSearchBV object.
-   * Note: LocalSearchBV::d_parents is private and only the main test class has
+   * Get the parents map of the LocalSearchBV object, constructed from its
+   * parents adjacency array.
+   * Note: LocalSearchBV::parents() is private and only the main test class has
    *       access to it.
    */
-  const LocalSearchBV::ParentsMap& get_parents() { return d_ls->d_parents; }
+  ParentsMap get_parents();
 
   /**
    * Wrapper for LocalSearchBV::update_cone().
@@ -143,10 +149,25 @@ class TestLsBv : public TestBvNodeCommon
   uint64_t d_root1, d_root2;
 };
 
-LocalSearchBV::ParentsMap
+TestLsBv::ParentsMap
+TestLsBv::get_parents()
+{
+  ParentsMap parents;
+  for (uint64_t id = 0, n = d_ls->d_nodes.size(); id < n; ++id)
+  {
+    std::unordered_set<uint64_t>& ps = parents[id];
+    for (uint64_t p : d_ls->parents(id))
+    {
+      ps.insert(p);
+    }
+  }
+  return parents;
+}
+
+TestLsBv::ParentsMap
 TestLsBv::get_expected_parents()
 {
-  LocalSearchBV::ParentsMap parents;
+  ParentsMap parents;
   std::vector<uint64_t> to_visit = {d_root1, d_root2};
   while (!to_visit.empty())
   {
@@ -588,8 +609,8 @@ TEST_F(TestLsBv, parents)
   d_ls->register_root(d_root1);
   d_ls->register_root(d_root2);
 
-  const LocalSearchBV::ParentsMap& parents   = get_parents();
-  LocalSearchBV::ParentsMap parents_expected = get_expected_parents();
+  ParentsMap parents          = get_parents();
+  ParentsMap parents_expected = get_expected_parents();
 
   {
     const std::unordered_set<uint64_t>& p  = parents.at(d_c1);
@@ -718,6 +739,41 @@ TEST_F(TestLsBv, parents)
   }
 }
 
+TEST_F(TestLsBv, parents_incremental)
+{
+  d_ls->register_root(d_root1);
+  d_ls->register_root(d_root2);
+  // Build the parents adjacency array, nodes created afterwards are appended.
+  get_parents();
+  ASSERT_FALSE(d_ls->d_parents_dirty);
+
+  // v1 has parents that are not at the end of the adjacency array.
+  uint64_t v1pv1 = d_ls->mk_node(NodeKind::BV_ADD, TEST_BW, {d_v1, d_v1});
+  uint64_t v1mv1 = d_ls->mk_node(NodeKind::BV_MUL, TEST_BW, {d_v1, v1pv1});
+  uint64_t v1av1 = d_ls->mk_node(NodeKind::BV_AND, TEST_BW, {v1mv1, d_v1});
+  uint64_t v4    = d_ls->mk_node(NodeKind::CONST, TEST_BW);
+  uint64_t v4pv1 = d_ls->mk_node(NodeKind::BV_ADD, TEST_BW, {v4, d_v1});
+  uint64_t v4mv4 = d_ls->mk_node(NodeKind::BV_MUL, TEST_BW, {v4, v4});
+  uint64_t root3 = d_ls->mk_node(NodeKind::EQ, 1, {v1av1, v4pv1});
+  uint64_t root4 = d_ls->mk_node(NodeKind::BV_ULT, 1, {v4mv4, d_v1pc1});
+  d_ls->register_root(root3);
+  d_ls->register_root(root4);
+  ASSERT_FALSE(d_ls->d_parents_dirty);
+
+  ParentsMap parents           = get_parents();
+  std::vector<uint32_t> levels = d_ls->d_levels;
+  size_t num_cone_levels       = d_ls->d_cone_buckets.size();
+  ASSERT_EQ(parents.at(d_v1).size(), 8);
+  ASSERT_EQ(parents.at(v4).size(), 2);
+  ASSERT_EQ(levels[root3], 4);
+
+  d_ls->invalidate_parents();
+  ASSERT_EQ(get_parents(), parents);
+  ASSERT_EQ(d_ls->d_levels, levels);
+  ASSERT_EQ(d_ls->d_cone_buckets.size(), num_cone_levels);
+  ASSERT_EQ(d_ls->d_cone_queued.size(), d_ls->d_nodes.size());
+}
+
 TEST_F(TestLsBv, update_cone)
 {
   std::map<uint32_t, BitVector> ass_init = {
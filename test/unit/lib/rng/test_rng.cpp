@@ -0,0 +1,75 @@
+/***
+ * Bitwuzla: Satisfiability Modulo Theories (SMT) solver.
+ *
+ * Copyright (C) 2024 by the authors listed in the AUTHORS file at
+ * https://github.com/bitwuzla/bitwuzla/blob/main/AUTHORS
+ *
+ * This file is part of Bitwuzla under the MIT license. See COPYING for more
+ * information at https://github.com/bitwuzla/bitwuzla/blob/main/COPYING
+ */
+
+#include <unordered_set>
+
+#include "rng/rng.h"
+#include "test_lib.h"
+
+namespace bzla::test {
+
+class TestRng : public TestCommon
+{
+};
+
+TEST_F(TestRng, indexed_set)
+{
+  IndexedSet<uint64_t> set;
+  ASSERT_TRUE(set.empty());
+  ASSERT_TRUE(set.insert(1));
+  ASSERT_TRUE(set.insert(2));
+  ASSERT_TRUE(set.insert(3));
+  ASSERT_FALSE(set.insert(2));
+  ASSERT_EQ(set.size(), 3u);
+  ASSERT_TRUE(set.contains(1));
+  ASSERT_TRUE(set.contains(2));
+  ASSERT_TRUE(set.contains(3));
+  ASSERT_FALSE(set.contains(4));
+
+  ASSERT_TRUE(set.erase(1));
+  ASSERT_FALSE(set.erase(1));
+  ASSERT_FALSE(set.contains(1));
+  ASSERT_EQ(set.size(), 2u);
+  ASSERT_EQ(std::unordered_set<uint64_t>(set.begin(), set.end()),
+            std::unordered_set<uint64_t>({2, 3}));
+
+  ASSERT_TRUE(set.erase(3));
+  ASSERT_TRUE(set.erase(2));
+  ASSERT_TRUE(set.empty());
+  ASSERT_TRUE(set.insert(3));
+  ASSERT_TRUE(set.contains(3));
+  set.clear();
+  ASSERT_TRUE(set.empty());
+  ASSERT_FALSE(set.contains(3));
+}
+
+TEST_F(TestRng, pick_from_indexed_set)
+{
+  RNG rng(1234);
+  IndexedSet<uint64_t> set;
+  for (uint64_t i = 0; i < 100; ++i)
+  {
+    set.insert(i);
+  }
+  for (uint64_t i = 0; i < 100; i += 2)
+  {
+    set.erase(i);
+  }
+  std::unordered_set<uint64_t> picked;
+  for (uint32_t i = 0; i < 10000; ++i)
+  {
+    uint64_t p = rng.pick_from_set<IndexedSet<uint64_t>, uint64_t>(set);
+    ASSERT_TRUE(p % 2 == 1);
+    picked.insert(p);
+  }
+  ASSERT_EQ(picked.size(), set.size());
+}
+
+}  // namespace bzla::test
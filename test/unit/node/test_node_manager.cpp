@@ -8,6 +8,8 @@
  * information at https://github.com/bitwuzla/bitwuzla/blob/main/COPYING
  */
 
+#include <thread>
+
 #include "bv/bitvector.h"
 #include "node/node.h"
 #include "node/node_manager.h"
@@ -230,6 +232,179 @@ TEST_F(TestNodeManager, mk_apply)
   ASSERT_DEATH_DEBUG(nm.mk_node(Kind::APPLY, {fun, bool_const}), "");
 }
 
+TEST_F(TestNodeManager, gc_reuse)
+{
+  NodeManager nm;
+
+  Type bv_type = nm.mk_bv_type(32);
+  Node x       = nm.mk_const(bv_type, "x");
+  Node y       = nm.mk_var(bv_type, "y");
+
+  const auto& stats = nm.allocator_statistics();
+  for (size_t k = 0; k < 3; ++k)
+  {
+    std::vector<Node> nodes;
+    Node cur = x;
+    for (size_t i = 0; i < 100000; ++i)
+    {
+      cur = nm.mk_node(Kind::BV_ADD,
+                       {cur, nm.mk_value(BitVector::from_ui(32, i))});
+      nodes.push_back(nm.mk_node(Kind::BV_EXTRACT, {cur}, {15, 0}));
+      nodes.push_back(nm.mk_const(bv_type));
+    }
+    // n-ary node that does not fit into any slab size class
+    std::vector<Node> children(100, y);
+    children[0] = nm.mk_const(nm.mk_fun_type(
+        std::vector<Type>(children.size(), bv_type)));
+    nodes.push_back(nm.mk_node(Kind::APPLY, children));
+    ASSERT_EQ(stats.d_num_large, 1);
+    ASSERT_EQ(nodes.back().num_children(), 100);
+    ASSERT_EQ(nodes.back()[99], y);
+    if (k == 0)
+    {
+      ASSERT_EQ(stats.d_num_reused, 0);
+    }
+  }
+  ASSERT_EQ(stats.d_num_large, 0);
+  ASSERT_GT(stats.d_num_reused, 0);
+  ASSERT_EQ(nm.statistics().d_num_node_data, 2);
+  ASSERT_EQ(x.symbol()->get(), "x");
+  ASSERT_EQ(y.symbol()->get(), "y");
+}
+
+TEST_F(TestNodeManager, unique_table)
+{
+  NodeManager nm;
+
+  Type bv_type = nm.mk_bv_type(8);
+  Node x       = nm.mk_const(bv_type);
+  std::vector<Node> keep;
+  for (size_t k = 0; k < 4; ++k)
+  {
+    std::vector<Node> drop;
+    for (uint64_t i = 0; i < 20000; ++i)
+    {
+      Node n = nm.mk_node(Kind::BV_MUL,
+                          {x, nm.mk_value(BitVector::from_ui(8, i % 256))});
+      n      = nm.mk_node(Kind::BV_ROLI, {n}, {i});
+      if (i % 2 == 0)
+      {
+        keep.push_back(n);
+      }
+      else
+      {
+        drop.push_back(n);
+      }
+    }
+  }
+  size_t size = nm.d_unique_table.size();
+  for (uint64_t i = 0; i < 20000; i += 2)
+  {
+    Node n = nm.mk_node(Kind::BV_MUL,
+                        {x, nm.mk_value(BitVector::from_ui(8, i % 256))});
+    ASSERT_EQ(nm.mk_node(Kind::BV_ROLI, {n}, {i}), keep[i / 2]);
+  }
+  ASSERT_EQ(nm.d_unique_table.size(), size);
+}
+
+TEST_F(TestNodeManager, concurrent)
+{
+  NodeManager nm;
+
+  Type bv_type         = nm.mk_bv_type(16);
+  Node x               = nm.mk_const(bv_type);
+  Node y               = nm.mk_const(bv_type);
+  Node keep            = nm.mk_node(Kind::BV_ADD, {x, y});
+  size_t num_node_data = nm.statistics().d_num_node_data;
+
+  nm.enable_concurrency();
+  ASSERT_TRUE(nm.is_concurrent());
+  ASSERT_EQ(nm.mk_node(Kind::BV_ADD, {x, y}), keep);
+
+  size_t num_threads = 4;
+  std::vector<Node> roots(num_threads);
+  std::vector<std::thread> threads;
+  for (size_t t = 0; t < num_threads; ++t)
+  {
+    threads.emplace_back([&, t]() {
+      NodeManager::EpochGuard guard(nm);
+      Type type = nm.mk_bv_type(16);
+      Node cur  = nm.mk_node(Kind::BV_ADD, {x, y});
+      for (uint64_t i = 0; i < 20000; ++i)
+      {
+        // Threads t and t + 2 construct the same nodes, all other nodes are
+        // only referenced temporarily.
+        Node v   = nm.mk_value(BitVector::from_ui(16, (i + t % 2) % 32));
+        cur      = nm.mk_node(i % 2 ? Kind::BV_MUL : Kind::BV_XOR, {cur, v});
+        Node tmp = nm.mk_node(Kind::BV_SUB, {cur, nm.mk_const(type)});
+        ASSERT_EQ(tmp[0], cur);
+      }
+      roots[t] = cur;
+    });
+  }
+  for (auto& t : threads)
+  {
+    t.join();
+  }
+  ASSERT_EQ(roots[0], roots[2]);
+  ASSERT_EQ(roots[1], roots[3]);
+  ASSERT_NE(roots[0], roots[1]);
+  roots.clear();
+  {
+    // Leaving the last epoch reclaims all retired node data.
+    NodeManager::EpochGuard guard(nm);
+  }
+  ASSERT_EQ(nm.statistics().d_num_node_data, num_node_data);
+  ASSERT_EQ(nm.mk_node(Kind::BV_ADD, {x, y}), keep);
+}
+
+TEST_F(TestNodeManager, concurrent_disable)
+{
+  NodeManager nm;
+
+  Type bv_type         = nm.mk_bv_type(16);
+  Node x               = nm.mk_const(bv_type);
+  Node y               = nm.mk_const(bv_type);
+  size_t num_node_data = nm.statistics().d_num_node_data;
+
+  nm.enable_concurrency();
+  size_t num_threads = 4;
+  std::vector<Node> roots(num_threads);
+  std::vector<std::thread> threads;
+  for (size_t t = 0; t < num_threads; ++t)
+  {
+    threads.emplace_back([&, t]() {
+      NodeManager::EpochGuard guard(nm);
+      Node cur = nm.mk_node(Kind::BV_ADD, {x, y});
+      for (uint64_t i = 0; i < 1000; ++i)
+      {
+        Node v = nm.mk_value(BitVector::from_ui(16, (i + t) % 32));
+        cur    = nm.mk_node(i % 2 ? Kind::BV_MUL : Kind::BV_XOR, {cur, v});
+      }
+      roots[t] = cur;
+    });
+  }
+  for (auto& t : threads)
+  {
+    t.join();
+  }
+
+  nm.disable_concurrency();
+  ASSERT_FALSE(nm.is_concurrent());
+  ASSERT_FALSE(nm.tm()->is_concurrent());
+  ASSERT_TRUE(nm.d_shards.empty());
+  ASSERT_FALSE(roots[0].d_data->d_concurrent);
+  // Node data created by the threads is hash consed in the single table.
+  for (const Node& root : roots)
+  {
+    Node value = nm.mk_value(root[1].value<BitVector>());
+    ASSERT_EQ(nm.mk_node(root.kind(), {root[0], value}), root);
+  }
+  // Node data is garbage collected immediately again.
+  roots.clear();
+  ASSERT_EQ(nm.statistics().d_num_node_data, num_node_data);
+}
+
 TEST_F(TestNodeManager, check_type)
 {
   NodeManager nm;
@@ -0,0 +1,263 @@
+/***
+ * Bitwuzla: Satisfiability Modulo Theories (SMT) solver.
+ *
+ * Copyright (C) 2023 by the authors listed in the AUTHORS file at
+ * https://github.com/bitwuzla/bitwuzla/blob/main/AUTHORS
+ *
+ * This file is part of Bitwuzla under the MIT license. See COPYING for more
+ * information at https://github.com/bitwuzla/bitwuzla/blob/main/COPYING
+ */
+
+#include <sstream>
+
+#include "backtrack/assertion_stack.h"
+#include "bv/bitvector.h"
+#include "node/node_manager.h"
+#include "parser/binary/reader.h"
+#include "printer/binary_printer.h"
+#include "printer/printer.h"
+#include "solver/fp/floating_point.h"
+#include "solver/fp/rounding_mode.h"
+#include "test/unit/test.h"
+
+namespace bzla::test {
+
+using namespace node;
+
+class TestBinaryPrinter : public TestCommon
+{
+ protected:
+  /**
+   * Print given terms in the binary format, read them back into a fresh node
+   * manager and check that the result prints the same in SMT-LIB format.
+   */
+  void test_roundtrip(const std::vector<Node>& terms)
+  {
+    std::stringstream bs;
+    BinaryPrinter::print(bs, terms);
+
+    NodeManager nm;
+    parser::binary::Reader reader(nm, bs);
+    ASSERT_TRUE(reader.read()) << reader.error_msg();
+    ASSERT_EQ(reader.roots().size(), terms.size());
+    for (size_t i = 0, n = terms.size(); i < n; ++i)
+    {
+      std::stringstream expected, actual;
+      Printer::print(expected, terms[i]);
+      Printer::print(actual, reader.roots()[i]);
+      ASSERT_EQ(actual.str(), expected.str());
+      ASSERT_EQ(reader.levels()[i], 0);
+    }
+  }
+
+  /** Read given bytes and check that reading fails with given message. */
+  void test_error(const std::string& bytes, const std::string& error)
+  {
+    std::stringstream bs(bytes);
+    NodeManager nm;
+    parser::binary::Reader reader(nm, bs);
+    ASSERT_FALSE(reader.read());
+    ASSERT_EQ(reader.error_msg(), error);
+  }
+
+  /** @return The binary representation of given terms. */
+  std::string print(const std::vector<Node>& terms)
+  {
+    std::stringstream bs;
+    BinaryPrinter::print(bs, terms);
+    return bs.str();
+  }
+
+  NodeManager d_nm;
+};
+
+TEST_F(TestBinaryPrinter, roundtrip_bool)
+{
+  Type bool_type = d_nm.mk_bool_type();
+  Node a         = d_nm.mk_const(bool_type, "a");
+  Node b         = d_nm.mk_const(bool_type, "b");
+  test_roundtrip({a,
+                  d_nm.mk_value(true),
+                  d_nm.mk_node(Kind::AND, {a, d_nm.mk_node(Kind::NOT, {b})}),
+                  d_nm.mk_node(Kind::ITE, {a, b, d_nm.mk_value(false)})});
+}
+
+TEST_F(TestBinaryPrinter, roundtrip_bv)
+{
+  Type bv8    = d_nm.mk_bv_type(8);
+  Type bv100  = d_nm.mk_bv_type(100);
+  Node x      = d_nm.mk_const(bv8, "x");
+  Node y      = d_nm.mk_const(bv100, "y");
+  Node ones   = d_nm.mk_value(BitVector::from_ui(8, 255));
+  Node big    = d_nm.mk_value(BitVector::from_ui(100, 0xdeadbeefcafebabe)
+                                 .bvshl(BitVector::from_ui(100, 36))
+                                 .bvnot());
+  test_roundtrip({d_nm.mk_node(Kind::EQUAL,
+                               {d_nm.mk_node(Kind::BV_ADD, {x, ones}),
+                                d_nm.mk_node(Kind::BV_EXTRACT, {y}, {7, 0})}),
+                  d_nm.mk_node(Kind::BV_ULT, {y, big}),
+                  d_nm.mk_node(Kind::BV_SIGN_EXTEND, {x}, {92}),
+                  big});
+}
+
+TEST_F(TestBinaryPrinter, roundtrip_shared)
+{
+  Type bv32 = d_nm.mk_bv_type(32);
+  Node x    = d_nm.mk_const(bv32, "x");
+  Node t    = x;
+  for (size_t i = 0; i < 1000; ++i)
+  {
+    t = d_nm.mk_node(Kind::BV_MUL, {t, t});
+  }
+  test_roundtrip({t});
+  // Shared subterms are stored once, hence the size grows linearly.
+  ASSERT_LT(print({t}).size(), 8000);
+}
+
+TEST_F(TestBinaryPrinter, roundtrip_array)
+{
+  Type bv8   = d_nm.mk_bv_type(8);
+  Type bv32  = d_nm.mk_bv_type(32);
+  Type array = d_nm.mk_array_type(bv32, bv8);
+  Node a     = d_nm.mk_const(array, "a");
+  Node i     = d_nm.mk_const(bv32, "i");
+  Node e     = d_nm.mk_const(bv8, "e");
+  Node ten   = d_nm.mk_value(BitVector::from_ui(8, 10));
+  Node ca    = d_nm.mk_const_array(array, ten);
+  test_roundtrip(
+      {d_nm.mk_node(Kind::EQUAL, {d_nm.mk_node(Kind::STORE, {a, i, e}), ca}),
+       d_nm.mk_node(Kind::SELECT, {ca, i})});
+}
+
+TEST_F(TestBinaryPrinter, roundtrip_fun)
+{
+  Type bool_type = d_nm.mk_bool_type();
+  Type bv8       = d_nm.mk_bv_type(8);
+  Type fun       = d_nm.mk_fun_type({bv8, bv8, bool_type});
+  Node f         = d_nm.mk_const(fun, "f");
+  Node x         = d_nm.mk_const(bv8, "x");
+  Node v         = d_nm.mk_var(bv8, "v");
+  Node w         = d_nm.mk_var(bv8, "w");
+  Node lambda    = d_nm.mk_node(
+      Kind::LAMBDA,
+      {v, d_nm.mk_node(Kind::LAMBDA, {w, d_nm.mk_node(Kind::BV_ULT, {v, w})})});
+  test_roundtrip(
+      {d_nm.mk_node(Kind::APPLY, {f, x, x}),
+       d_nm.mk_node(Kind::APPLY, {lambda, x, x}),
+       d_nm.mk_node(Kind::FORALL,
+                    {v, d_nm.mk_node(Kind::APPLY, {f, v, x})})});
+}
+
+TEST_F(TestBinaryPrinter, roundtrip_fp)
+{
+  Type fp16 = d_nm.mk_fp_type(5, 11);
+  Type fp64 = d_nm.mk_fp_type(11, 53);
+  Type rm   = d_nm.mk_rm_type();
+  Node x    = d_nm.mk_const(fp16, "x");
+  Node y    = d_nm.mk_const(fp64, "y");
+  Node r    = d_nm.mk_const(rm, "r");
+  Node v16  = d_nm.mk_value(
+      FloatingPoint(fp16, BitVector::from_ui(16, 0xbc00)));
+  Node v64  = d_nm.mk_value(
+      FloatingPoint(fp64, BitVector::from_ui(64, 0x400921fb54442d18)));
+  test_roundtrip(
+      {d_nm.mk_node(Kind::FP_LEQ,
+                    {d_nm.mk_node(Kind::FP_ADD, {r, x, v16}),
+                     d_nm.mk_node(Kind::FP_TO_FP_FROM_FP,
+                                  {d_nm.mk_value(RoundingMode::RTZ), y},
+                                  {5, 11})}),
+       d_nm.mk_node(Kind::FP_IS_NAN, {v64}),
+       d_nm.mk_value(FloatingPoint::fpnan(fp16)),
+       d_nm.mk_value(FloatingPoint::fpinf(fp64, true)),
+       d_nm.mk_value(FloatingPoint::fpzero(fp16, true))});
+}
+
+TEST_F(TestBinaryPrinter, roundtrip_rm)
+{
+  std::vector<Node> values;
+  for (uint64_t i = 0; i < static_cast<uint64_t>(RoundingMode::NUM_RM); ++i)
+  {
+    values.push_back(d_nm.mk_value(static_cast<RoundingMode>(i)));
+  }
+  Node r = d_nm.mk_const(d_nm.mk_rm_type(), "r");
+  values.push_back(d_nm.mk_node(Kind::EQUAL, {r, values[0]}));
+  test_roundtrip(values);
+}
+
+TEST_F(TestBinaryPrinter, roundtrip_uninterpreted)
+{
+  Type u = d_nm.mk_uninterpreted_type("U");
+  Node a = d_nm.mk_const(u, "a");
+  Node b = d_nm.mk_const(u);
+  test_roundtrip({d_nm.mk_node(Kind::DISTINCT, {a, b})});
+}
+
+TEST_F(TestBinaryPrinter, roundtrip_empty) { test_roundtrip({}); }
+
+TEST_F(TestBinaryPrinter, print_formula)
+{
+  Type bool_type = d_nm.mk_bool_type();
+  Node a         = d_nm.mk_const(bool_type, "a");
+  Node b         = d_nm.mk_const(bool_type, "b");
+  Node c         = d_nm.mk_const(bool_type, "c");
+
+  backtrack::AssertionStack as;
+  as.push_back(a);
+  as.push();
+  as.push_back(b);
+  as.push();
+  as.push();
+  as.push_back(c);
+
+  std::stringstream bs;
+  BinaryPrinter::print_formula(bs, as.view());
+
+  NodeManager nm;
+  parser::binary::Reader reader(nm, bs);
+  ASSERT_TRUE(reader.read()) << reader.error_msg();
+  ASSERT_EQ(reader.roots().size(), 3);
+  // Scopes without assertions are not stored.
+  ASSERT_EQ(reader.levels(), std::vector<uint64_t>({0, 1, 2}));
+  ASSERT_EQ(reader.roots()[0].symbol()->get(), "a");
+  ASSERT_EQ(reader.roots()[1].symbol()->get(), "b");
+  ASSERT_EQ(reader.roots()[2].symbol()->get(), "c");
+}
+
+TEST_F(TestBinaryPrinter, read_errors)
+{
+  std::string bytes =
+      print({d_nm.mk_node(Kind::NOT, {d_nm.mk_const(d_nm.mk_bool_type())})});
+
+  test_error("", "byte 0: unexpected end of input");
+  test_error("BZLA" + bytes.substr(4),
+             "byte 4: invalid binary input, missing magic bytes 'BZLB'");
+  test_error("BZLB\x7f", "byte 5: unsupported binary format version 127, "
+                         "expected 1");
+  test_error(bytes.substr(0, bytes.size() - 1),
+             "byte " + std::to_string(bytes.size() - 1)
+                 + ": unexpected end of input");
+  test_error(bytes + '\0',
+             "byte " + std::to_string(bytes.size())
+                 + ": unexpected data after end of input");
+  // Root id out of range.
+  std::string invalid_root = bytes;
+  invalid_root[invalid_root.size() - 2] = 5;
+  test_error(invalid_root,
+             "byte " + std::to_string(bytes.size()) + ": invalid node id 5");
+  // Assertion level exceeds the number of roots.
+  std::string invalid_level = bytes;
+  invalid_level[invalid_level.size() - 1] = 2;
+  test_error(invalid_level,
+             "byte " + std::to_string(bytes.size())
+                 + ": invalid assertion level 2");
+  // Integers with more than 64 bits.
+  test_error("BZLB\xff\xff\xff\xff\xff\xff\xff\xff\xff\x01",
+             "byte 14: unsupported binary format version "
+                 + std::to_string(UINT64_MAX) + ", expected 1");
+  test_error("BZLB\xff\xff\xff\xff\xff\xff\xff\xff\xff\x02",
+             "byte 14: integer exceeds 64 bits");
+  test_error("BZLB\xff\xff\xff\xff\xff\xff\xff\xff\xff\x81\x00",
+             "byte 14: integer exceeds 64 bits");
+}
+
+}  // namespace bzla::test
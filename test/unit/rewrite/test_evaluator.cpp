@@ -0,0 +1,176 @@
+/***
+ * Bitwuzla: Satisfiability Modulo Theories (SMT) solver.
+ *
+ * Copyright (C) 2023 by the authors listed in the AUTHORS file at
+ * https://github.com/bitwuzla/bitwuzla/blob/main/AUTHORS
+ *
+ * This file is part of Bitwuzla under the MIT license. See COPYING for more
+ * information at https://github.com/bitwuzla/bitwuzla/blob/main/COPYING
+ */
+
+#include "bv/bitvector.h"
+#include "node/node_manager.h"
+#include "rewrite/evaluator.h"
+#include "rng/rng.h"
+#include "test/unit/test.h"
+
+namespace bzla::test {
+
+using namespace node;
+
+class TestEvaluator : public TestCommon
+{
+ protected:
+  /** Evaluate binary operator on given bit-vectors. */
+  BitVector eval(Kind kind, const BitVector& a, const BitVector& b)
+  {
+    Node res =
+        Evaluator::evaluate(d_nm, kind, {d_nm.mk_value(a), d_nm.mk_value(b)});
+    if (res.type().is_bool())
+    {
+      return res.value<bool>() ? BitVector::mk_true() : BitVector::mk_false();
+    }
+    return res.value<BitVector>();
+  }
+
+  /** SMT-LIB semantics of bvsmod. */
+  static BitVector smod(const BitVector& a, const BitVector& b)
+  {
+    bool neg_a  = a.msb();
+    bool neg_b  = b.msb();
+    BitVector u = (neg_a ? a.bvneg() : a).bvurem(neg_b ? b.bvneg() : b);
+    if (u.is_zero() || neg_a == neg_b)
+    {
+      return neg_a ? u.bvneg() : u;
+    }
+    return neg_a ? u.bvneg().bvadd(b) : u.bvadd(b);
+  }
+
+  NodeManager d_nm;
+  RNG d_rng{42};
+};
+
+TEST_F(TestEvaluator, binary)
+{
+  for (uint64_t size : {1, 7, 32, 63, 64, 65, 100})
+  {
+    for (size_t i = 0; i < 100; ++i)
+    {
+      BitVector a(size, d_rng);
+      BitVector b(size, d_rng);
+      // Exercise special cases of division and shifts.
+      if (i % 10 == 0)
+      {
+        b = BitVector::mk_zero(size);
+      }
+      else if (i % 10 == 1)
+      {
+        a = BitVector::mk_min_signed(size);
+        b = BitVector::mk_ones(size);
+      }
+      else if (i % 10 == 2)
+      {
+        b = BitVector::from_ui(size, i % size);
+      }
+      ASSERT_EQ(eval(Kind::BV_ADD, a, b), a.bvadd(b));
+      ASSERT_EQ(eval(Kind::BV_SUB, a, b), a.bvsub(b));
+      ASSERT_EQ(eval(Kind::BV_MUL, a, b), a.bvmul(b));
+      ASSERT_EQ(eval(Kind::BV_UDIV, a, b), a.bvudiv(b));
+      ASSERT_EQ(eval(Kind::BV_UREM, a, b), a.bvurem(b));
+      ASSERT_EQ(eval(Kind::BV_SDIV, a, b), a.bvsdiv(b));
+      ASSERT_EQ(eval(Kind::BV_SREM, a, b), a.bvsrem(b));
+      ASSERT_EQ(eval(Kind::BV_SMOD, a, b), smod(a, b));
+      ASSERT_EQ(eval(Kind::BV_SHL, a, b), a.bvshl(b));
+      ASSERT_EQ(eval(Kind::BV_SHR, a, b), a.bvshr(b));
+      ASSERT_EQ(eval(Kind::BV_ASHR, a, b), a.bvashr(b));
+      ASSERT_EQ(eval(Kind::BV_XOR, a, b), a.bvxor(b));
+      ASSERT_EQ(eval(Kind::BV_ULT, a, b), a.bvult(b));
+      ASSERT_EQ(eval(Kind::BV_SLE, a, b), a.bvsle(b));
+      ASSERT_EQ(eval(Kind::BV_COMP, a, b), a.bveq(b));
+      ASSERT_EQ(eval(Kind::BV_CONCAT, a, b), a.bvconcat(b));
+      ASSERT_EQ(eval(Kind::BV_UADDO, a, b),
+                BitVector::from_ui(1, a.is_uadd_overflow(b)));
+      ASSERT_EQ(eval(Kind::BV_UMULO, a, b),
+                BitVector::from_ui(1, a.is_umul_overflow(b)));
+    }
+  }
+}
+
+TEST_F(TestEvaluator, indexed)
+{
+  for (uint64_t size : {8, 72})
+  {
+    BitVector a = BitVector::mk_one(size).bvshl(size - 1).bvinc();
+    Node va     = d_nm.mk_value(a);
+    for (uint64_t n : {uint64_t(0), uint64_t(1), size - 1})
+    {
+      BitVector rol = a.bvshl(n).bvor(a.bvshr(size - n));
+      Node vn       = d_nm.mk_value(BitVector::from_ui(size, n));
+      ASSERT_EQ(Evaluator::evaluate(d_nm, Kind::BV_ROLI, {va}, {n}),
+                d_nm.mk_value(rol));
+      ASSERT_EQ(Evaluator::evaluate(d_nm, Kind::BV_RORI, {va}, {size - n}),
+                d_nm.mk_value(rol));
+      ASSERT_EQ(Evaluator::evaluate(d_nm, Kind::BV_ROL, {va, vn}),
+                d_nm.mk_value(rol));
+    }
+    ASSERT_EQ(Evaluator::evaluate(d_nm, Kind::BV_SIGN_EXTEND, {va}, {8}),
+              d_nm.mk_value(a.bvsext(8)));
+    ASSERT_EQ(Evaluator::evaluate(d_nm, Kind::BV_EXTRACT, {va}, {size - 1, 1}),
+              d_nm.mk_value(a.bvextract(size - 1, 1)));
+  }
+}
+
+TEST_F(TestEvaluator, overflow)
+{
+  BitVector max8 = BitVector::mk_max_signed(8);
+  BitVector min8 = BitVector::mk_min_signed(8);
+  BitVector one8 = BitVector::mk_one(8);
+  BitVector neg8 = BitVector::mk_ones(8);
+  ASSERT_TRUE(eval(Kind::BV_SADDO, max8, one8).is_true());
+  ASSERT_FALSE(eval(Kind::BV_SADDO, max8, neg8).is_true());
+  ASSERT_TRUE(eval(Kind::BV_SSUBO, min8, one8).is_true());
+  ASSERT_TRUE(eval(Kind::BV_SDIVO, min8, neg8).is_true());
+  ASSERT_FALSE(eval(Kind::BV_SDIVO, max8, neg8).is_true());
+  ASSERT_TRUE(eval(Kind::BV_SMULO, min8, neg8).is_true());
+  ASSERT_TRUE(eval(Kind::BV_USUBO, one8, neg8).is_true());
+
+  BitVector max64 = BitVector::mk_max_signed(64);
+  BitVector one64 = BitVector::mk_one(64);
+  ASSERT_TRUE(eval(Kind::BV_SADDO, max64, one64).is_true());
+  ASSERT_TRUE(eval(Kind::BV_SMULO, max64, max64).is_true());
+  ASSERT_FALSE(eval(Kind::BV_SMULO, max64, one64).is_true());
+}
+
+TEST_F(TestEvaluator, model)
+{
+  Type bv8  = d_nm.mk_bv_type(8);
+  Type bv80 = d_nm.mk_bv_type(80);
+  Node x    = d_nm.mk_const(bv8, "x");
+  Node y    = d_nm.mk_const(bv80, "y");
+  Node p    = d_nm.mk_const(d_nm.mk_bool_type(), "p");
+
+  // (and p (= (bvadd x x) ((_ extract 7 0) (bvmul y y))))
+  Node add  = d_nm.mk_node(Kind::BV_ADD, {x, x});
+  Node mul  = d_nm.mk_node(Kind::BV_MUL, {y, y});
+  Node ext  = d_nm.mk_node(Kind::BV_EXTRACT, {mul}, {7, 0});
+  Node eq   = d_nm.mk_node(Kind::EQUAL, {add, ext});
+  Node term = d_nm.mk_node(Kind::AND, {p, eq});
+
+  std::unordered_map<Node, Node> model{
+      {x, d_nm.mk_value(BitVector::from_ui(8, 2))},
+      {y, d_nm.mk_value(BitVector::from_ui(80, 2))},
+      {p, d_nm.mk_value(true)}};
+  ASSERT_EQ(Evaluator::evaluate(d_nm, term, model), d_nm.mk_value(true));
+  model[x] = d_nm.mk_value(BitVector::from_ui(8, 3));
+  ASSERT_EQ(Evaluator::evaluate(d_nm, term, model), d_nm.mk_value(false));
+
+  // Unsupported terms and missing constants.
+  model.erase(y);
+  ASSERT_TRUE(Evaluator::evaluate(d_nm, term, model).is_null());
+  Node a = d_nm.mk_const(d_nm.mk_array_type(bv8, bv8), "a");
+  Node sel =
+      d_nm.mk_node(Kind::EQUAL, {d_nm.mk_node(Kind::SELECT, {a, x}), x});
+  ASSERT_TRUE(Evaluator::evaluate(d_nm, sel, model).is_null());
+}
+
+}  // namespace bzla::test
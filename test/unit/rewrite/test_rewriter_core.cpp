@@ -1147,5 +1147,56 @@ TEST_F(TestRewriterCore, core_distinct_elim)
   test_elim_rule_core(Kind::DISTINCT, d_bool_type);
 }
 
+/* rewriter ----------------------------------------------------------------- */
+
+TEST_F(TestRewriterCore, rewrite_cache_size)
+{
+  option::Options options;
+  options.set(option::Option::REWRITE_CACHE_SIZE, uint64_t(8));
+  Env env(d_nm, options);
+  Rewriter& rewriter = env.rewriter();
+
+  std::vector<Node> terms;
+  Node t = d_bv4_a;
+  for (size_t i = 0; i < 50; ++i)
+  {
+    t = d_nm.mk_node(Kind::BV_ADD,
+                     {d_nm.mk_node(Kind::BV_NOT, {t}),
+                      i % 2 ? d_bv4_one : d_bv4_b});
+    terms.push_back(t);
+  }
+  for (size_t k = 0; k < 3; ++k)
+  {
+    for (const Node& term : terms)
+    {
+      ASSERT_EQ(d_rewriter.rewrite(term), rewriter.rewrite(term));
+    }
+  }
+}
+
+TEST_F(TestRewriterCore, rewrite_deep)
+{
+  // bvnot is pushed into concats with a value child by rewriting the bvnot
+  // of the other child, which yields a chain of 2500 nested rewrites.
+  Node t = d_bv4_a;
+  for (size_t i = 0; i < 2500; ++i)
+  {
+    t = d_nm.mk_node(
+        Kind::BV_CONCAT,
+        {d_bv1_zero, d_nm.mk_node(Kind::BV_CONCAT, {t, d_bv1_zero})});
+  }
+  Node res = d_rewriter.rewrite(d_nm.mk_node(Kind::BV_NOT, {t}));
+  ASSERT_EQ(res, d_rewriter.rewrite(res));
+  for (size_t i = 0; i < 2500; ++i)
+  {
+    ASSERT_EQ(res.kind(), Kind::BV_CONCAT);
+    ASSERT_EQ(res[0], d_bv1_one);
+    ASSERT_EQ(res[1].kind(), Kind::BV_CONCAT);
+    ASSERT_EQ(res[1][1], d_bv1_one);
+    res = res[1][0];
+  }
+  ASSERT_EQ(res, d_nm.mk_node(Kind::BV_NOT, {d_bv4_a}));
+}
+
 /* -------------------------------------------------------------------------- */
 }  // namespace bzla::test
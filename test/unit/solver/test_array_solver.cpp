@@ -0,0 +1,182 @@
+/***
+ * Bitwuzla: Satisfiability Modulo Theories (SMT) solver.
+ *
+ * Copyright (C) 2023 by the authors listed in the AUTHORS file at
+ * https://github.com/bitwuzla/bitwuzla/blob/main/AUTHORS
+ *
+ * This file is part of Bitwuzla under the MIT license. See COPYING for more
+ * information at https://github.com/bitwuzla/bitwuzla/blob/main/COPYING
+ */
+
+#include "node/node_manager.h"
+#include "solving_context.h"
+#include "test/unit/test.h"
+
+namespace bzla::test {
+
+using namespace node;
+
+class TestArraySolver : public TestCommon
+{
+ protected:
+  /**
+   * Check that the current model of `ctx` is consistent for given selects,
+   * i.e., selects with equal index values have equal values.
+   */
+  void check_congruence(SolvingContext& ctx, const std::vector<Node>& selects)
+  {
+    for (size_t i = 0; i < selects.size(); ++i)
+    {
+      for (size_t j = i + 1; j < selects.size(); ++j)
+      {
+        const Node& s1 = selects[i];
+        const Node& s2 = selects[j];
+        if (s1[0] == s2[0] && ctx.get_value(s1[1]) == ctx.get_value(s2[1]))
+        {
+          ASSERT_EQ(ctx.get_value(s1), ctx.get_value(s2));
+        }
+      }
+    }
+  }
+};
+
+TEST_F(TestArraySolver, incremental)
+{
+  NodeManager nm;
+  option::Options options;
+  options.preprocess.set(false);
+  options.produce_models.set(true);
+  SolvingContext ctx(nm, options);
+
+  Type bv    = nm.mk_bv_type(4);
+  Node a     = nm.mk_const(nm.mk_array_type(bv, bv), "a");
+  Node i     = nm.mk_const(bv, "i");
+  Node v     = nm.mk_const(bv, "v");
+  Node store = nm.mk_node(Kind::STORE, {a, i, v});
+
+  std::vector<Node> selects;
+  std::vector<Node> indices;
+  for (size_t k = 0; k < 8; ++k)
+  {
+    indices.push_back(nm.mk_const(bv));
+    selects.push_back(nm.mk_node(Kind::SELECT, {a, indices.back()}));
+    selects.push_back(nm.mk_node(Kind::SELECT, {store, indices.back()}));
+    // Pairwise distinct elements of a.
+    for (size_t l = 0; l + 2 < selects.size(); l += 2)
+    {
+      ctx.assert_formula(
+          nm.mk_node(Kind::DISTINCT, {selects[l], selects[2 * k]}));
+    }
+  }
+  ASSERT_EQ(ctx.solve(), Result::SAT);
+  check_congruence(ctx, selects);
+
+  // Each solve() call only changes a few index values, the accesses with
+  // unchanged values are kept in the array models.
+  for (size_t k = 1; k < indices.size(); ++k)
+  {
+    ctx.push();
+    ctx.assert_formula(nm.mk_node(Kind::EQUAL, {indices[k], indices[k - 1]}));
+    ASSERT_EQ(ctx.solve(), Result::UNSAT);
+    ctx.pop();
+
+    ctx.push();
+    ctx.assert_formula(nm.mk_node(Kind::EQUAL, {indices[k], i}));
+    ASSERT_EQ(ctx.solve(), Result::SAT);
+    ASSERT_EQ(ctx.get_value(selects[2 * k + 1]), ctx.get_value(v));
+    check_congruence(ctx, selects);
+    ctx.pop();
+  }
+}
+
+TEST_F(TestArraySolver, incremental_no_pop)
+{
+  NodeManager nm;
+  option::Options options;
+  options.preprocess.set(false);
+  options.produce_models.set(true);
+  SolvingContext ctx(nm, options);
+
+  Type bv = nm.mk_bv_type(8);
+  Node a  = nm.mk_const(nm.mk_array_type(bv, bv), "a");
+  auto& stats = ctx.env().statistics();
+
+  // Each round adds one access with fixed index and element values. Accesses
+  // of previous rounds stay valid and are not checked again.
+  std::vector<Node> selects;
+  const uint64_t num_rounds = 16;
+  for (uint64_t k = 0; k < num_rounds; ++k)
+  {
+    Node idx = nm.mk_value(BitVector::from_ui(8, k));
+    selects.push_back(nm.mk_node(Kind::SELECT, {a, idx}));
+    ctx.assert_formula(nm.mk_node(
+        Kind::EQUAL, {selects.back(), nm.mk_value(BitVector::from_ui(8, k))}));
+    ASSERT_EQ(ctx.solve(), Result::SAT);
+    check_congruence(ctx, selects);
+    ASSERT_EQ(stats.get().at("solver::array::num_accesses_checked"),
+              std::to_string(k + 1));
+  }
+  ASSERT_EQ(stats.get().at("solver::array::num_accesses_invalidated"), "0");
+
+  // Changing the index value of an access only rechecks that access.
+  Node x  = nm.mk_const(bv, "x");
+  Node ax = nm.mk_node(Kind::SELECT, {a, x});
+  selects.push_back(ax);
+  ctx.assert_formula(nm.mk_node(
+      Kind::EQUAL, {ax, nm.mk_value(BitVector::from_ui(8, num_rounds))}));
+  ASSERT_EQ(ctx.solve(), Result::SAT);
+  check_congruence(ctx, selects);
+  // Accesses are only checked again if they were invalidated, i.e., the
+  // value of x changed between lemma rounds.
+  auto num_checked     = std::stoull(
+      stats.get().at("solver::array::num_accesses_checked"));
+  auto num_invalidated = std::stoull(
+      stats.get().at("solver::array::num_accesses_invalidated"));
+  ASSERT_EQ(num_checked, num_rounds + 1 + num_invalidated);
+
+  ctx.assert_formula(nm.mk_node(Kind::DISTINCT, {x, ctx.get_value(x)}));
+  ASSERT_EQ(ctx.solve(), Result::SAT);
+  check_congruence(ctx, selects);
+  ASSERT_EQ(std::stoull(stats.get().at("solver::array::num_accesses_checked")),
+            num_checked + 1);
+  ASSERT_EQ(
+      std::stoull(stats.get().at("solver::array::num_accesses_invalidated")),
+      num_invalidated + 1);
+}
+
+TEST_F(TestArraySolver, value_changes)
+{
+  NodeManager nm;
+  option::Options options;
+  options.preprocess.set(false);
+  options.produce_models.set(true);
+  SolvingContext ctx(nm, options);
+
+  Type bv  = nm.mk_bv_type(8);
+  Node a   = nm.mk_const(nm.mk_array_type(bv, bv), "a");
+  Node x   = nm.mk_const(bv, "x");
+  Node y   = nm.mk_const(bv, "y");
+  Node p   = nm.mk_const(nm.mk_bool_type(), "p");
+  Node one = nm.mk_value(BitVector::from_ui(8, 1));
+  Node b   = nm.mk_node(Kind::STORE, {a, x, one});
+  Node c   = nm.mk_node(Kind::ITE, {p, a, b});
+  Node cy  = nm.mk_node(Kind::SELECT, {c, y});
+  Node ay  = nm.mk_node(Kind::SELECT, {a, y});
+
+  ctx.assert_formula(nm.mk_node(Kind::DISTINCT, {cy, ay}));
+  ASSERT_EQ(ctx.solve(), Result::SAT);
+  ASSERT_EQ(ctx.get_value(p), nm.mk_value(false));
+  ASSERT_EQ(ctx.get_value(x), ctx.get_value(y));
+  ASSERT_EQ(ctx.get_value(cy), one);
+
+  // Flip the ite condition and the store index of the previous model.
+  ctx.push();
+  ctx.assert_formula(nm.mk_node(Kind::NOT, {p}));
+  ctx.assert_formula(nm.mk_node(Kind::DISTINCT, {x, y}));
+  ASSERT_EQ(ctx.solve(), Result::UNSAT);
+  ctx.pop();
+  ctx.assert_formula(nm.mk_node(Kind::EQUAL, {ay, one}));
+  ASSERT_EQ(ctx.solve(), Result::UNSAT);
+}
+
+}  // namespace bzla::test
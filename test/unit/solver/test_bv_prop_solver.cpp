@@ -414,6 +414,14 @@ TEST_F(TestBvPropSolver, eq) { test_prop(Kind::EQUAL); }
 
 TEST_F(TestBvPropSolver, ite) { test_prop(Kind::ITE); }
 
+TEST_F(TestBvPropSolver, walkers)
+{
+  d_options.prop_walkers.set(4);
+  test_prop(Kind::BV_ADD);
+  test_prop(Kind::BV_MUL);
+  test_prop(Kind::ITE);
+}
+
 /* -------------------------------------------------------------------------- */
 
 }  // namespace bzla::test
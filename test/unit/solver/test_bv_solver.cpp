@@ -8,8 +8,15 @@
  * information at https://github.com/bitwuzla/bitwuzla/blob/main/COPYING
  */
 
+#include <chrono>
+#include <thread>
+
+#include "bv/bitvector.h"
 #include "node/node_manager.h"
+#include "node/node_utils.h"
+#include "rng/rng.h"
 #include "solving_context.h"
+#include "terminator.h"
 #include "test/unit/test.h"
 
 namespace bzla::test {
@@ -19,6 +26,53 @@ using namespace node;
 class TestBvSolver : public TestCommon
 {
  protected:
+  /**
+   * Terminator that is not thread-safe. Records whether it was called on a
+   * thread other than the one it was created on, and terminates after given
+   * time.
+   */
+  class ThreadTerminator : public Terminator
+  {
+   public:
+    ThreadTerminator(std::chrono::milliseconds time)
+        : d_deadline(std::chrono::steady_clock::now() + time)
+    {
+    }
+    bool terminate() override
+    {
+      d_other_thread |= std::this_thread::get_id() != d_thread;
+      return std::chrono::steady_clock::now() >= d_deadline;
+    }
+    /** True if terminate() was called on another thread. */
+    bool d_other_thread = false;
+
+   private:
+    std::thread::id d_thread = std::this_thread::get_id();
+    std::chrono::steady_clock::time_point d_deadline;
+  };
+
+  /**
+   * Assert that x * y is a product of two 32-bit primes for 64-bit constants
+   * x and y, which are not 1. This is hard enough to not be solved before
+   * termination.
+   */
+  void assert_factoring(NodeManager& nm, SolvingContext& ctx)
+  {
+    Type bv32 = nm.mk_bv_type(32);
+    Node one  = nm.mk_value(BitVector::from_ui(32, 1));
+    Node x    = nm.mk_const(bv32);
+    Node y    = nm.mk_const(bv32);
+    ctx.assert_formula(nm.mk_node(Kind::BV_ULT, {one, x}));
+    ctx.assert_formula(nm.mk_node(Kind::BV_ULT, {one, y}));
+    ctx.assert_formula(nm.mk_node(
+        Kind::EQUAL,
+        {nm.mk_node(Kind::BV_MUL,
+                    {nm.mk_node(Kind::BV_ZERO_EXTEND, {x}, {32}),
+                     nm.mk_node(Kind::BV_ZERO_EXTEND, {y}, {32})}),
+         nm.mk_value(BitVector::from_ui(
+             64, uint64_t(3538334777u) * uint64_t(2767054501u)))}));
+  }
+
   option::Options d_options;
 };
 
@@ -211,4 +265,532 @@ TEST_F(TestBvSolver, solve1)
   ASSERT_EQ(ctx.solve(), Result::UNSAT);
 }
 
+TEST_F(TestBvSolver, solve_portfolio)
+{
+  NodeManager nm;
+  d_options.portfolio.set(4);
+  d_options.produce_models.set(true);
+  d_options.produce_unsat_cores.set(true);
+  SolvingContext ctx = SolvingContext(nm, d_options);
+  auto& stats        = ctx.env().statistics();
+
+  // The number of solve() calls answered by a portfolio subsolver.
+  auto num_portfolio_results = [&stats]() {
+    std::string prefix = "solving_context::portfolio::winner::";
+    uint64_t res       = 0;
+    for (const auto& [name, value] : stats.get())
+    {
+      if (name.compare(0, prefix.size(), prefix) == 0)
+      {
+        res += std::stoull(value);
+      }
+    }
+    return res;
+  };
+
+  Type bv8     = nm.mk_bv_type(8);
+  Node x       = nm.mk_const(bv8);
+  Node y       = nm.mk_const(bv8);
+  Node x_mul_y = nm.mk_node(Kind::BV_MUL, {x, y});
+  Node val     = nm.mk_value(BitVector::from_ui(8, 42));
+
+  ctx.assert_formula(nm.mk_node(Kind::EQUAL, {x_mul_y, val}));
+  ASSERT_EQ(ctx.solve(), Result::SAT);
+  ASSERT_EQ(ctx.get_value(x).value<BitVector>().bvmul(
+                ctx.get_value(y).value<BitVector>()),
+            val.value<BitVector>());
+  ASSERT_EQ(num_portfolio_results(), 1);
+
+  ctx.push();
+  Node a0 =
+      nm.mk_node(Kind::BV_ULT, {x, nm.mk_value(BitVector::from_ui(8, 2))});
+  Node a1 =
+      nm.mk_node(Kind::BV_ULT, {y, nm.mk_value(BitVector::from_ui(8, 42))});
+  ctx.assert_formula(a0);
+  ctx.assert_formula(a1);
+  ASSERT_EQ(ctx.solve(), Result::UNSAT);
+  auto core = ctx.get_unsat_core();
+  ASSERT_EQ(core.size(), 3);
+  ASSERT_EQ(num_portfolio_results(), 2);
+  ctx.pop();
+
+  ASSERT_EQ(ctx.solve(), Result::SAT);
+  ASSERT_EQ(num_portfolio_results(), 3);
+
+  // Assertions added without push() are asserted to the existing subsolvers.
+  ctx.assert_formula(nm.mk_node(Kind::BV_ULT, {x, y}));
+  ASSERT_EQ(ctx.solve(), Result::SAT);
+  BitVector x_val = ctx.get_value(x).value<BitVector>();
+  BitVector y_val = ctx.get_value(y).value<BitVector>();
+  ASSERT_EQ(x_val.bvmul(y_val), val.value<BitVector>());
+  ASSERT_TRUE(x_val.compare(y_val) < 0);
+  ASSERT_EQ(num_portfolio_results(), 4);
+
+  // The subsolvers are kept across calls.
+  ASSERT_EQ(stats.get().at("solving_context::portfolio::num_contexts"), "4");
+}
+
+TEST_F(TestBvSolver, solve_portfolio_terminate)
+{
+  NodeManager nm;
+  d_options.portfolio.set(4);
+  SolvingContext ctx = SolvingContext(nm, d_options);
+  ThreadTerminator terminator(std::chrono::milliseconds(100));
+  ctx.env().configure_terminator(&terminator);
+  assert_factoring(nm, ctx);
+  ASSERT_EQ(ctx.solve(), Result::UNKNOWN);
+  ASSERT_FALSE(terminator.d_other_thread);
+}
+
+TEST_F(TestBvSolver, solve_cubes)
+{
+  NodeManager nm;
+  d_options.bv_cube_threads.set(4);
+  d_options.bv_cube_depth.set(3);
+  d_options.produce_models.set(true);
+  d_options.produce_unsat_cores.set(true);
+  SolvingContext ctx = SolvingContext(nm, d_options);
+
+  Type bv8     = nm.mk_bv_type(8);
+  Node x       = nm.mk_const(bv8);
+  Node y       = nm.mk_const(bv8);
+  Node x_mul_y = nm.mk_node(Kind::BV_MUL, {x, y});
+  Node y_mul_x = nm.mk_node(Kind::BV_MUL, {y, x});
+  Node val     = nm.mk_value(BitVector::from_ui(8, 42));
+
+  ctx.assert_formula(nm.mk_node(Kind::EQUAL, {x_mul_y, val}));
+  ASSERT_EQ(ctx.solve(), Result::SAT);
+  ASSERT_EQ(ctx.get_value(x).value<BitVector>().bvmul(
+                ctx.get_value(y).value<BitVector>()),
+            val.value<BitVector>());
+
+  ctx.push();
+  Node assertion =
+      nm.mk_node(Kind::NOT, {nm.mk_node(Kind::EQUAL, {x_mul_y, y_mul_x})});
+  ctx.assert_formula(assertion);
+  ASSERT_EQ(ctx.solve(), Result::UNSAT);
+  auto core = ctx.get_unsat_core();
+  ASSERT_EQ(core.size(), 1);
+  ASSERT_EQ(core[0], assertion);
+  ctx.pop();
+
+  ASSERT_EQ(ctx.solve(), Result::SAT);
+
+  // Clauses of scopes popped before the next solve() call are never replayed
+  // to the worker solvers.
+  ctx.push();
+  ctx.assert_formula(nm.mk_node(Kind::EQUAL, {x_mul_y, y}));
+  ctx.assert_formula(nm.mk_node(Kind::EQUAL, {y, x}));
+  ctx.pop();
+  ASSERT_EQ(ctx.solve(), Result::SAT);
+  ASSERT_EQ(ctx.get_value(x).value<BitVector>().bvmul(
+                ctx.get_value(y).value<BitVector>()),
+            val.value<BitVector>());
+}
+
+TEST_F(TestBvSolver, solve_cubes_terminate)
+{
+  NodeManager nm;
+  d_options.bv_cube_threads.set(4);
+  d_options.bv_cube_depth.set(3);
+  SolvingContext ctx = SolvingContext(nm, d_options);
+  ThreadTerminator terminator(std::chrono::milliseconds(100));
+  ctx.env().configure_terminator(&terminator);
+  assert_factoring(nm, ctx);
+  ASSERT_EQ(ctx.solve(), Result::UNKNOWN);
+  ASSERT_FALSE(terminator.d_other_thread);
+}
+
+TEST_F(TestBvSolver, solve_prop_walkers_terminate)
+{
+  NodeManager nm;
+  d_options.bv_solver.set(option::BvSolver::PROP);
+  d_options.prop_walkers.set(4);
+  SolvingContext ctx = SolvingContext(nm, d_options);
+  ThreadTerminator terminator(std::chrono::milliseconds(100));
+  ctx.env().configure_terminator(&terminator);
+  assert_factoring(nm, ctx);
+  ASSERT_EQ(ctx.solve(), Result::UNKNOWN);
+  ASSERT_FALSE(terminator.d_other_thread);
+}
+
+TEST_F(TestBvSolver, solve_push_pop)
+{
+  NodeManager nm;
+  d_options.produce_models.set(true);
+  SolvingContext ctx = SolvingContext(nm, d_options);
+
+  Type bv8   = nm.mk_bv_type(8);
+  Node x     = nm.mk_const(bv8);
+  Node two   = nm.mk_value(BitVector::from_ui(8, 2));
+  Node three = nm.mk_value(BitVector::from_ui(8, 3));
+
+  ctx.assert_formula(nm.mk_node(Kind::BV_ULT, {three, x}));
+  for (uint64_t i = 0; i < 8; ++i)
+  {
+    ctx.push();
+    // Fresh constant per scope, its AIGs and clauses are dead after pop().
+    Node y = nm.mk_const(bv8);
+    ctx.assert_formula(nm.mk_node(Kind::BV_ULT, {y, two}));
+    ctx.assert_formula(
+        nm.mk_node(Kind::EQUAL,
+                   {nm.mk_node(Kind::BV_MUL, {x, y}),
+                    nm.mk_value(BitVector::from_ui(8, i))}));
+    ASSERT_EQ(ctx.solve(), i == 0 || i > 3 ? Result::SAT : Result::UNSAT);
+    ctx.pop();
+  }
+  ASSERT_EQ(ctx.solve(), Result::SAT);
+  ASSERT_EQ(ctx.get_value(nm.mk_node(Kind::BV_ULT, {three, x})),
+            nm.mk_value(true));
+
+  auto stats = ctx.env().statistics().get();
+  ASSERT_GT(std::stoull(stats.at("solver::bv::bitblast::cnf::num_retired")),
+            0u);
+}
+
+TEST_F(TestBvSolver, solve_mul_encodings)
+{
+  RNG rng(1234);
+  for (auto enc : {option::BvMulEncoding::ARRAY,
+                   option::BvMulEncoding::BOOTH,
+                   option::BvMulEncoding::WALLACE,
+                   option::BvMulEncoding::KARATSUBA})
+  {
+    for (uint64_t size : {1, 2, 3, 8, 13, 33, 64})
+    {
+      for (uint32_t i = 0; i < 3; ++i)
+      {
+        option::Options options;
+        options.bv_mul_encoding.set(enc);
+        options.preprocess.set(false);
+        options.produce_models.set(true);
+        NodeManager nm;
+        SolvingContext ctx = SolvingContext(nm, options);
+
+        Type bv        = nm.mk_bv_type(size);
+        Node x         = nm.mk_const(bv);
+        Node y         = nm.mk_const(bv);
+        Node z         = nm.mk_const(bv);
+        BitVector x_bv = BitVector(size, rng);
+        BitVector y_bv = BitVector(size, rng);
+        ctx.assert_formula(nm.mk_node(Kind::EQUAL, {x, nm.mk_value(x_bv)}));
+        ctx.assert_formula(nm.mk_node(Kind::EQUAL, {y, nm.mk_value(y_bv)}));
+        ctx.assert_formula(
+            nm.mk_node(Kind::EQUAL, {z, nm.mk_node(Kind::BV_MUL, {x, y})}));
+        ASSERT_EQ(ctx.solve(), Result::SAT);
+        ASSERT_EQ(ctx.get_value(z), nm.mk_value(x_bv.bvmul(y_bv)));
+        if (size == 64)
+        {
+          ASSERT_GT(std::stoull(ctx.env().statistics().get().at(
+                        "solver::bv::bitblast::aig::num_mul_ands")),
+                    0u);
+        }
+      }
+    }
+
+    // Without rewriting, multiplications of values are not evaluated but
+    // bit-blasted with the configured encoding. Check all products of 4-bit
+    // values against BitVector::bvmul().
+    {
+      option::Options options;
+      options.bv_mul_encoding.set(enc);
+      options.rewrite_level.set(0);
+      options.preprocess.set(false);
+      NodeManager nm;
+      SolvingContext ctx = SolvingContext(nm, options);
+      std::vector<Node> wrong;
+      for (uint64_t a = 0; a < 16; ++a)
+      {
+        for (uint64_t b = 0; b < 16; ++b)
+        {
+          BitVector a_bv = BitVector::from_ui(4, a);
+          BitVector b_bv = BitVector::from_ui(4, b);
+          wrong.push_back(nm.mk_node(
+              Kind::DISTINCT,
+              {nm.mk_node(Kind::BV_MUL,
+                          {nm.mk_value(a_bv), nm.mk_value(b_bv)}),
+               nm.mk_value(a_bv.bvmul(b_bv))}));
+        }
+      }
+      ctx.assert_formula(node::utils::mk_nary(nm, Kind::OR, wrong));
+      ASSERT_EQ(ctx.solve(), Result::UNSAT);
+    }
+
+    // Check commutativity on symbolic operands, without rewriting.
+    {
+      option::Options options;
+      options.bv_mul_encoding.set(enc);
+      options.rewrite_level.set(0);
+      options.preprocess.set(false);
+      NodeManager nm;
+      SolvingContext ctx = SolvingContext(nm, options);
+      Type bv            = nm.mk_bv_type(5);
+      Node x             = nm.mk_const(bv);
+      Node y             = nm.mk_const(bv);
+      ctx.assert_formula(
+          nm.mk_node(Kind::DISTINCT,
+                     {nm.mk_node(Kind::BV_MUL, {x, y}),
+                      nm.mk_node(Kind::BV_MUL, {y, x})}));
+      ASSERT_EQ(ctx.solve(), Result::UNSAT);
+    }
+  }
+}
+
+TEST_F(TestBvSolver, solve_div_encodings)
+{
+  RNG rng(1234);
+  for (auto enc : {option::BvDivEncoding::RESTORING,
+                   option::BvDivEncoding::NON_RESTORING,
+                   option::BvDivEncoding::MULTIPLIER})
+  {
+    for (uint64_t size : {1, 2, 3, 8, 13, 33})
+    {
+      for (uint32_t i = 0; i < 4; ++i)
+      {
+        option::Options options;
+        options.bv_div_encoding.set(enc);
+        options.preprocess.set(false);
+        options.produce_models.set(true);
+        NodeManager nm;
+        SolvingContext ctx = SolvingContext(nm, options);
+
+        Type bv        = nm.mk_bv_type(size);
+        Node x         = nm.mk_const(bv);
+        Node y         = nm.mk_const(bv);
+        Node q         = nm.mk_const(bv);
+        Node r         = nm.mk_const(bv);
+        BitVector x_bv = BitVector(size, rng);
+        // Check division by zero.
+        BitVector y_bv =
+            i == 0 ? BitVector::mk_zero(size) : BitVector(size, rng);
+        ctx.assert_formula(nm.mk_node(Kind::EQUAL, {x, nm.mk_value(x_bv)}));
+        ctx.assert_formula(nm.mk_node(Kind::EQUAL, {y, nm.mk_value(y_bv)}));
+        ctx.assert_formula(
+            nm.mk_node(Kind::EQUAL, {q, nm.mk_node(Kind::BV_UDIV, {x, y})}));
+        ctx.assert_formula(
+            nm.mk_node(Kind::EQUAL, {r, nm.mk_node(Kind::BV_UREM, {x, y})}));
+        ASSERT_EQ(ctx.solve(), Result::SAT);
+        ASSERT_EQ(ctx.get_value(q), nm.mk_value(x_bv.bvudiv(y_bv)));
+        ASSERT_EQ(ctx.get_value(r), nm.mk_value(x_bv.bvurem(y_bv)));
+      }
+    }
+
+    // Check a = (a / b) * b + a % b.
+    option::Options options;
+    options.bv_div_encoding.set(enc);
+    NodeManager nm;
+    SolvingContext ctx = SolvingContext(nm, options);
+    Type bv            = nm.mk_bv_type(5);
+    Node x             = nm.mk_const(bv);
+    Node y             = nm.mk_const(bv);
+    ctx.assert_formula(nm.mk_node(
+        Kind::DISTINCT,
+        {x,
+         nm.mk_node(Kind::BV_ADD,
+                    {nm.mk_node(Kind::BV_MUL,
+                                {nm.mk_node(Kind::BV_UDIV, {x, y}), y}),
+                     nm.mk_node(Kind::BV_UREM, {x, y})})}));
+    ASSERT_EQ(ctx.solve(), Result::UNSAT);
+  }
+}
+
+TEST_F(TestBvSolver, solve_sweep)
+{
+  option::Options options;
+  options.bv_sweep.set(true);
+  options.preprocess.set(false);
+  options.rewrite_level.set(0);
+  options.produce_models.set(true);
+  NodeManager nm;
+  SolvingContext ctx = SolvingContext(nm, options);
+  Type bv            = nm.mk_bv_type(4);
+  Node x             = nm.mk_const(bv);
+  Node y             = nm.mk_const(bv);
+  Node z             = nm.mk_const(bv);
+
+  // Check x * (y + z) = x * y + x * z.
+  ctx.push();
+  ctx.assert_formula(nm.mk_node(
+      Kind::DISTINCT,
+      {nm.mk_node(Kind::BV_MUL, {x, nm.mk_node(Kind::BV_ADD, {y, z})}),
+       nm.mk_node(Kind::BV_ADD,
+                  {nm.mk_node(Kind::BV_MUL, {x, y}),
+                   nm.mk_node(Kind::BV_MUL, {x, z})})}));
+  ASSERT_EQ(ctx.solve(), Result::UNSAT);
+  ctx.pop();
+
+  // Swept cones of popped scopes are released. The bit-blaster cache is not
+  // necessarily popped before the AIG statistics are updated on pop, solve
+  // again to update them.
+  ASSERT_EQ(ctx.solve(), Result::SAT);
+  auto stats = ctx.env().statistics().get();
+  ASSERT_GT(std::stoull(stats.at("solver::bv::bitblast::sweep::num_merged")),
+            0u);
+  ASSERT_EQ(stats.at("solver::bv::bitblast::aig::num_ands"), "0");
+
+  // Check that models of swept formulas are correct.
+  Node xy = nm.mk_node(Kind::BV_XOR, {x, y});
+  ctx.assert_formula(nm.mk_node(
+      Kind::EQUAL,
+      {nm.mk_node(Kind::BV_ADD, {x, y}),
+       nm.mk_node(Kind::BV_ADD,
+                  {xy,
+                   nm.mk_node(Kind::BV_SHL,
+                              {nm.mk_node(Kind::BV_AND, {x, y}),
+                               nm.mk_value(BitVector::from_ui(4, 1))})})}));
+  ctx.assert_formula(
+      nm.mk_node(Kind::EQUAL, {xy, nm.mk_value(BitVector::from_ui(4, 5))}));
+  ctx.assert_formula(
+      nm.mk_node(Kind::EQUAL, {z, nm.mk_node(Kind::BV_MUL, {x, y})}));
+  ASSERT_EQ(ctx.solve(), Result::SAT);
+  BitVector x_bv = ctx.get_value(x).value<BitVector>();
+  BitVector y_bv = ctx.get_value(y).value<BitVector>();
+  ASSERT_EQ(x_bv.bvxor(y_bv), BitVector::from_ui(4, 5));
+  ASSERT_EQ(ctx.get_value(z).value<BitVector>(), x_bv.bvmul(y_bv));
+}
+
+TEST_F(TestBvSolver, solve_sim)
+{
+  option::Options options;
+  options.bv_sim_rounds.set(4);
+  options.preprocess.set(false);
+  options.produce_models.set(true);
+  NodeManager nm;
+  SolvingContext ctx = SolvingContext(nm, options);
+  Type bv            = nm.mk_bv_type(32);
+  Node x             = nm.mk_const(bv);
+  Node y             = nm.mk_const(bv);
+  Node zero          = nm.mk_value(BitVector::mk_zero(32));
+
+  // Easy satisfiable formula, answered by simulation.
+  Node add = nm.mk_node(Kind::BV_ADD, {x, y});
+  ctx.assert_formula(nm.mk_node(Kind::BV_ULT, {x, y}));
+  ctx.assert_formula(nm.mk_node(Kind::DISTINCT, {add, zero}));
+  ASSERT_EQ(ctx.solve(), Result::SAT);
+  ASSERT_GT(std::stoull(ctx.env().statistics().get().at(
+                "solver::bv::bitblast::sim::num_sat")),
+            0u);
+  BitVector x_bv = ctx.get_value(x).value<BitVector>();
+  BitVector y_bv = ctx.get_value(y).value<BitVector>();
+  ASSERT_TRUE(x_bv.compare(y_bv) < 0);
+  ASSERT_FALSE(x_bv.bvadd(y_bv).is_zero());
+
+  // Not answered by simulation.
+  BitVector val = BitVector::from_ui(32, 123456789);
+  ctx.push();
+  ctx.assert_formula(nm.mk_node(Kind::EQUAL, {add, nm.mk_value(val)}));
+  ASSERT_EQ(ctx.solve(), Result::SAT);
+  x_bv = ctx.get_value(x).value<BitVector>();
+  y_bv = ctx.get_value(y).value<BitVector>();
+  ASSERT_TRUE(x_bv.compare(y_bv) < 0);
+  ASSERT_EQ(x_bv.bvadd(y_bv), val);
+  ctx.assert_formula(nm.mk_node(Kind::BV_ULT, {y, x}));
+  ASSERT_EQ(ctx.solve(), Result::UNSAT);
+  ctx.pop();
+
+  ASSERT_EQ(ctx.solve(), Result::SAT);
+  x_bv = ctx.get_value(x).value<BitVector>();
+  y_bv = ctx.get_value(y).value<BitVector>();
+  ASSERT_TRUE(x_bv.compare(y_bv) < 0);
+  ASSERT_FALSE(x_bv.bvadd(y_bv).is_zero());
+}
+
+TEST_F(TestBvSolver, solve_sat_propagator)
+{
+  option::Options options;
+  options.bv_sat_propagator.set(true);
+  options.preprocess.set(false);
+  options.produce_models.set(true);
+  NodeManager nm;
+  SolvingContext ctx = SolvingContext(nm, options);
+  Type bv            = nm.mk_bv_type(8);
+  Node a             = nm.mk_const(nm.mk_array_type(bv, bv));
+  Node f             = nm.mk_const(nm.mk_fun_type({bv, bv}));
+  Node i             = nm.mk_const(bv);
+  Node j             = nm.mk_const(bv);
+  Node v             = nm.mk_const(bv);
+  Node a_i           = nm.mk_node(Kind::SELECT, {a, i});
+  Node a_j           = nm.mk_node(Kind::SELECT, {a, j});
+  Node store         = nm.mk_node(Kind::STORE, {a, i, v});
+  Node b_j           = nm.mk_node(Kind::SELECT, {store, j});
+  Node f_i           = nm.mk_node(Kind::APPLY, {f, i});
+  Node f_j           = nm.mk_node(Kind::APPLY, {f, j});
+  Node not_a_i       = nm.mk_node(Kind::BV_NOT, {a_i});
+
+  // Requires array and function lemmas.
+  ctx.assert_formula(nm.mk_node(Kind::DISTINCT, {b_j, v}));
+  ctx.assert_formula(nm.mk_node(Kind::EQUAL, {f_i, a_j}));
+  ctx.assert_formula(nm.mk_node(Kind::EQUAL, {f_j, not_a_i}));
+  ASSERT_EQ(ctx.solve(), Result::SAT);
+  ASSERT_GT(std::stoull(ctx.env().statistics().get().at(
+                "solver::bv::bitblast::propagator::num_checks")),
+            0u);
+  BitVector i_bv = ctx.get_value(i).value<BitVector>();
+  BitVector j_bv = ctx.get_value(j).value<BitVector>();
+  ASSERT_NE(i_bv, j_bv);
+  ASSERT_NE(ctx.get_value(a_j), ctx.get_value(v));
+  ASSERT_EQ(ctx.get_value(b_j), ctx.get_value(a_j));
+  ASSERT_EQ(ctx.get_value(f_i), ctx.get_value(a_j));
+  ASSERT_EQ(ctx.get_value(f_j).value<BitVector>(),
+            ctx.get_value(a_i).value<BitVector>().bvnot());
+
+  ctx.push();
+  ctx.assert_formula(nm.mk_node(Kind::EQUAL, {a_i, a_j}));
+  ctx.assert_formula(nm.mk_node(Kind::EQUAL, {f_i, f_j}));
+  ASSERT_EQ(ctx.solve(), Result::UNSAT);
+  ctx.pop();
+
+  ASSERT_EQ(ctx.solve(), Result::SAT);
+  ASSERT_NE(ctx.get_value(i), ctx.get_value(j));
+  ASSERT_EQ(ctx.get_value(f_i), ctx.get_value(a_j));
+}
+
+TEST_F(TestBvSolver, solve_sat_propagator_compound)
+{
+  option::Options options;
+  options.bv_sat_propagator.set(true);
+  options.preprocess.set(false);
+  options.produce_models.set(true);
+  NodeManager nm;
+  SolvingContext ctx = SolvingContext(nm, options);
+  Type bv            = nm.mk_bv_type(16);
+  Node f             = nm.mk_const(nm.mk_fun_type({bv, bv}));
+  Node x             = nm.mk_const(bv);
+  Node y             = nm.mk_const(bv);
+  Node z             = nm.mk_const(bv);
+  Node mul           = nm.mk_node(Kind::BV_MUL, {x, y});
+  Node one           = nm.mk_value(BitVector::from_ui(16, 1));
+  Node add           = nm.mk_node(Kind::BV_ADD, {z, one});
+  Node f_mul         = nm.mk_node(Kind::APPLY, {f, mul});
+  Node f_add         = nm.mk_node(Kind::APPLY, {f, add});
+
+  // The congruence lemma for f_mul and f_add is encoded over the bits of the
+  // compound terms while the propagator checks an assignment.
+  ctx.assert_formula(nm.mk_node(Kind::DISTINCT, {f_mul, f_add}));
+  ASSERT_EQ(ctx.solve(), Result::SAT);
+  ASSERT_NE(ctx.get_value(mul), ctx.get_value(add));
+
+  ctx.push();
+  ctx.assert_formula(nm.mk_node(Kind::EQUAL, {mul, add}));
+  ASSERT_EQ(ctx.solve(), Result::UNSAT);
+  ctx.pop();
+
+  for (uint64_t i = 1; i < 8; ++i)
+  {
+    ctx.push();
+    Node val = nm.mk_value(BitVector::from_ui(16, i * 4099));
+    ctx.assert_formula(nm.mk_node(Kind::EQUAL, {x, val}));
+    Node not_y = nm.mk_node(Kind::BV_NOT, {y});
+    ctx.assert_formula(nm.mk_node(
+        Kind::EQUAL, {z, nm.mk_node(Kind::BV_MUL, {val, not_y})}));
+    ASSERT_EQ(ctx.solve(), Result::SAT);
+    ASSERT_NE(ctx.get_value(mul), ctx.get_value(add));
+    ASSERT_NE(ctx.get_value(f_mul), ctx.get_value(f_add));
+    ctx.pop();
+  }
+  ASSERT_GT(std::stoull(ctx.env().statistics().get().at(
+                "solver::bv::bitblast::propagator::num_conflicts")),
+            0u);
+}
+
 }  // namespace bzla::test
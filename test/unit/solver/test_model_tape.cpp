@@ -0,0 +1,132 @@
+/***
+ * Bitwuzla: Satisfiability Modulo Theories (SMT) solver.
+ *
+ * Copyright (C) 2023 by the authors listed in the AUTHORS file at
+ * https://github.com/bitwuzla/bitwuzla/blob/main/AUTHORS
+ *
+ * This file is part of Bitwuzla under the MIT license. See COPYING for more
+ * information at https://github.com/bitwuzla/bitwuzla/blob/main/COPYING
+ */
+
+#include "node/node_manager.h"
+#include "solver/model_tape.h"
+#include "solving_context.h"
+#include "test/unit/test.h"
+
+namespace bzla::test {
+
+using namespace node;
+
+class TestModelTape : public TestCommon
+{
+ protected:
+  /** Leaf callback that looks up values in `d_model`. */
+  ModelTape::LeafValue leaf_value()
+  {
+    return [this](const Node& leaf) {
+      ++d_num_leaf_queries;
+      return d_model.at(leaf);
+    };
+  }
+
+  NodeManager d_nm;
+  std::unordered_map<Node, Node> d_model;
+  uint64_t d_num_leaf_queries = 0;
+};
+
+TEST_F(TestModelTape, value)
+{
+  ModelTape tape(d_nm);
+  Type bv8   = d_nm.mk_bv_type(8);
+  Type bv100 = d_nm.mk_bv_type(100);
+  Node x     = d_nm.mk_const(bv8, "x");
+  Node y     = d_nm.mk_const(bv100, "y");
+  Node p     = d_nm.mk_const(d_nm.mk_bool_type(), "p");
+
+  // (ite p (bvmul x x) ((_ extract 7 0) (bvadd y ((_ zero_extend 92) x))))
+  Node mul  = d_nm.mk_node(Kind::BV_MUL, {x, x});
+  Node zext = d_nm.mk_node(Kind::BV_ZERO_EXTEND, {x}, {92});
+  Node add  = d_nm.mk_node(Kind::BV_ADD, {y, zext});
+  Node ext  = d_nm.mk_node(Kind::BV_EXTRACT, {add}, {7, 0});
+  Node ite  = d_nm.mk_node(Kind::ITE, {p, mul, ext});
+
+  d_model[x] = d_nm.mk_value(BitVector::from_ui(8, 3));
+  d_model[y] = d_nm.mk_value(BitVector::mk_ones(100));
+  d_model[p] = d_nm.mk_value(true);
+  ASSERT_EQ(tape.value(ite, leaf_value()),
+            d_nm.mk_value(BitVector::from_ui(8, 9)));
+  ASSERT_EQ(tape.size(), 8u);
+  ASSERT_EQ(d_num_leaf_queries, 3u);
+  ASSERT_EQ(tape.value(add, leaf_value()),
+            d_nm.mk_value(BitVector::from_ui(100, 2)));
+  ASSERT_EQ(tape.size(), 8u);
+  ASSERT_EQ(d_num_leaf_queries, 3u);
+
+  // New model: only the leaves are queried again.
+  tape.reset();
+  d_model[p] = d_nm.mk_value(false);
+  ASSERT_EQ(tape.value(ite, leaf_value()),
+            d_nm.mk_value(BitVector::from_ui(8, 2)));
+  ASSERT_EQ(tape.size(), 8u);
+  ASSERT_EQ(d_num_leaf_queries, 6u);
+
+  tape.clear();
+  ASSERT_EQ(tape.size(), 0u);
+  ASSERT_EQ(tape.value(mul, leaf_value()),
+            d_nm.mk_value(BitVector::from_ui(8, 9)));
+  ASSERT_EQ(tape.size(), 2u);
+}
+
+TEST_F(TestModelTape, leaves)
+{
+  ModelTape tape(d_nm);
+  Type bv8 = d_nm.mk_bv_type(8);
+  Type arr = d_nm.mk_array_type(bv8, bv8);
+  Node a   = d_nm.mk_const(arr, "a");
+  Node i   = d_nm.mk_const(bv8, "i");
+  Node sel = d_nm.mk_node(Kind::SELECT, {a, i});
+  Node inc = d_nm.mk_node(Kind::BV_INC, {sel});
+
+  // Terms other than Boolean and bit-vector operators are leaves, their
+  // operands are not compiled.
+  d_model[sel] = d_nm.mk_value(BitVector::from_ui(8, 41));
+  ASSERT_EQ(tape.value(inc, leaf_value()),
+            d_nm.mk_value(BitVector::from_ui(8, 42)));
+  ASSERT_EQ(tape.size(), 2u);
+
+  d_model[a] = d_nm.mk_const(arr);
+  ASSERT_EQ(tape.value(a, leaf_value()), d_model[a]);
+  ASSERT_EQ(tape.size(), 2u);
+}
+
+TEST_F(TestModelTape, get_value)
+{
+  option::Options options;
+  options.produce_models.set(true);
+  SolvingContext ctx(d_nm, options);
+
+  Type bv16 = d_nm.mk_bv_type(16);
+  Node x    = d_nm.mk_const(bv16, "x");
+  Node y    = d_nm.mk_const(bv16, "y");
+  Node mul  = d_nm.mk_node(Kind::BV_MUL, {x, y});
+  Node add  = d_nm.mk_node(Kind::BV_ADD, {x, y});
+  ctx.assert_formula(d_nm.mk_node(
+      Kind::EQUAL, {mul, d_nm.mk_value(BitVector::from_ui(16, 391))}));
+  ctx.assert_formula(d_nm.mk_node(
+      Kind::BV_ULT, {x, d_nm.mk_value(BitVector::from_ui(16, 256))}));
+  ctx.assert_formula(d_nm.mk_node(
+      Kind::BV_ULT, {y, d_nm.mk_value(BitVector::from_ui(16, 256))}));
+
+  for (size_t k = 0; k < 2; ++k)
+  {
+    ASSERT_EQ(ctx.solve(), Result::SAT);
+    BitVector vx = ctx.get_value(x).value<BitVector>();
+    BitVector vy = ctx.get_value(y).value<BitVector>();
+    ASSERT_EQ(ctx.get_value(mul).value<BitVector>(), vx.bvmul(vy));
+    ASSERT_EQ(ctx.get_value(add).value<BitVector>(), vx.bvadd(vy));
+    // Exclude current model.
+    ctx.assert_formula(d_nm.mk_node(Kind::DISTINCT, {x, d_nm.mk_value(vx)}));
+  }
+}
+
+}  // namespace bzla::test